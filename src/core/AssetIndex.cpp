@@ -0,0 +1,178 @@
+#include "AssetIndex.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include "AssetPack.hpp"
+#include "MappedFile.hpp"
+
+namespace {
+    // Las rutas resueltas se forman como raíz + nombre: la raíz acaba en '/'
+    std::string NormalizeRoot(const std::string& root) {
+        if (root.empty() || root.back() == '/') return root;
+        return root + "/";
+    }
+
+    // Recorre los archivos regulares de 'root' con su nombre lógico (separador '/')
+    template <typename Func>
+    void ForEachAssetFile(const std::string& root, Func&& func) {
+        std::error_code ec;
+        std::filesystem::recursive_directory_iterator it(
+            root, std::filesystem::directory_options::skip_permission_denied, ec);
+        if (ec) return;
+
+        for (const auto& entry : it) {
+            if (!entry.is_regular_file(ec)) continue;
+            const std::string name = entry.path().lexically_relative(root).generic_string();
+            if (name == AssetIndex::MANIFEST_NAME || name == AssetPack::PACK_NAME) continue;
+            func(name, entry);
+        }
+    }
+}
+
+size_t AssetIndex::addRoot(const std::string& root) {
+    const std::string base = NormalizeRoot(root);
+    std::error_code ec;
+    if (!std::filesystem::is_directory(base, ec)) return 0;
+
+    const std::string manifest = base + MANIFEST_NAME;
+    if (std::filesystem::exists(manifest, ec)) return _loadManifest(base, manifest);
+    return _scan(base);
+}
+
+/**
+ * _loadManifest
+ *  - Formato de texto: "ASSETS <versión>" y una línea por asset
+ *    "<bytes> <ancho> <alto> <nombre>" (el nombre va al final y puede tener espacios).
+ */
+size_t AssetIndex::_loadManifest(const std::string& root, const std::string& manifestPath) {
+    MappedFile file(manifestPath);
+    if (!file.isOpen()) throw std::runtime_error("Cannot open asset manifest: " + manifestPath);
+
+    const char* at = file.data();
+    const char* end = at + file.size();
+    auto nextLine = [&]() {
+        const char* eol = static_cast<const char*>(std::memchr(at, '\n', (size_t)(end - at)));
+        if (!eol) eol = end;
+        std::string line(at, eol);
+        at = (eol < end) ? eol + 1 : end;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        return line;
+    };
+
+    const std::string header = nextLine();
+    if (header != "ASSETS " + std::to_string(MANIFEST_VERSION)) {
+        throw std::runtime_error("Unsupported asset manifest: " + manifestPath);
+    }
+
+    size_t added = 0;
+    while (at < end) {
+        const std::string line = nextLine();
+        if (line.empty()) continue;
+
+        AssetInfo info;
+        char* cursor = nullptr;
+        info.size = std::strtoull(line.c_str(), &cursor, 10);
+        info.width = (int)std::strtol(cursor, &cursor, 10);
+        info.height = (int)std::strtol(cursor, &cursor, 10);
+        if (*cursor != ' ' || cursor[1] == '\0') {
+            throw std::runtime_error("Invalid asset manifest line: " + line);
+        }
+        const std::string name(cursor + 1);
+        info.path = root + name;
+        if (_entries.emplace(name, std::move(info)).second) ++added;
+    }
+    return added;
+}
+
+size_t AssetIndex::_scan(const std::string& root) {
+    size_t added = 0;
+    ForEachAssetFile(root, [&](const std::string& name, const std::filesystem::directory_entry& entry) {
+        if (_entries.count(name)) return;
+        std::error_code ec;
+        AssetInfo info;
+        info.path = root + name;
+        info.size = entry.file_size(ec);
+        _entries.emplace(name, std::move(info));
+        ++added;
+    });
+    return added;
+}
+
+const AssetInfo* AssetIndex::find(const std::string& name) const {
+    auto it = _entries.find(name);
+    return it != _entries.end() ? &it->second : nullptr;
+}
+
+bool AssetIndex::imageSize(const std::string& name, int& width, int& height) {
+    auto it = _entries.find(name);
+    if (it == _entries.end()) return false;
+
+    AssetInfo& info = it->second;
+    if (info.width <= 0 && !ReadPngSize(info.path, info.width, info.height)) return false;
+    width = info.width;
+    height = info.height;
+    return true;
+}
+
+std::vector<std::string> AssetIndex::subdirectories(const std::string& dir) const {
+    const std::string prefix = NormalizeRoot(dir);
+    std::set<std::string> found;
+    for (const auto& entry : _entries) {
+        const std::string& name = entry.first;
+        if (name.compare(0, prefix.size(), prefix) != 0) continue;
+        const size_t slash = name.find('/', prefix.size());
+        if (slash != std::string::npos) found.insert(name.substr(prefix.size(), slash - prefix.size()));
+    }
+    return std::vector<std::string>(found.begin(), found.end());
+}
+
+size_t AssetIndex::WriteManifest(const std::string& root, const std::string& outPath) {
+    const std::string base = NormalizeRoot(root);
+    std::error_code ec;
+    if (!std::filesystem::is_directory(base, ec)) throw std::runtime_error("Asset root not found: " + root);
+
+    // Orden estable: el manifiesto no cambia si no cambian los assets
+    std::vector<std::pair<std::string, AssetInfo>> entries;
+    ForEachAssetFile(base, [&](const std::string& name, const std::filesystem::directory_entry& entry) {
+        std::error_code sizeEc;
+        AssetInfo info;
+        info.path = base + name;
+        info.size = entry.file_size(sizeEc);
+        ReadPngSize(info.path, info.width, info.height);
+        entries.emplace_back(name, std::move(info));
+    });
+    std::sort(entries.begin(), entries.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    std::ofstream out(outPath, std::ios::trunc);
+    if (!out) throw std::runtime_error("Cannot write asset manifest: " + outPath);
+    out << "ASSETS " << MANIFEST_VERSION << '\n';
+    for (const auto& entry : entries) {
+        const AssetInfo& info = entry.second;
+        out << info.size << ' ' << info.width << ' ' << info.height << ' ' << entry.first << '\n';
+    }
+    if (!out) throw std::runtime_error("Cannot write asset manifest: " + outPath);
+    return entries.size();
+}
+
+bool AssetIndex::ReadPngSize(const std::string& path, int& width, int& height) {
+    // Firma (8 bytes) + longitud y tipo del primer chunk, que siempre es IHDR (8) + ancho y alto
+    static const unsigned char SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    unsigned char header[24];
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in.read(reinterpret_cast<char*>(header), sizeof(header))) return false;
+    if (std::memcmp(header, SIGNATURE, sizeof(SIGNATURE)) != 0) return false;
+    if (std::memcmp(header + 12, "IHDR", 4) != 0) return false;
+
+    auto be32 = [](const unsigned char* p) {
+        return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | (uint32_t)p[3];
+    };
+    width = (int)be32(header + 16);
+    height = (int)be32(header + 20);
+    return true;
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// Entrada del índice: dónde está un asset y lo que se sabe de él sin abrirlo.
+struct AssetInfo {
+    std::string path;   // Ruta resuelta (raíz + nombre lógico)
+    uint64_t size = 0;  // Bytes del archivo
+    int width = 0;      // Dimensiones si es un PNG (0 si no lo es o aún no se han leído)
+    int height = 0;
+    bool packed = false; // Está en el paquete de assets (AssetPack), no suelto en disco
+};
+
+/**
+ * Clase AssetIndex
+ *  - Tabla hash nombre lógico ("sprites/spikes.png") → AssetInfo, montada una
+ *    vez por raíz de assets: resolver un nombre después no toca el disco.
+ *  - Si la raíz trae manifiesto (MANIFEST_NAME, generado al instalar con
+ *    WriteManifest) se lee ese único archivo, que ya incluye tamaños y
+ *    dimensiones; si no, se recorre el directorio y las dimensiones se leen
+ *    de la cabecera del PNG la primera vez que se piden (imageSize).
+ *  - Con varias raíces manda la primera que se añade. El manifiesto y el
+ *    paquete de assets (AssetPack::PACK_NAME) no se indexan como assets.
+ */
+class AssetIndex {
+    public:
+        /// Nombre del manifiesto dentro de la raíz de assets.
+        static constexpr const char* MANIFEST_NAME = "assets.manifest";
+        /// Versión del formato del manifiesto. Subirla al cambiarlo.
+        static constexpr int MANIFEST_VERSION = 1;
+
+        /**
+         * Indexa 'root' ("./assets/") sin pisar nombres ya indexados.
+         * @return número de entradas nuevas (0 si la raíz no existe).
+         * @throws std::runtime_error si el manifiesto existe pero no es válido.
+         */
+        size_t addRoot(const std::string& root);
+
+        /// Añade una entrada suelta (p.ej. de un AssetPack). @return false si el nombre ya estaba.
+        bool add(const std::string& name, AssetInfo info) { return _entries.emplace(name, std::move(info)).second; }
+
+        void clear() { _entries.clear(); }
+        size_t size() const { return _entries.size(); }
+
+        /// Entrada de 'name' o nullptr si no está indexado.
+        const AssetInfo* find(const std::string& name) const;
+        bool contains(const std::string& name) const { return _entries.count(name) != 0; }
+
+        /**
+         * Dimensiones de la imagen 'name' (leyendo su cabecera si no se conocían).
+         * @return false si no está indexado o no es un PNG legible.
+         */
+        bool imageSize(const std::string& name, int& width, int& height);
+
+        /// Nombres (ordenados) de los subdirectorios directos de 'dir' que contienen assets.
+        std::vector<std::string> subdirectories(const std::string& dir) const;
+
+        /**
+         * Recorre 'root' y escribe su manifiesto en 'outPath' (tamaños y dimensiones incluidos).
+         * @return número de entradas escritas.
+         * @throws std::runtime_error si la raíz no existe o no se puede escribir.
+         */
+        static size_t WriteManifest(const std::string& root, const std::string& outPath);
+
+        /// Ancho y alto de la cabecera (IHDR) de un PNG. @return false si no es un PNG.
+        static bool ReadPngSize(const std::string& path, int& width, int& height);
+
+    private:
+        std::unordered_map<std::string, AssetInfo> _entries;
+
+        size_t _loadManifest(const std::string& root, const std::string& manifestPath);
+        size_t _scan(const std::string& root);
+};
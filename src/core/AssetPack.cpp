@@ -0,0 +1,196 @@
+#include "AssetPack.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include "AssetIndex.hpp"
+extern "C" {
+    #include <raylib.h>
+}
+
+namespace {
+    struct PackHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t count;
+        uint32_t namesSize;
+    };
+
+    static_assert(sizeof(PackHeader) == 16, "PackHeader debe ocupar 16 bytes");
+    static_assert(sizeof(AssetPackEntry) == 32, "AssetPackEntry debe ocupar 32 bytes");
+
+    constexpr char PACK_MAGIC[4] = { 'A', 'P', 'A', 'K' };
+
+    size_t AlignUp(size_t value) {
+        return (value + AssetPack::ALIGNMENT - 1) / AssetPack::ALIGNMENT * AssetPack::ALIGNMENT;
+    }
+
+    std::vector<unsigned char> ReadFile(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) throw std::runtime_error("Cannot read asset: " + path);
+        return std::vector<unsigned char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    bool UnderAnyDir(const std::string& name, const std::vector<std::string>& dirs) {
+        if (dirs.empty()) return true;
+        for (const std::string& dir : dirs) {
+            if (name.size() > dir.size() && name.compare(0, dir.size(), dir) == 0 && name[dir.size()] == '/') return true;
+        }
+        return false;
+    }
+}
+
+void AssetPack::open(const std::string& path) {
+    close();
+
+    MappedFile file(path);
+    if (!file.isOpen()) throw std::runtime_error("Cannot open asset pack: " + path);
+    if (file.size() < sizeof(PackHeader)) throw std::runtime_error("Truncated asset pack: " + path);
+
+    PackHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC)) != 0) {
+        throw std::runtime_error("Not an asset pack: " + path);
+    }
+    if (header.version != VERSION) {
+        throw std::runtime_error("Unsupported asset pack version " + std::to_string(header.version) + ": " + path);
+    }
+
+    const size_t indexEnd = sizeof(PackHeader) + (size_t)header.count * sizeof(AssetPackEntry);
+    if (indexEnd + header.namesSize > file.size()) throw std::runtime_error("Truncated asset pack: " + path);
+
+    // El índice se usa en el sitio: la proyección está alineada a página y la cabecera ocupa 16 bytes
+    const auto* entries = reinterpret_cast<const AssetPackEntry*>(file.data() + sizeof(PackHeader));
+    for (uint32_t i = 0; i < header.count; ++i) {
+        const AssetPackEntry& e = entries[i];
+        if ((size_t)e.nameOffset + e.nameLength > header.namesSize ||
+            e.offset % ALIGNMENT != 0 || e.offset + e.storedSize > file.size()) {
+            throw std::runtime_error("Inconsistent asset pack: " + path);
+        }
+    }
+
+    _file = std::move(file);
+    _entries = reinterpret_cast<const AssetPackEntry*>(_file.data() + sizeof(PackHeader));
+    _names = _file.data() + indexEnd;
+    _count = header.count;
+    _byName.reserve(_count);
+    for (uint32_t i = 0; i < header.count; ++i) _byName.emplace(name(i), i);
+}
+
+void AssetPack::close() {
+    _file.close();
+    _entries = nullptr;
+    _names = nullptr;
+    _count = 0;
+    _byName.clear();
+}
+
+std::string AssetPack::name(size_t i) const {
+    return std::string(_names + _entries[i].nameOffset, _entries[i].nameLength);
+}
+
+const AssetPackEntry* AssetPack::find(const std::string& name) const {
+    auto it = _byName.find(name);
+    return it != _byName.end() ? &_entries[it->second] : nullptr;
+}
+
+bool AssetPack::read(const AssetPackEntry& entry, std::vector<unsigned char>& scratch,
+                     const unsigned char*& data, size_t& size) const {
+    const auto* blob = reinterpret_cast<const unsigned char*>(_file.data() + entry.offset);
+    if (!(entry.flags & COMPRESSED)) {
+        data = blob;
+        size = entry.size;
+        return true;
+    }
+
+    int rawSize = 0;
+    unsigned char* raw = DecompressData(blob, (int)entry.storedSize, &rawSize);
+    if (raw == nullptr || (uint32_t)rawSize != entry.size) {
+        if (raw) MemFree(raw);
+        return false;
+    }
+    scratch.assign(raw, raw + rawSize);
+    MemFree(raw);
+    data = scratch.data();
+    size = scratch.size();
+    return true;
+}
+
+/**
+ * Write
+ *  - Primero se leen (y comprimen si compensa) todos los archivos para conocer
+ *    los tamaños; luego se escriben cabecera, índice, nombres y blobs alineados.
+ */
+size_t AssetPack::Write(const std::string& root, const std::vector<std::string>& dirs,
+                        const std::string& outPath) {
+    std::error_code ec;
+    if (!std::filesystem::is_directory(root, ec)) throw std::runtime_error("Asset root not found: " + root);
+
+    std::vector<std::string> names;
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(root)) {
+        if (!entry.is_regular_file()) continue;
+        const std::string name = entry.path().lexically_relative(root).generic_string();
+        if (name == PACK_NAME || name == AssetIndex::MANIFEST_NAME) continue;
+        if (UnderAnyDir(name, dirs)) names.push_back(name);
+    }
+    std::sort(names.begin(), names.end());
+
+    std::vector<AssetPackEntry> entries(names.size());
+    std::vector<std::vector<unsigned char>> blobs(names.size());
+    std::string nameTable;
+    for (size_t i = 0; i < names.size(); ++i) {
+        const std::string path = (std::filesystem::path(root) / names[i]).string();
+        std::vector<unsigned char> data = ReadFile(path);
+
+        AssetPackEntry& e = entries[i];
+        e = AssetPackEntry{};
+        e.size = (uint32_t)data.size();
+        e.nameOffset = (uint32_t)nameTable.size();
+        e.nameLength = (uint16_t)names[i].size();
+        int width = 0, height = 0;
+        if (AssetIndex::ReadPngSize(path, width, height)) {
+            e.width = width;
+            e.height = height;
+        }
+        nameTable += names[i];
+
+        int compSize = 0;
+        unsigned char* comp = data.empty() ? nullptr : CompressData(data.data(), (int)data.size(), &compSize);
+        if (comp != nullptr && (size_t)compSize * 10 <= data.size() * 9) {
+            blobs[i].assign(comp, comp + compSize);
+            e.flags |= COMPRESSED;
+        } else {
+            blobs[i] = std::move(data);
+        }
+        if (comp) MemFree(comp);
+        e.storedSize = (uint32_t)blobs[i].size();
+    }
+
+    size_t offset = AlignUp(sizeof(PackHeader) + entries.size() * sizeof(AssetPackEntry) + nameTable.size());
+    for (AssetPackEntry& e : entries) {
+        e.offset = offset;
+        offset = AlignUp(offset + e.storedSize);
+    }
+
+    std::ofstream out(outPath, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("Cannot write asset pack: " + outPath);
+
+    PackHeader header{};
+    std::memcpy(header.magic, PACK_MAGIC, sizeof(PACK_MAGIC));
+    header.version = VERSION;
+    header.count = (uint32_t)entries.size();
+    header.namesSize = (uint32_t)nameTable.size();
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()), (std::streamsize)(entries.size() * sizeof(AssetPackEntry)));
+    out.write(nameTable.data(), (std::streamsize)nameTable.size());
+
+    const char zeros[ALIGNMENT] = {};
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const size_t at = (size_t)out.tellp();
+        out.write(zeros, (std::streamsize)(entries[i].offset - at));
+        out.write(reinterpret_cast<const char*>(blobs[i].data()), (std::streamsize)blobs[i].size());
+    }
+    if (!out) throw std::runtime_error("Cannot write asset pack: " + outPath);
+    return entries.size();
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "MappedFile.hpp"
+
+/// Entrada del índice del paquete (POD, tal cual en disco).
+struct AssetPackEntry {
+    uint64_t offset;      // Inicio del blob desde el principio del archivo (alineado)
+    uint32_t storedSize;  // Bytes del blob en el paquete
+    uint32_t size;        // Bytes del archivo original (== storedSize si no está comprimido)
+    int32_t width;        // Dimensiones si es un PNG (0 si no)
+    int32_t height;
+    uint32_t nameOffset;  // Nombre lógico dentro de la tabla de nombres
+    uint16_t nameLength;
+    uint16_t flags;       // AssetPack::COMPRESSED
+};
+
+/**
+ * Clase AssetPack
+ *  - Paquete de assets en un único archivo: cabecera (magic "APAK", versión,
+ *    nº de entradas), índice de AssetPackEntry, tabla de nombres y los blobs,
+ *    cada uno alineado a ALIGNMENT.
+ *  - Se abre con MappedFile: leer una entrada sin comprimir devuelve un puntero
+ *    a la proyección (sin copias); las comprimidas (DEFLATE de raylib) se
+ *    descomprimen en un buffer del llamador.
+ *  - Write solo comprime una entrada si ahorra al menos un 10% (los PNG ya van
+ *    comprimidos y se guardan tal cual).
+ */
+class AssetPack {
+    public:
+        /// Nombre del paquete dentro de la raíz de assets.
+        static constexpr const char* PACK_NAME = "assets.pak";
+        /// Versión del formato. Subirla al cambiar la cabecera o AssetPackEntry.
+        static constexpr uint32_t VERSION = 1;
+        /// Alineación de cada blob dentro del archivo.
+        static constexpr size_t ALIGNMENT = 64;
+        /// Bits de AssetPackEntry::flags.
+        static constexpr uint16_t COMPRESSED = 1;
+
+        /**
+         * Proyecta 'path' y valida el índice (sustituye al paquete abierto).
+         * @throws std::runtime_error si no existe, no es un paquete o está truncado.
+         */
+        void open(const std::string& path);
+        void close();
+
+        bool isOpen() const { return _file.isOpen(); }
+        size_t count() const { return _count; }
+
+        const AssetPackEntry& entry(size_t i) const { return _entries[i]; }
+        std::string name(size_t i) const;
+
+        /// Entrada de 'name' o nullptr si no está en el paquete.
+        const AssetPackEntry* find(const std::string& name) const;
+
+        /**
+         * Contenido de una entrada.
+         *  - Sin comprimir: 'data' apunta a la proyección (válido mientras siga abierto).
+         *  - Comprimida: se descomprime en 'scratch' y 'data' apunta a él.
+         * @return false si no se puede descomprimir.
+         */
+        bool read(const AssetPackEntry& entry, std::vector<unsigned char>& scratch,
+                  const unsigned char*& data, size_t& size) const;
+
+        /**
+         * Empaqueta los archivos de 'root' que están bajo 'dirs' ("sprites", ...;
+         * vacío = todos) en 'outPath', en orden de nombre.
+         * @return número de entradas escritas.
+         * @throws std::runtime_error si la raíz no existe o no se puede escribir.
+         */
+        static size_t Write(const std::string& root, const std::vector<std::string>& dirs,
+                            const std::string& outPath);
+
+    private:
+        MappedFile _file;
+        const AssetPackEntry* _entries = nullptr;
+        const char* _names = nullptr;
+        size_t _count = 0;
+        std::unordered_map<std::string, uint32_t> _byName;
+};
@@ -0,0 +1,83 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+/**
+ * ByteWriter / ByteReader
+ *  - Archivo binario mínimo para tipos POD: cada valor se copia tal cual (sin
+ *    separadores ni padding extra) y cada vector va precedido de su tamaño.
+ *  - Solo vale para datos que se leen en la misma build que los escribió
+ *    (mismo endianness y mismo layout de structs).
+ *  - ByteReader lanza std::runtime_error si el buffer se acaba antes de tiempo.
+ */
+class ByteWriter {
+    public:
+        explicit ByteWriter(std::vector<uint8_t>& out) : _out(out) {}
+
+        template <typename T>
+        void pod(const T& value) {
+            static_assert(std::is_trivially_copyable_v<T>, "ByteWriter solo admite tipos POD");
+            bytes(&value, sizeof(T));
+        }
+
+        template <typename T>
+        void array(const std::vector<T>& values) {
+            static_assert(std::is_trivially_copyable_v<T>, "ByteWriter solo admite tipos POD");
+            pod(static_cast<uint32_t>(values.size()));
+            bytes(values.data(), values.size() * sizeof(T));
+        }
+
+        void bytes(const void* data, size_t size) {
+            if (size == 0) return;
+            const size_t at = _out.size();
+            _out.resize(at + size);
+            std::memcpy(_out.data() + at, data, size);
+        }
+
+    private:
+        std::vector<uint8_t>& _out;
+};
+
+class ByteReader {
+    public:
+        ByteReader(const uint8_t* data, size_t size) : _at(data), _end(data + size) {}
+
+        template <typename T>
+        T pod() {
+            static_assert(std::is_trivially_copyable_v<T>, "ByteReader solo admite tipos POD");
+            // Sin constructor por defecto: se copia a memoria alineada y se reinterpreta
+            alignas(T) unsigned char raw[sizeof(T)];
+            bytes(raw, sizeof(T));
+            return *std::launder(reinterpret_cast<T*>(raw));
+        }
+
+        template <typename T>
+        void array(std::vector<T>& values) {
+            static_assert(std::is_trivially_copyable_v<T>, "ByteReader solo admite tipos POD");
+            const uint32_t count = pod<uint32_t>();
+            if (static_cast<size_t>(_end - _at) / sizeof(T) < count) {
+                throw std::runtime_error("Truncated binary data");
+            }
+            values.resize(count);
+            bytes(values.data(), count * sizeof(T));
+        }
+
+        void bytes(void* data, size_t size) {
+            if (static_cast<size_t>(_end - _at) < size) throw std::runtime_error("Truncated binary data");
+            if (size == 0) return;
+            std::memcpy(data, _at, size);
+            _at += size;
+        }
+
+        bool atEnd() const { return _at == _end; }
+        size_t remaining() const { return static_cast<size_t>(_end - _at); }
+
+    private:
+        const uint8_t* _at;
+        const uint8_t* _end;
+};
@@ -1,9 +1,48 @@
 #pragma once
+#include <cstddef>
 
 inline constexpr int TILE_SIZE  = 32; // Tamaño de tile global
 inline constexpr int HUD_HEIGHT = 80; // Altura de la franja de HUD inferior
 inline constexpr int WINDOW_WIDTH  = 1280; // Anchura de la ventana
 inline constexpr int WINDOW_HEIGHT = 800;  // Altura de la ventana
+inline constexpr int RENDER_CULL_MARGIN_TILES = 2; // Margen (en tiles) alrededor de la vista que se sigue dibujando
+inline constexpr int SIM_TICK_HZ = 120; // Frecuencia fija de la simulación (independiente del render)
+inline constexpr float SIM_TICK_DT = 1.0f / SIM_TICK_HZ; // Duración de un tick de simulación
+inline constexpr int MAX_SIM_TICKS_PER_FRAME = 8; // Tope de ticks por frame: tras un parón no se intenta recuperar todo
+inline constexpr int ENEMY_AI_CHUNK_SIZE = 32; // Enemigos por trabajo al repartir la IA entre hilos
+inline constexpr int AI_NEAR_RADIUS_TILES = 12; // Enemigos a esta distancia (celdas) o menos se actualizan cada tick
+inline constexpr int AI_MID_RADIUS_TILES = 32; // Hasta esta distancia se actualizan cada AI_MID_INTERVAL_TICKS (o cada tick si se ven)
+inline constexpr unsigned AI_MID_INTERVAL_TICKS = 4; // Ticks entre actualizaciones de enemigos a media distancia
+inline constexpr unsigned AI_FAR_INTERVAL_TICKS = 16; // Ticks entre actualizaciones de enemigos lejanos
+inline constexpr float ENEMY_AI_TIME_BUDGET_S = 0.0f; // Presupuesto por tick para la IA diferida (0 = sin límite)
+inline constexpr size_t DISTANCE_ORACLE_MAX_CELLS = 1024; // Mapas hasta este nº de celdas precalculan todas las distancias (tabla n² de uint16)
+inline constexpr size_t DISTANCE_ORACLE_SOURCES_PER_JOB = 64; // BFS por trabajo al construir la tabla en paralelo
+inline constexpr size_t NAV_HIERARCHY_MIN_CELLS = 256 * 256; // Desde este nº de celdas la IA navega con NavHierarchy (HPA*) en vez de FlowField
+inline constexpr int NAV_CLUSTER_SIZE = 16; // Lado (en celdas) de los clusters de NavHierarchy
+inline constexpr int NAV_ENTRANCE_SPLIT = 6; // Tramos de frontera de esta longitud o más tienen dos entradas (una por extremo)
+inline constexpr size_t NAV_MAX_EXPANSIONS = 4096; // Tope de nodos expandidos por consulta de NavHierarchy (al llegar, ruta parcial hacia el objetivo)
+inline constexpr size_t NAV_CLUSTERS_PER_JOB = 16; // Clusters por trabajo al construir NavHierarchy en paralelo
+inline constexpr size_t PATH_MAX_EXPANSIONS = 4096; // Tope de nodos expandidos por consulta de PathService (sin camino → false)
+inline constexpr float TEXTURE_UPLOAD_BUDGET_S = 0.004f; // Tiempo máximo por frame para subir texturas a GPU
+inline constexpr float CHECKPOINT_INTERVAL_S = 5.0f; // Segundos de partida entre checkpoints automáticos (LevelSnapshot)
+inline constexpr size_t CHECKPOINT_MAX_CELLS = 256 * 256; // Por encima de este nº de celdas solo hay checkpoint al empezar (copiar mapa y cachés daría tirones)
+inline constexpr int MAP_CHUNK_SIZE = 64; // Lado (en celdas) de los chunks de los mapas por chunks (.lvc); una palabra de máscara por fila
+inline constexpr int MAP_CHUNK_LOAD_RADIUS = 1; // Chunks alrededor del chunk del jugador que se cargan (1 = 3x3, cubre la vista)
+inline constexpr size_t MAP_CHUNK_MAX_RESIDENT = 25; // Chunks cargados como máximo; por encima se descargan los menos usados fuera del radio
+inline constexpr int LEVEL_PREFETCH_DISTANCE_TILES = 8; // Celdas (Manhattan) a la salida a partir de las que se prepara el siguiente nivel
+
+inline constexpr const char* TEX_WALLS_FLOOR = "sprites/walls_floor.png"; // Suelo, paredes y salida del mapa
+inline constexpr const char* TEX_SPIKES = "sprites/spikes.png"; // Pinchos
+inline constexpr const char* TEX_SKELETON_IDLE = "sprites/enemy/Skeleton/Idle.png"; // Enemigo parado
+inline constexpr const char* TEX_SKELETON_WALK = "sprites/enemy/Skeleton/Walk.png"; // Enemigo andando
+inline constexpr const char* TEX_ICONS = "sprites/icons/Icons.png"; // Llaves e iconos del HUD
+inline constexpr const char* TEX_DOORS_LEVER = "sprites/mecs/doors_lever_chest_animation.png"; // Puertas, palancas y puentes
+inline constexpr const char* TEX_TRAP_SAW = "sprites/mecs/trap_saw.png"; // Trampa de sierra
+inline constexpr const char* TEX_FIRE_TRAP = "sprites/mecs/fire_trap.png"; // Trampa de fuego
+inline constexpr const char* LEVEL_TEXTURES[] = { // Todas las de un nivel (RequestLevelTextures las pide de antemano)
+    TEX_WALLS_FLOOR, TEX_SPIKES, TEX_SKELETON_IDLE, TEX_SKELETON_WALK,
+    TEX_ICONS, TEX_DOORS_LEVER, TEX_TRAP_SAW, TEX_FIRE_TRAP,
+};
 
 /**
  * Coordenada entera en el grid del mapa (no en píxeles).
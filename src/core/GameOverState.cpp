@@ -9,6 +9,8 @@ extern "C" {
 
 // Definiciones de constantes estáticas
 #include "Localization.hpp"
+#include "ecs/systems/LevelSetupSystem.hpp"
+#include "LevelPrefetcher.hpp"
 
 std::string GetButtonSprite(const std::string& base) {
     return "sprites/icons/" + base + GetButtonSpriteLangSuffix() + ".png";
@@ -36,14 +38,14 @@ void GameOverState::_loadSprites(const std::vector<std::string>& sprites) {
         std::string bg = sprites[0];
         if (bg.find("background_pasar_nivel") != std::string::npos) {
             // Si existe el archivo en inglés y el idioma es inglés, úsalo, si no, usa el español
-            if (suf == "_en" && std::filesystem::exists(rm.GetAssetPath("sprites/menus/background_pasar_nivel_en.png"))) {
+            if (suf == "_en" && rm.HasAsset("sprites/menus/background_pasar_nivel_en.png")) {
                 bg = "sprites/menus/background_pasar_nivel_en.png";
             } else {
                 bg = "sprites/menus/background_pasar_nivel.png";
             }
         } else if (bg.find("background_congratulations") != std::string::npos) {
             // Si existe el archivo en español, úsalo por defecto
-            if (suf == "_en" && !std::filesystem::exists(rm.GetAssetPath("sprites/menus/background_congratulations_en.png"))) {
+            if (suf == "_en" && !rm.HasAsset("sprites/menus/background_congratulations_en.png")) {
                 bg = "sprites/menus/background_congratulations.png";
             } else {
                 bg = "sprites/menus/background_congratulations" + suf + ".png";
@@ -60,11 +62,13 @@ void GameOverState::_loadSprites(const std::vector<std::string>& sprites) {
             if (pos != std::string::npos) {
                 spanishBg.erase(pos, 3); // quitar "_en"
             }
-            if (std::filesystem::exists(rm.GetAssetPath(spanishBg))) {
+            if (rm.HasAsset(spanishBg)) {
                 // Para la variante _en de "background_pasar_nivel" queremos que ocupe
                 // toda la altura del juego y mantener la proporción.
-                const Texture2D& texEn = rm.GetTexture(bg);
-                const Texture2D& texEs = rm.GetTexture(spanishBg);
+                const Texture2D& texEn = *_background;
+                // Del español solo hace falta el ancho: se lee del índice sin cargar la textura
+                int esWidth = 0, esHeight = 0;
+                if (!rm.Assets().imageSize(spanishBg, esWidth, esHeight)) esWidth = rm.GetTexture(spanishBg).width;
                 if (bg.find("background_pasar_nivel_en") != std::string::npos) {
                     // Mostrar la variante _en con el mismo rectángulo que la versión
                     // en español: pantalla completa. Así evitar cambios de escala
@@ -72,7 +76,7 @@ void GameOverState::_loadSprites(const std::vector<std::string>& sprites) {
                     backgroundDrawRect_ = {0, 0, (float)WINDOW_WIDTH, (float)WINDOW_HEIGHT};
                 } else {
                     // Mantener el comportamiento previo (usar ancho de la versión española para conservar apariencia)
-                    float scale = (float)WINDOW_WIDTH / (float)texEs.width; // usar la escala del español
+                    float scale = (float)WINDOW_WIDTH / (float)esWidth; // usar la escala del español
                     float destW = texEn.width * scale;
                     float destH = texEn.height * scale;
                     backgroundDrawRect_.width = destW;
@@ -94,7 +98,9 @@ void GameOverState::_loadSprites(const std::vector<std::string>& sprites) {
             if (s.find("items_congratulations") != std::string::npos) {
                 s = "sprites/menus/items_congratulations" + suf + ".png";
             }
-            rm.GetTexture(s);
+            // Botones y títulos se suben en segundo plano: render() no los dibuja
+            // hasta que IsTextureReady (GetTexture bloquearía el frame)
+            rm.RequestTexture(s);
         }
     }
 }
@@ -109,6 +115,14 @@ void GameOverState::init() {
         // Nivel completado - cargar background y botones
         _loadSprites(_spritesPaths.levelCompletedSprites);
     }
+
+    // Mientras se muestra esta pantalla se decodifica lo del siguiente nivel; si
+    // es uno nuevo, además se lee su mapa en segundo plano (LevelPrefetcher)
+    if (!_isVictory && !_isDead && _currentLevel < 6) {
+        LevelPrefetcher::Get().prefetch(_currentLevel + 1);
+    } else if (!_isVictory) {
+        RequestLevelTextures();
+    }
 }
 
 //rectangulo del boton de idioma
@@ -273,6 +287,8 @@ void GameOverState::update(float)
 void GameOverState::_renderButtons(const ButtonConfig& config, const std::string& tex1, const std::string& tex2, bool useHover) {
     auto& rm = ResourceManager::Get();
 
+    // Aún decodificándose (ver _loadSprites): se dibujan en cuanto estén listos
+    if (!rm.IsTextureReady(tex1) || !rm.IsTextureReady(tex2)) return;
     const Texture2D& t1 = rm.GetTexture(tex1);
     const Texture2D& t2 = rm.GetTexture(tex2);
 
@@ -384,42 +400,49 @@ void GameOverState::render()
         DrawText(timeText, textX, textY, _TIME_FONT_SIZE, GOLD);
     } else if (_isVictory) {
         std::string suf = GetButtonSpriteLangSuffix();
-        const Texture2D& congrats = rm.GetTexture("sprites/menus/items_congratulations" + suf + ".png");
-        // Ajustar tamaño y posición para que coincida con el español
-        float scale = _CONGRATS_SCALE;
-        float width = congrats.width * scale;
-        float height = congrats.height * scale;
-        float x = (WINDOW_WIDTH - width) / 2.0f;
-        float y = _CONGRATS_Y;
-        // Si es inglés, forzar el mismo ancho y alto que el sprite español
-        if (suf == "_en") {
-            const Texture2D& congrats_es = rm.GetTexture("sprites/menus/items_congratulations.png");
-            width = congrats_es.width * scale;
-            height = congrats_es.height * scale;
-            x = (WINDOW_WIDTH - width) / 2.0f;
-            y = _CONGRATS_Y;
+        const std::string congratsPath = "sprites/menus/items_congratulations" + suf + ".png";
+        // Títulos y botones aún decodificándose (ver _loadSprites) no se dibujan
+        if (rm.IsTextureReady(congratsPath)) {
+            const Texture2D& congrats = rm.GetTexture(congratsPath);
+            // Ajustar tamaño y posición para que coincida con el español
+            float scale = _CONGRATS_SCALE;
+            float width = congrats.width * scale;
+            float height = congrats.height * scale;
+            float x = (WINDOW_WIDTH - width) / 2.0f;
+            float y = _CONGRATS_Y;
+            // Si es inglés, forzar el mismo ancho y alto que el sprite español
+            // (del índice de assets: no hace falta tener esa textura cargada)
+            int esWidth = 0, esHeight = 0;
+            if (suf == "_en" && rm.Assets().imageSize("sprites/menus/items_congratulations.png", esWidth, esHeight)) {
+                width = esWidth * scale;
+                height = esHeight * scale;
+                x = (WINDOW_WIDTH - width) / 2.0f;
+                y = _CONGRATS_Y;
+            }
+            DrawTexturePro(
+                congrats,
+                {0, 0, (float)congrats.width, (float)congrats.height},
+                {x, y, width, height},
+                {0, 0}, 0.0f, WHITE
+            );
         }
-        DrawTexturePro(
-            congrats,
-            {0, 0, (float)congrats.width, (float)congrats.height},
-            {x, y, width, height},
-            {0, 0}, 0.0f, WHITE
-        );
     } else {
-        const Texture2D& gameOver = rm.GetTexture("sprites/menus/game_over.png");
+        if (rm.IsTextureReady("sprites/menus/game_over.png")) {
+            const Texture2D& gameOver = rm.GetTexture("sprites/menus/game_over.png");
         
-        float scale = _GAME_OVER_SCALE;
-        float width = gameOver.width * scale;
-        float height = gameOver.height * scale;
-        float x = (WINDOW_WIDTH - width) / 2.0f;
-        float y = _GAME_OVER_Y;
+            float scale = _GAME_OVER_SCALE;
+            float width = gameOver.width * scale;
+            float height = gameOver.height * scale;
+            float x = (WINDOW_WIDTH - width) / 2.0f;
+            float y = _GAME_OVER_Y;
         
-        DrawTexturePro(
-            gameOver,
-            {0, 0, (float)gameOver.width, (float)gameOver.height},
-            {x, y, width, height},
-            {0, 0}, 0.0f, WHITE
-        );
+            DrawTexturePro(
+                gameOver,
+                {0, 0, (float)gameOver.width, (float)gameOver.height},
+                {x, y, width, height},
+                {0, 0}, 0.0f, WHITE
+            );
+        }
     }
 
     // Renderizar botones según el estado
@@ -58,6 +58,12 @@ class GameOverState : public GameState
         void pause() override {}
         void resume() override {}
 
+        // Resultado de la partida (lo consulta el simulador headless)
+        int level() const { return _currentLevel; }
+        bool isDead() const { return _isDead; }
+        bool isVictory() const { return _isVictory; }
+        float remainingTime() const { return _remainingTime; }
+
     private:
         // Variables de estado
         int _currentLevel = 1;
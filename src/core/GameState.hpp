@@ -17,6 +17,10 @@ class GameState
         virtual void pause() = 0;
         virtual void resume() = 0;
 
+        // Fracción [0,1) del siguiente tick fijo ya acumulada; los estados que
+        // interpolan el render entre ticks la guardan antes de render()
+        virtual void setRenderAlpha(float alpha) { (void)alpha; }
+
         void setStateMachine(StateMachine* stt_mch) {state_machine = stt_mch;}
     protected:
         StateMachine* state_machine = nullptr;
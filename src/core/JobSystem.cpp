@@ -0,0 +1,113 @@
+#include "JobSystem.hpp"
+#include <algorithm>
+
+JobSystem& JobSystem::Get() {
+    // static garantiza que solo se crea una vez
+    static JobSystem instance(std::max(1u, std::thread::hardware_concurrency()) - 1);
+    return instance;
+}
+
+JobSystem::JobSystem(unsigned int workerCount) {
+    // Una cola más que workers: la última es la del hilo que llama a parallelFor
+    for (unsigned int i = 0; i <= workerCount; ++i) {
+        _queues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (unsigned int i = 0; i < workerCount; ++i) {
+        _workers.emplace_back([this, i]() { _workerLoop(i); });
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _stopping = true;
+    }
+    _wake.notify_all();
+    for (auto& worker : _workers) {
+        worker.join();
+    }
+}
+
+void JobSystem::_push(Job job) {
+    // Sin workers todo va a la cola del hilo llamante
+    size_t index = _workers.empty() ? 0 : _nextQueue.fetch_add(1) % _workers.size();
+    {
+        std::lock_guard<std::mutex> lock(_queues[index]->mutex);
+        _queues[index]->jobs.push_back(std::move(job));
+    }
+    {
+        // Bajo el mutex de espera para no perder el aviso de un worker que se va a dormir
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _queued.fetch_add(1);
+    }
+    _wake.notify_one();
+}
+
+bool JobSystem::_tryRun(size_t self) {
+    Job job;
+    const size_t n = _queues.size();
+
+    // 1) la cola propia, por el final (lo último encolado sigue caliente en caché)
+    {
+        WorkQueue& own = *_queues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+        }
+    }
+
+    // 2) robar del principio de las demás
+    for (size_t k = 1; !job && k < n; ++k) {
+        WorkQueue& victim = *_queues[(self + k) % n];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+        }
+    }
+
+    if (!job) return false;
+    _queued.fetch_sub(1);
+    job();
+    return true;
+}
+
+void JobSystem::_workerLoop(size_t self) {
+    while (true) {
+        if (_tryRun(self)) continue;
+
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _wake.wait(lock, [this]() { return _stopping || _queued.load() > 0; });
+        if (_stopping) return;
+    }
+}
+
+void JobSystem::parallelFor(size_t count, size_t chunk, const std::function<void(size_t, size_t)>& fn) {
+    if (count == 0) return;
+    chunk = std::max<size_t>(chunk, 1);
+
+    // Un solo trozo o sin workers: no compensa pasar por las colas
+    if (count <= chunk || _workers.empty()) {
+        fn(0, count);
+        return;
+    }
+
+    const size_t chunks = (count + chunk - 1) / chunk;
+    std::atomic<size_t> remaining{chunks};
+
+    for (size_t c = 0; c < chunks; ++c) {
+        const size_t begin = c * chunk;
+        const size_t end = std::min(count, begin + chunk);
+        _push([&fn, &remaining, begin, end]() {
+            fn(begin, end);
+            remaining.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    // El hilo llamante ayuda (roba) en lugar de quedarse bloqueado
+    const size_t self = _queues.size() - 1;
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        if (!_tryRun(self)) std::this_thread::yield();
+    }
+}
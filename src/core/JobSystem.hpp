@@ -0,0 +1,63 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Pool de hilos con robo de trabajo.
+ *
+ *  - Cada worker tiene su propia cola: saca trabajo del final de la suya y,
+ *    si está vacía, roba del principio de la de otro.
+ *  - parallelFor reparte [0, count) en trozos y bloquea hasta acabarlos; el
+ *    hilo que llama también ejecuta trozos mientras espera.
+ *  - Con 0 workers (máquina de un núcleo) todo se ejecuta en el hilo que llama.
+ *
+ * Las tareas no deben cambiar la estructura del registry (crear/destruir
+ * entidades, añadir/quitar componentes): solo leer y escribir componentes propios.
+ */
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+
+    // patron singleton: un worker por núcleo menos el hilo principal
+    static JobSystem& Get();
+
+    explicit JobSystem(unsigned int workerCount);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    unsigned int workerCount() const { return (unsigned int)_workers.size(); }
+
+    // Ejecuta fn(begin, end) sobre [0, count) en trozos de como mucho 'chunk'
+    // elementos. Si cabe en un trozo se ejecuta directamente en el hilo actual.
+    void parallelFor(size_t count, size_t chunk, const std::function<void(size_t, size_t)>& fn);
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    // Encola en la cola de un worker (reparto round-robin)
+    void _push(Job job);
+    // Saca trabajo de la cola 'self' o roba de otra; false si no hay nada
+    bool _tryRun(size_t self);
+    void _workerLoop(size_t self);
+
+    std::vector<std::unique_ptr<WorkQueue>> _queues;
+    std::vector<std::thread> _workers;
+
+    std::mutex _sleepMutex;
+    std::condition_variable _wake;
+    std::atomic<size_t> _queued{0};
+    std::atomic<size_t> _nextQueue{0};
+    bool _stopping = false;
+};
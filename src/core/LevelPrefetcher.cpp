@@ -0,0 +1,129 @@
+#include "LevelPrefetcher.hpp"
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include "Config.hpp"
+#include "BinaryIO.hpp"
+#include "ResourceManager.hpp"
+#include "ecs/systems/LevelSetupSystem.hpp"
+#include "objects/Map.hpp"
+
+namespace {
+    // Ruta del mapa compilado ('extension': .lvl o .lvc) junto a 'textPath';
+    // vacía si no existe o está desfasado
+    std::string CompiledMapPath(const std::string& textPath, const char* extension) {
+        std::filesystem::path binary(textPath);
+        binary.replace_extension(extension);
+
+        std::error_code ec;
+        const auto binaryTime = std::filesystem::last_write_time(binary, ec);
+        if (ec) return std::string();
+        const auto textTime = std::filesystem::last_write_time(textPath, ec);
+        if (!ec && textTime > binaryTime) return std::string();
+        return binary.string();
+    }
+}
+
+std::string LevelMapPath(int level) {
+    return ResourceManager::Get().GetAssetPath("maps/map_" + std::to_string(level) + ".txt");
+}
+
+void LoadLevelMap(Map& map, const std::string& textPath, int tile) {
+    // Si mapc ha compilado el nivel (y el .txt no es más nuevo) se carga el
+    // binario; por chunks (.lvc) si existe, para mapas que no caben enteros
+    const std::string chunkedPath = CompiledMapPath(textPath, ".lvc");
+    const std::string binaryPath = CompiledMapPath(textPath, ".lvl");
+
+    // Elegir por fecha no garantiza que el compilado se pueda leer (versión de
+    // otro build, copia a medias): si falla se avisa y se sigue con el siguiente.
+    // Cada carga parte de cero, así que un intento fallido no deja restos
+    if (!chunkedPath.empty()) {
+        try {
+            map.loadChunked(chunkedPath, tile);
+            return;
+        } catch (const std::exception& e) {
+            std::cerr << "Mapa por chunks descartado (" << chunkedPath << "): " << e.what() << std::endl;
+        }
+    }
+    if (!binaryPath.empty()) {
+        try {
+            map.loadFromBinary(binaryPath, tile);
+            return;
+        } catch (const std::exception& e) {
+            std::cerr << "Mapa binario descartado (" << binaryPath << "): " << e.what() << std::endl;
+        }
+    }
+    map.loadFromFile(textPath, tile);
+}
+
+bool LevelMapSize(const std::string& textPath, int& width, int& height) {
+    for (const char* extension : { ".lvc", ".lvl" }) {
+        const std::string compiled = CompiledMapPath(textPath, extension);
+        if (!compiled.empty() && Map::peekSize(compiled, width, height)) return true;
+    }
+    return Map::peekSize(textPath, width, height);
+}
+
+LevelPrefetcher& LevelPrefetcher::Get() {
+    static LevelPrefetcher instance;
+    return instance;
+}
+
+void LevelPrefetcher::prefetch(int level) {
+    if (isPending(level)) return;
+    // GetAssetPath y las peticiones de texturas no son seguras fuera del hilo principal
+    prefetchFile(level, LevelMapPath(level));
+    RequestLevelTextures();
+}
+
+void LevelPrefetcher::prefetchFile(int level, const std::string& textPath) {
+    if (isPending(level)) return;
+    clear();
+
+    _level = level;
+    _pending = std::async(std::launch::async, [textPath]() {
+        // El Map es local al hilo: sin texturas ni estado compartido
+        Map map;
+        LoadLevelMap(map, textPath, TILE_SIZE);
+
+        std::vector<uint8_t> state;
+        if (!map.isChunked()) {
+            ByteWriter out(state);
+            map.saveState(out);
+        }
+        return state;
+    });
+}
+
+bool LevelPrefetcher::isReady(int level) const {
+    return isPending(level) && _pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+bool LevelPrefetcher::adopt(int level, Map& map) {
+    // Otro nivel: no se espera a su hilo y se deja como está (el siguiente
+    // prefetch lo sustituye); el llamador carga 'level' directamente
+    if (!isPending(level)) return false;
+
+    _level = 0;
+    std::vector<uint8_t> state;
+    try {
+        state = _pending.get();
+    } catch (const std::exception& e) {
+        std::cerr << "Nivel " << level << " preparado descartado: " << e.what() << std::endl;
+        return false;
+    }
+    if (state.empty()) return false;
+
+    ByteReader in(state.data(), state.size());
+    map.restoreState(in);
+    return true;
+}
+
+void LevelPrefetcher::clear() {
+    // get() espera al hilo y se queda con la excepción, si la hubo
+    if (_pending.valid()) {
+        try { _pending.get(); } catch (const std::exception&) {}
+    }
+    _level = 0;
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <cstdint>
+#include <future>
+#include <string>
+#include <vector>
+
+class Map;
+
+/**
+ * Clase LevelPrefetcher
+ *  - Prepara el siguiente nivel mientras se juega el actual: lee y valida el mapa
+ *    en un hilo aparte (std::async, como las decodificaciones de ResourceManager)
+ *    y pide sus texturas con RequestLevelTextures.
+ *  - El resultado es el estado del mapa (Map::saveState) ya empaquetado;
+ *    MainGameState::init lo vuelca con restoreState en vez de releer el archivo.
+ *  - Solo guarda un nivel a la vez. Los mapas por chunks no se preparan: su
+ *    carga ya es casi inmediata y no se pueden empaquetar (se cargan en init).
+ *  - prefetch/adopt se llaman desde el hilo principal.
+ */
+class LevelPrefetcher {
+    public:
+        // patron singleton: un único nivel preparado para toda la partida
+        static LevelPrefetcher& Get();
+
+        /**
+         * Empieza a preparar 'level' (maps/map_N.txt) si no lo estaba ya y pide sus texturas.
+         * Pedir otro nivel descarta el anterior (esperando a su hilo si seguía en marcha).
+         */
+        void prefetch(int level);
+
+        /// Igual que prefetch(level) pero con la ruta del mapa de texto ya resuelta y sin texturas.
+        void prefetchFile(int level, const std::string& textPath);
+
+        /// true si 'level' se está preparando o ya está listo.
+        bool isPending(int level) const { return _level == level && _pending.valid(); }
+
+        /// true si el hilo de 'level' ya ha terminado (adopt no bloqueará).
+        bool isReady(int level) const;
+
+        /**
+         * Vuelca en 'map' el nivel preparado, esperando al hilo si aún no ha acabado.
+         *  - Si lo preparado es de 'level' lo consume.
+         *  - Si es de otro nivel no bloquea ni lo toca: sigue pendiente.
+         * @return false si no había nada de 'level' o el mapa no era válido: el
+         *         llamador lo carga como siempre (y ve el error si lo hay).
+         */
+        bool adopt(int level, Map& map);
+
+        /// Descarta lo preparado (espera al hilo si seguía en marcha).
+        void clear();
+
+    private:
+        LevelPrefetcher() = default;
+        ~LevelPrefetcher() = default;
+
+        LevelPrefetcher(const LevelPrefetcher&) = delete;
+        LevelPrefetcher& operator=(const LevelPrefetcher&) = delete;
+
+    private:
+        int _level = 0;
+        // Estado empaquetado del mapa; vacío si es un mapa por chunks
+        std::future<std::vector<uint8_t>> _pending;
+};
+
+/// Ruta del mapa de texto del nivel (maps/map_N.txt) dentro de los assets.
+std::string LevelMapPath(int level);
+
+/**
+ * Carga el mapa de textPath como lo hace el juego: el binario compilado por mapc
+ * si existe y no está desfasado (.lvc por chunks, si no .lvl) o el texto.
+ * Un compilado que no se puede leer se descarta (con aviso) y se carga el texto.
+ * @throws std::runtime_error si el archivo de texto no existe o el mapa no es válido.
+ */
+void LoadLevelMap(Map& map, const std::string& textPath, int tile);
+
+/**
+ * Tamaño (celdas) del mapa que cargaría LoadLevelMap, sin cargarlo: cabecera del
+ * compilado si lo elegiría, si no las filas del texto (Map::peekSize).
+ * @return false si no se puede leer ninguno.
+ */
+bool LevelMapSize(const std::string& textPath, int& width, int& height);
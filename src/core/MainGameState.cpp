@@ -7,8 +7,12 @@
 #include "ResourceManager.hpp"
 #include "PlayerSelection.hpp"
 #include "PlayerSpriteCatalog.hpp"
+#include "LevelPrefetcher.hpp"
 #include "ecs/Ecs.hpp"
 #include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <random>
 extern "C" {
   #include <raylib.h>
 }
@@ -22,37 +26,114 @@ static int ComputeFramesForTexture(const Texture2D& tex) {
 MainGameState::MainGameState(int level)
 {
     _level = level > 0 ? level : 1;
+    // Semilla distinta en cada partida salvo que alguien la fije (simulador, repeticiones)
+    std::random_device rd;
+    _seed = ((uint64_t)rd() << 32) | rd();
+}
+
+namespace {
+    /**
+     * Captura del nivel recién montado (mapa + registry tras LevelSetupSystem y
+     * el jugador). Reiniciar el mismo nivel con el mismo sprite de jugador la
+     * restaura en vez de releer el mapa y repetir el montaje.
+     */
+    struct LevelStartSnapshot {
+        int level = 0;
+        std::string spriteKey;
+        LevelSnapshot snapshot;
+    };
+
+    LevelStartSnapshot& GetLevelStartSnapshot() {
+        static LevelStartSnapshot start;
+        return start;
+    }
+
+    // El sprite del jugador forma parte de la captura: elegir otro la invalida
+    std::string PlayerSpriteKey() {
+        if (!PlayerSelection::HasSelectedSpriteSet()) return std::string();
+        return PlayerSelection::GetSelectedIdlePath() + "|" + PlayerSelection::GetSelectedWalkPath();
+    }
 }
 
 void MainGameState::init()
 {
-    auto& rm = ResourceManager::Get();
-    std::string relativePath = "maps/map_" + std::to_string(_level) + ".txt";
-    std::string absolutePath = rm.GetAssetPath(relativePath);
+    auto& start = GetLevelStartSnapshot();
+    const std::string spriteKey = PlayerSpriteKey();
+
+    if (start.level == _level && start.spriteKey == spriteKey && !start.snapshot.empty()) {
+        // Reinicio: mismo estado inicial, solo cambia la semilla de los enemigos
+        start.snapshot.restore(_registry, _map);
+        ReseedRandomStreams(_registry, _seed);
+        _map.loadTextures();
+        _tile = _map.tile();
+    } else {
+        // Si el nivel se preparó en segundo plano (pantalla de nivel completado o
+        // jugador cerca de la salida) solo queda volcarlo; si no, se lee ahora
+        if (!LevelPrefetcher::Get().adopt(_level, _map)) {
+            LoadLevelMap(_map, LevelMapPath(_level), TILE_SIZE);
+        }
+        _map.loadTextures(); //lo llamamos aqui ya q tambien se llama en main y no se pueden cargar texturas antes de InitWindow
+        _tile = _map.tile();
+
+        // Cargar entidades del nivel en el registry
+        LevelSetupSystem(_registry, _map, _seed);
+
+        // Verificar si LevelSetupSystem ya creó el jugador
+        if (_registry.view<PlayerInputComponent>().empty()) _createPlayer();
 
-    _map.loadFromFile(absolutePath, TILE_SIZE);
-    _map.loadTextures(); //lo llamamos aqui ya q tambien se llama en main y no se pueden cargar texturas antes de InitWindow
-    _tile = _map.tile();
+        // Un mapa por chunks no está entero en memoria: no se captura
+        if (_map.isChunked()) {
+            start.level = 0;
+            start.snapshot.clear();
+        } else {
+            start.level = _level;
+            start.spriteKey = spriteKey;
+            start.snapshot.capture(_registry, _map);
+        }
+        std::cout << "Nivel cargado. Entidades generadas via ECS." << std::endl;
+    }
+
+    // Salidas del nivel: acercarse a una prepara el siguiente en segundo plano.
+    // En mapas por chunks no se buscan (no hay mapa entero que recorrer).
+    _exitCells.clear();
+    if (!_map.isChunked()) {
+        for (int y = 0; y < _map.height(); ++y) {
+            for (int x = 0; x < _map.width(); ++x) {
+                if (_map.cellType(x, y) == CellType::Exit) _exitCells.push_back({ x, y });
+            }
+        }
+    }
 
     // Guardar total de llaves del mapa (antes de que se recojan)
     _totalKeysInMap = _map.getTotalKeys();
 
-    // Cargar entidades del nivel en el registry
-    LevelSetupSystem(_registry, _map);
-
     // Inicializar temporizador: 45s base + 60s por cada nivel adicional
     levelTime_ = 45.0f + (_level - 1) * 60.0f;
 
-    // ---------------------------------------------------------
-    // REFACTOR: ENTT
-    // ---------------------------------------------------------
-    // --- PLAYER ---
-    // Verificar si LevelSetupSystem ya creó el jugador
-    auto existingPlayerView = _registry.view<PlayerInputComponent>();
-    if (!existingPlayerView.empty()) {
-        // El jugador ya existe, no crear uno nuevo
-        return;
-    }
+    saveCheckpoint();
+}
+
+void MainGameState::saveCheckpoint()
+{
+    // Sin checkpoints en mapas por chunks (LevelSnapshot necesita el mapa entero)
+    _checkpointTimer = 0.0f;
+    if (_map.isChunked()) return;
+    _checkpoint.capture(_registry, _map);
+    _checkpointLevelTime = levelTime_;
+}
+
+bool MainGameState::loadCheckpoint()
+{
+    if (_checkpoint.empty()) return false;
+    _checkpoint.restore(_registry, _map);
+    levelTime_ = _checkpointLevelTime;
+    _checkpointTimer = 0.0f;
+    return true;
+}
+
+void MainGameState::_createPlayer()
+{
+    auto& rm = ResourceManager::Get();
 
     // 1. Obtener coordenadas del grid donde está la 'P' (ej: x=2, y=3)
     IVec2 startGridPos = _map.playerStart();
@@ -122,8 +203,6 @@ void MainGameState::init()
         Rectangle{ -hitSize/2, -hitSize/2, hitSize, hitSize },
         CollisionType::Player
     );
-
-    std::cout << "Nivel cargado. Entidades generadas via ECS." << std::endl;
 }
 
 void MainGameState::handleInput()
@@ -137,7 +216,13 @@ void MainGameState::handleInput()
         return;
     }
 
-    // 2. Salir al estado de Game Over al presionar ESPACIO (simulando derrota)
+    // 2. Volver al último checkpoint
+    if (IsKeyPressed(KEY_F9)) {
+        loadCheckpoint();
+        return;
+    }
+
+    // 3. Salir al estado de Game Over al presionar ESPACIO (simulando derrota)
     if (IsKeyPressed(KEY_SPACE)) {
         // Argumentos de GameOverState: nivel actual, ha muerto (true), tiempo restante, juego terminado (false)
         this->state_machine->add_state(
@@ -148,6 +233,25 @@ void MainGameState::handleInput()
     }
 }
 
+void MainGameState::_prefetchNextLevel()
+{
+    if (_level >= 6 || _exitCells.empty()) return;
+    if (LevelPrefetcher::Get().isPending(_level + 1)) return;
+
+    auto playerView = _registry.view<const TransformComponent, PlayerInputComponent>();
+    if (!playerView) return;
+    const auto& trans = playerView.get<const TransformComponent>(*playerView.begin());
+    const int cellX = (int)(trans.position.x / _tile);
+    const int cellY = (int)(trans.position.y / _tile);
+
+    for (const IVec2& exit : _exitCells) {
+        if (std::abs(exit.x - cellX) + std::abs(exit.y - cellY) <= LEVEL_PREFETCH_DISTANCE_TILES) {
+            LevelPrefetcher::Get().prefetch(_level + 1);
+            return;
+        }
+    }
+}
+
 void MainGameState::_checkGameEndConditions()
 {
     auto playerView = _registry.view<TransformComponent, PlayerStatsComponent, PlayerInputComponent>();
@@ -169,7 +273,7 @@ void MainGameState::_checkGameEndConditions()
     int cellX = (int)(trans.position.x / _tile);
     int cellY = (int)(trans.position.y / _tile);
     if (cellX >= 0 && cellY >= 0 && cellX < _map.width() && cellY < _map.height()) {
-        if (_map.at(cellX, cellY) == 'X' && stats.keysCollected >= _totalKeysInMap) {
+        if (_map.cellType(cellX, cellY) == CellType::Exit && stats.keysCollected >= _totalKeysInMap) {
             bool gameFinished = (_level >= 6);
             this->state_machine->add_state(std::make_unique<GameOverState>(_level, false, levelTime_, gameFinished), true);
         }
@@ -189,36 +293,85 @@ void MainGameState::update(float deltaTime)
         }
     }
 
+    // Posiciones al empezar el tick: el render interpola desde aquí
+    SnapshotTransformSystem(_registry);
+
+    // Mapas por chunks: cargar lo que rodea al jugador antes de moverse
+    ChunkStreamingSystem(_registry, _map, _seed);
+
     // Primero Input (decide destino), luego Movimiento (mueve)
     InputSystem(_registry, _map);
     if (!_freezeEnemies) {
         EnemyAISystem(_registry, _map, deltaTime);
     }
-    MovementSystem(_registry, deltaTime);
+    MovementSystem(_registry, _map, deltaTime);
     AnimationSystem(_registry, deltaTime);
     SpikeSystem(_registry, deltaTime);
     InvulnerabilitySystem(_registry, deltaTime);
     CollisionSystem(_registry, _map); // Chequeo de colisiones
     MechanismSystem(_registry, _map);
 
+    // Checkpoint periódico: copia empaquetada del registry y del mapa
+    // (en mapas grandes solo el del inicio: la copia entera tarda demasiado para un tick)
+    _checkpointTimer += deltaTime;
+    const size_t cells = static_cast<size_t>(_map.width()) * static_cast<size_t>(_map.height());
+    if (_checkpointTimer >= CHECKPOINT_INTERVAL_S && cells <= CHECKPOINT_MAX_CELLS) saveCheckpoint();
+
+    _prefetchNextLevel();
     _checkGameEndConditions();
 }
 
+void MainGameState::_updateCamera(int viewW, int viewH)
+{
+    const float mapWpx = (float)(_map.width()  * _tile);
+    const float mapHpx = (float)(_map.height() * _tile);
+
+    // Foco: el jugador (o el centro del mapa si aún no existe)
+    Vector2 focus{ mapWpx / 2.0f, mapHpx / 2.0f };
+    auto playerView = _registry.view<const TransformComponent, PlayerInputComponent>();
+    if (playerView) {
+        auto player = *playerView.begin();
+        focus = InterpolatedPosition(_registry, player, playerView.get<const TransformComponent>(player), _renderAlpha);
+    }
+
+    // Por eje: si el mapa cabe se centra (como antes); si no, se sigue al jugador sin salir del mapa
+    auto follow = [](float f, float mapPx, float viewPx) {
+        if (mapPx <= viewPx) return mapPx / 2.0f;
+        return std::clamp(f, viewPx / 2.0f, mapPx - viewPx / 2.0f);
+    };
+
+    _camera.target   = { std::round(follow(focus.x, mapWpx, (float)viewW)),
+                         std::round(follow(focus.y, mapHpx, (float)viewH)) };
+    _camera.offset   = { std::round(viewW / 2.0f), std::round(viewH / 2.0f) };
+    _camera.rotation = 0.0f;
+    _camera.zoom     = 1.0f;
+}
+
 void MainGameState::_renderMap(){
     // Dimensiones
-    const int mapWpx = _map.width()  * _tile;
-    const int mapHpx = _map.height() * _tile;
     const int viewW  = GetScreenWidth();
     const int viewH  = GetScreenHeight() - HUD_HEIGHT; // Espacio disponible sin el HUD
 
-    // Offset centrado (clamp >= 0) - El mapa queda centrado en el espacio disponible
-    const int ox = (viewW > mapWpx) ? (viewW - mapWpx) / 2 : 0;
-    const int oy = (viewH > mapHpx) ? (viewH - mapHpx) / 2 : 0;
+    _updateCamera(viewW, viewH);
+
+    // Rectángulo visible en píxeles de mundo (+ margen): lo de fuera no se dibuja
+    const float margin = (float)(RENDER_CULL_MARGIN_TILES * _tile);
+    const Rectangle visible{
+        _camera.target.x - _camera.offset.x - margin,
+        _camera.target.y - _camera.offset.y - margin,
+        (float)viewW + 2.0f * margin,
+        (float)viewH + 2.0f * margin
+    };
+
+    // 1) Mapa y entidades en la zona superior (el HUD queda fuera del recorte)
+    BeginScissorMode(0, 0, viewW, viewH);
+    BeginMode2D(_camera);
 
-    // 1) Mapa (dibujado en la zona superior, desde y=0 hasta y=MAP_H_PX)
-    _map.render(ox, oy);
+    _map.render(0, 0, visible);
+    RenderSystem(_registry, 0.0f, 0.0f, (float)_map.tile(), &visible, _renderAlpha);
 
-    RenderSystem(_registry, (float)ox, (float)oy, (float)_map.tile());
+    EndMode2D();
+    EndScissorMode();
 }
 
 void MainGameState::_renderHUD(){
@@ -257,7 +410,7 @@ void MainGameState::_renderPlayerHUD(const Rectangle& bagHud, const Rectangle& l
 
     // Obtenemos la textura de iconos (Corazones y Llaves)
     auto& rm = ResourceManager::Get();
-    Texture2D iconsTex = rm.GetTexture("sprites/icons/Icons.png");
+    Texture2D iconsTex = rm.GetTexture(TEX_ICONS);
 
     // Buscamos la entidad que sea JUGADOR (tiene Stats y Input)
     auto view = _registry.view<PlayerStatsComponent, TransformComponent, PlayerInputComponent, PlayerCheatComponent, PlayerStateComponent>();
@@ -305,7 +458,7 @@ void MainGameState::_renderPlayerHUD(const Rectangle& bagHud, const Rectangle& l
         if (cx >= 0 && cx < _map.width() && cy >= 0 && cy < _map.height()) {
 
             // Si la casilla actual es la SALIDA ('X')
-            if (_map.at(cx, cy) == 'X') {
+            if (_map.cellType(cx, cy) == CellType::Exit) {
                 std::string msg;
                 Color msgColor;
 
@@ -347,6 +500,7 @@ void MainGameState::_renderTimerAndLevel()
 void MainGameState::render()
 {
     ClearBackground(RAYWHITE);
+    _map.prepareRender(); // Antes de cualquier recorte o cámara: dibuja en la capa horneada
     _renderMap();
     _renderHUD();
     _renderTimerAndLevel();
@@ -10,6 +10,7 @@
 #include "StateMachine.hpp"
 #include "ResourceManager.hpp"
 #include "ecs/Ecs.hpp"
+#include "ecs/LevelSnapshot.hpp"
 
 extern "C" {
   #include <raylib.h>
@@ -31,11 +32,25 @@ class MainGameState : public GameState
         void pause(){};
         void resume(){};
 
+        void setRenderAlpha(float alpha) override { _renderAlpha = alpha; }
+
+        // Semilla del nivel (aleatoria por defecto). Fijarla antes de init() hace
+        // que la partida se repita bit a bit con el mismo input.
+        void setSeed(uint64_t seed) { _seed = seed; }
+        uint64_t seed() const { return _seed; }
+
+        // Checkpoints en memoria (LevelSnapshot): se toma uno al empezar y otro
+        // cada CHECKPOINT_INTERVAL_S (solo hasta CHECKPOINT_MAX_CELLS celdas);
+        // F9 vuelve al último. No los hay en mapas por chunks.
+        void saveCheckpoint();
+        bool loadCheckpoint();
+
     private:
         // Mapa del juego
         Map _map;
         int _tile = 32;
         int _level = 1;
+        uint64_t _seed = 0;
 
         float levelTime_ = 60.0f;
 
@@ -45,12 +60,33 @@ class MainGameState : public GameState
         // ECS registry
         entt::registry _registry;
 
+        // Último checkpoint y tiempo de nivel que quedaba al tomarlo
+        LevelSnapshot _checkpoint;
+        float _checkpointLevelTime = 0.0f;
+        float _checkpointTimer = 0.0f;
+
+        // Cámara que sigue al jugador (si el mapa no cabe en la ventana)
+        Camera2D _camera{};
+
+        // Interpolación del render entre el tick de simulación anterior y el actual
+        float _renderAlpha = 1.0f;
+
         // ========== DEVELOPER MODE ==========
         bool _freezeEnemies = false;     // Enemigos congelados
         bool _infiniteTime = false;      // Tiempo infinito
         bool _keyGivenByCheating = false; // Track si la llave fue obtenida por cheat
 
+        // Celdas de salida del nivel (vacío en mapas por chunks)
+        std::vector<IVec2> _exitCells;
+
+        // Prepara el siguiente nivel (LevelPrefetcher) si el jugador está cerca de una salida
+        void _prefetchNextLevel();
+
+        // Crea la entidad del jugador si LevelSetupSystem no lo ha hecho
+        void _createPlayer();
+
         // Métodos privados para renderizado
+        void _updateCamera(int viewW, int viewH);
         void _renderMap();
         void _renderHUD();
         void _renderPlayerHUD(const Rectangle& bagHud, const Rectangle& livesHud, float baseY);
@@ -0,0 +1,87 @@
+#include "MappedFile.hpp"
+#include <fstream>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define MAPPED_FILE_POSIX 1
+#endif
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        _buffer = std::move(other._buffer);
+        _size = other._size;
+        _open = other._open;
+        _mapped = other._mapped;
+        _data = _mapped ? other._data : _buffer.data();
+        other._data = nullptr;
+        other._size = 0;
+        other._open = false;
+        other._mapped = false;
+    }
+    return *this;
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+
+#ifdef MAPPED_FILE_POSIX
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info{};
+    if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+
+    _size = static_cast<size_t>(info.st_size);
+    if (_size > 0) {
+        void* view = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (view == MAP_FAILED) {
+            ::close(fd);
+            _size = 0;
+            return false;
+        }
+        // Se lee de principio a fin: que el kernel adelante páginas
+        ::madvise(view, _size, MADV_SEQUENTIAL);
+        _data = static_cast<const char*>(view);
+        _mapped = true;
+    }
+    // La proyección sigue viva sin el descriptor
+    ::close(fd);
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) return false;
+    _buffer.resize(static_cast<size_t>(in.tellg()));
+    in.seekg(0);
+    if (!_buffer.empty() && !in.read(_buffer.data(), static_cast<std::streamsize>(_buffer.size()))) {
+        _buffer.clear();
+        return false;
+    }
+    _data = _buffer.data();
+    _size = _buffer.size();
+#endif
+
+    _open = true;
+    return true;
+}
+
+void MappedFile::close() {
+#ifdef MAPPED_FILE_POSIX
+    if (_mapped && _data) ::munmap(const_cast<char*>(_data), _size);
+#endif
+    _buffer.clear();
+    _data = nullptr;
+    _size = 0;
+    _open = false;
+    _mapped = false;
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * Archivo de solo lectura proyectado en memoria (mmap en POSIX).
+ *  - data()/size() dan acceso directo al contenido sin copiarlo a buffers propios.
+ *  - En sistemas sin mmap se lee el archivo entero en un buffer (misma interfaz).
+ *  - Un archivo vacío se abre bien: size() == 0 y data() puede ser nullptr.
+ *  - No copiable; se libera al destruirse.
+ */
+class MappedFile {
+    public:
+        MappedFile() = default;
+        explicit MappedFile(const std::string& path) { open(path); }
+        ~MappedFile() { close(); }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        /// Proyecta 'path'. @return false si no se puede abrir o leer.
+        bool open(const std::string& path);
+        void close();
+
+        bool isOpen() const { return _open; }
+        const char* data() const { return _data; }
+        size_t size() const { return _size; }
+
+    private:
+        const char* _data = nullptr;
+        size_t _size = 0;
+        bool _open = false;
+        bool _mapped = false;           // _data viene de mmap (si no, apunta a _buffer)
+        std::vector<char> _buffer;
+};
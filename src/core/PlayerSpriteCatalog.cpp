@@ -1,33 +1,20 @@
 #include "PlayerSpriteCatalog.hpp"
 #include "ResourceManager.hpp"
 #include <algorithm>
-#include <filesystem>
 #include <iostream>
 
 std::vector<PlayerSpriteSet> DiscoverPlayerSpriteSets(const std::string& baseRelativePath) {
     std::vector<PlayerSpriteSet> sets;
     auto& rm = ResourceManager::Get();
 
-    std::filesystem::path baseAbs = rm.GetAssetPath(baseRelativePath);
-    if (!std::filesystem::exists(baseAbs) || !std::filesystem::is_directory(baseAbs)) {
-        return sets;
-    }
-
-    for (const auto& entry : std::filesystem::directory_iterator(baseAbs)) {
-        if (!entry.is_directory()) {
-            continue;
-        }
-
-        std::string folderName = entry.path().filename().string();
-        std::filesystem::path idleAbs = entry.path() / "Idle.png";
-        std::filesystem::path walkAbs = entry.path() / "Walk.png";
-
+    // Subcarpetas y archivos salen del índice de assets: sin recorrer el disco
+    for (const std::string& folderName : rm.Assets().subdirectories(baseRelativePath)) {
         PlayerSpriteSet set;
         set.id = folderName;
         set.idlePath = baseRelativePath + "/" + folderName + "/Idle.png";
         set.walkPath = baseRelativePath + "/" + folderName + "/Walk.png";
-        set.hasIdle = std::filesystem::exists(idleAbs);
-        set.hasWalk = std::filesystem::exists(walkAbs);
+        set.hasIdle = rm.HasAsset(set.idlePath);
+        set.hasWalk = rm.HasAsset(set.walkPath);
 
         sets.push_back(set);
     }
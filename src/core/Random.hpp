@@ -0,0 +1,44 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * Aleatorio basado en contador, sin estado global.
+ *
+ * Cada número es una función pura de (key, counter): la misma clave y el mismo
+ * contador dan el mismo resultado en cualquier hilo y en cualquier orden de
+ * ejecución. Cada entidad lleva su propio flujo (key derivada de la semilla del
+ * nivel + id de la entidad), así que las decisiones se pueden repartir entre
+ * hilos sin locks y una partida se repite bit a bit con la misma semilla.
+ *
+ * La mezcla es la de SplitMix64 (la misma familia que usan PCG/xoshiro para
+ * sembrar): barata y con buena dispersión para contadores consecutivos.
+ */
+inline uint64_t MixBits(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+struct RandomStream {
+    uint64_t key = 0;
+    uint64_t counter = 0;
+
+    // Clave del flujo 'stream' (p.ej. id de entidad) dentro de la semilla 'seed'
+    static uint64_t KeyFor(uint64_t seed, uint64_t stream) {
+        return MixBits(seed ^ MixBits(stream));
+    }
+
+    uint64_t nextBits() {
+        return MixBits(key ^ MixBits(counter++));
+    }
+
+    // Entero uniforme en [min, max], ambos incluidos (mismo contrato que GetRandomValue)
+    int nextInt(int min, int max) {
+        if (min > max) { int t = min; min = max; max = t; }
+        const uint64_t range = (uint64_t)((int64_t)max - (int64_t)min) + 1;
+        // Multiplicación alta en lugar de módulo: sin sesgo apreciable y sin división
+        const uint64_t hi = ((nextBits() >> 32) * range) >> 32;
+        return (int)((int64_t)min + (int64_t)hi);
+    }
+};
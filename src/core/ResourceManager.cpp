@@ -1,4 +1,5 @@
 #include "ResourceManager.hpp"
+#include <chrono>
 #include <iostream>
 
 const std::string LOCAL_PATH = "./assets/";
@@ -17,28 +18,99 @@ ResourceManager& ResourceManager::Get() {
     return instance;
 }
 
-// encontrar la ruta completa de un asset dentro del proyecto o el sistema de ficheros
-// filename es un path relativo dentro de assets/, por ejemplo "sprites/player.png"
-std::string ResourceManager::GetAssetPath(const std::string& filename) {
+AssetIndex& ResourceManager::Assets() {
+    if (!_assetsIndexed) {
+        // Una pasada por raíz (o un único archivo si trae manifiesto) en vez de
+        // un stat por consulta
+        _assetsIndexed = true;
+        _assets.clear();
+        _pack.close();
+        for (const std::string& root : { LOCAL_PATH, INSTALL_PATH }) {
+            try {
+                // Los archivos sueltos de una raíz mandan sobre su paquete
+                _assets.addRoot(root);
+                const std::string packPath = root + AssetPack::PACK_NAME;
+                if (!_pack.isOpen() && std::filesystem::exists(packPath)) {
+                    _pack.open(packPath);
+                    for (size_t i = 0; i < _pack.count(); ++i) {
+                        const AssetPackEntry& entry = _pack.entry(i);
+                        const std::string name = _pack.name(i);
+                        _assets.add(name, AssetInfo{ root + name, entry.size, entry.width, entry.height, true });
+                    }
+                }
+            } catch (const std::exception& e) {
+                // Sin índice de esa raíz sus assets se siguen encontrando probando en disco
+                std::cerr << "[ERROR] " << e.what() << std::endl;
+            }
+        }
+    }
+    return _assets;
+}
+
+void ResourceManager::RescanAssets() {
+    // Las decodificaciones en curso pueden estar leyendo del paquete que se va a cerrar
+    while (!_pending.empty()) {
+        _finishPending(_pending.begin()->first);
+    }
+    _assetsIndexed = false;
+    Assets();
+}
+
+const AssetPack& ResourceManager::Pack() {
+    Assets();
+    return _pack;
+}
+
+const AssetPackEntry* ResourceManager::_findPacked(const std::string& filename) {
+    const AssetInfo* info = Assets().find(filename);
+    return (info && info->packed) ? _pack.find(filename) : nullptr;
+}
+
+Image ResourceManager::_decodePacked(const AssetPack& pack, const AssetPackEntry& entry, const std::string& filename) {
+    std::vector<unsigned char> scratch;
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+    if (!pack.read(entry, scratch, data, size)) return Image{};
 
-    //ruta local (modo desarrollo)
-    {
-        std::filesystem::path base = LOCAL_PATH;       // "assets/"
-        std::filesystem::path candidate = base / filename;
+    // raylib elige el decodificador por la extensión (".png")
+    const std::string type = std::filesystem::path(filename).extension().string();
+    return LoadImageFromMemory(type.c_str(), data, (int)size);
+}
 
+// Ruta en disco de un asset sin indexar: puede haberse añadido después de montar
+// el índice (o el manifiesto instalado está desfasado). Vacía si no está
+static std::string FindLooseAsset(const std::string& filename) {
+    for (const std::string& root : { LOCAL_PATH, INSTALL_PATH }) {
+        std::filesystem::path candidate = std::filesystem::path(root) / filename;
         if (std::filesystem::exists(candidate)) {
             return candidate.string();
         }
     }
+    return std::string();
+}
 
-    //ruta instalada del sistema (solo Linux)
-    {
-        std::filesystem::path base = INSTALL_PATH;
-        std::filesystem::path candidate = base / filename;
+bool ResourceManager::HasAsset(const std::string& filename) {
+    return Assets().contains(filename) || !FindLooseAsset(filename).empty();
+}
 
-        if (std::filesystem::exists(candidate)) {
-            return candidate.string();
+// encontrar la ruta completa de un asset dentro del proyecto o el sistema de ficheros
+// filename es un path relativo dentro de assets/, por ejemplo "sprites/player.png"
+std::string ResourceManager::GetAssetPath(const std::string& filename) {
+
+    if (const AssetInfo* info = Assets().find(filename)) {
+        // Solo está dentro de assets.pak: no hay archivo que abrir por ruta
+        if (info->packed) {
+            std::cerr << "[ERROR] Asset empaquetado en " << AssetPack::PACK_NAME
+                      << ", sin archivo suelto: " << filename << std::endl;
+            return std::string();
         }
+        return info->path;
+    }
+
+    // No indexado: se prueba en disco como antes
+    std::string loose = FindLooseAsset(filename);
+    if (!loose.empty()) {
+        return loose;
     }
 
     std::cerr << "[ERROR] Asset no encontrado: " << filename << std::endl;
@@ -51,30 +123,126 @@ const Texture2D& ResourceManager::GetTexture(const std::string& filename) {
     // 1. Revisar si ya está cacheada
     auto it = _textures.find(filename);
     if (it != _textures.end()) {
+        // Si estaba pedida en segundo plano solo queda esperar su decodificación
+        if (_pending.count(filename)) {
+            _finishPending(filename);
+        }
         return it->second;
     }
 
-    // 2. Resolver ruta final del archivo
-    std::string path = GetAssetPath(filename);
-
-    // 3. Cargar textura desde disco
-    Texture2D tex = LoadTexture(path.c_str());
+    // 2. Cargar textura desde el paquete (sin abrir archivos) o desde disco
+    Texture2D tex{};
+    std::string path;
+    if (const AssetPackEntry* packed = _findPacked(filename)) {
+        path = std::string(AssetPack::PACK_NAME) + ":" + filename;
+        Image image = _decodePacked(_pack, *packed, filename);
+        if (image.data != nullptr) {
+            tex = LoadTextureFromImage(image);
+            UnloadImage(image);
+        }
+    } else {
+        path = GetAssetPath(filename);
+        tex = LoadTexture(path.c_str());
+    }
 
     // Comprobación de error mínima
     if (tex.id == 0) {
         std::cerr << "[ERROR] Fallo al cargar textura desde: " << path << std::endl;
     }
 
-    // 4. Guardar en caché
+    // 3. Guardar en caché
     _textures[filename] = tex;
     std::cout << "Textura cargada: " << path << std::endl;
     
-    // 5. Devolver referencia a la textura cacheada
+    // 4. Devolver referencia a la textura cacheada
     return _textures[filename];
 }
 
+// pide la textura sin bloquear: LoadImage (CPU) en otro hilo, subida en el principal
+const Texture2D& ResourceManager::RequestTexture(const std::string& filename) {
+
+    auto it = _textures.find(filename);
+    if (it != _textures.end()) {
+        return it->second;
+    }
+
+    if (const AssetPackEntry* packed = _findPacked(filename)) {
+        // El paquete sigue abierto mientras haya decodificaciones pendientes (RescanAssets las espera)
+        const AssetPack* pack = &_pack;
+        _pending[filename] = std::async(std::launch::async, [pack, packed, filename]() {
+            return _decodePacked(*pack, *packed, filename);
+        });
+    } else {
+        // La ruta se resuelve aquí para no tocar el sistema de ficheros desde el hilo
+        const std::string path = GetAssetPath(filename);
+        _pending[filename] = std::async(std::launch::async, [path]() {
+            return LoadImage(path.c_str());
+        });
+    }
+
+    // Placeholder: id 0 hace que raylib ignore los dibujos hasta la subida
+    return _textures[filename] = Texture2D{};
+}
+
+bool ResourceManager::IsTextureReady(const std::string& filename) const {
+    return _textures.count(filename) && !_pending.count(filename);
+}
+
+size_t ResourceManager::ProcessPendingUploads(float budgetSeconds) {
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    bool uploaded = false;
+
+    for (auto it = _pending.begin(); it != _pending.end(); ) {
+        if (uploaded) {
+            std::chrono::duration<float> elapsed = Clock::now() - start;
+            if (elapsed.count() >= budgetSeconds) break;
+        }
+        // Solo las que ya terminó el hilo: aquí no se espera nunca
+        if (it->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ++it;
+            continue;
+        }
+        _upload(it->first, it->second.get());
+        it = _pending.erase(it);
+        uploaded = true;
+    }
+
+    return _pending.size();
+}
+
+void ResourceManager::_finishPending(const std::string& filename) {
+    auto it = _pending.find(filename);
+    if (it == _pending.end()) return;
+    _upload(filename, it->second.get());
+    _pending.erase(it);
+}
+
+void ResourceManager::_upload(const std::string& filename, Image image) {
+    Texture2D tex{};
+    if (image.data != nullptr) {
+        tex = LoadTextureFromImage(image);
+        UnloadImage(image);
+    }
+
+    if (tex.id == 0) {
+        std::cerr << "[ERROR] Fallo al cargar textura en segundo plano: " << filename << std::endl;
+    }
+
+    _textures[filename] = tex;
+    std::cout << "Textura cargada (async): " << filename << std::endl;
+}
+
 void ResourceManager::UnloadTexture(const std::string& filename) {
 
+    // Una decodificación en curso no se puede cancelar: se espera y se descarta
+    auto pending = _pending.find(filename);
+    if (pending != _pending.end()) {
+        Image image = pending->second.get();
+        if (image.data != nullptr) UnloadImage(image);
+        _pending.erase(pending);
+    }
+
     auto it = _textures.find(filename);
     if (it != _textures.end()) {
         // Liberar la textura de la GPU
@@ -87,6 +255,13 @@ void ResourceManager::UnloadTexture(const std::string& filename) {
 
 void ResourceManager::UnloadAll() {
 
+    // Descartar las decodificaciones en curso antes de tocar la caché
+    for (auto& p : _pending) {
+        Image image = p.second.get();
+        if (image.data != nullptr) UnloadImage(image);
+    }
+    _pending.clear();
+
     // Liberar todas las texturas sin borrar en mitad del bucle
     for (auto& t : _textures) {
         ::UnloadTexture(t.second);
@@ -3,6 +3,9 @@
 #include <string>
 #include <unordered_map>
 #include <filesystem>
+#include <future>
+#include "AssetIndex.hpp"
+#include "AssetPack.hpp"
 
 class ResourceManager {
 public:
@@ -12,6 +15,20 @@ public:
     // Devuelve una textura, la carga desde el disco o cache si ya estaba cargada.
     const Texture2D& GetTexture(const std::string& filename);
 
+    // Pide una textura sin bloquear: el PNG se decodifica en un hilo aparte y la
+    // subida a GPU se hace después en ProcessPendingUploads. Devuelve la entrada de
+    // la caché, que vale como placeholder (id 0, no se dibuja) hasta que esté lista;
+    // la referencia es estable y se rellena en el sitio al terminar la subida.
+    const Texture2D& RequestTexture(const std::string& filename);
+
+    // true si la textura ya está en GPU (cargada o subida tras RequestTexture)
+    bool IsTextureReady(const std::string& filename) const;
+
+    // Sube a GPU las imágenes ya decodificadas sin pasar de budgetSeconds por frame.
+    // Se llama desde el hilo principal (contexto OpenGL); siempre sube al menos una.
+    // Devuelve cuántas texturas quedan pendientes.
+    size_t ProcessPendingUploads(float budgetSeconds);
+
     // Libera una textura concreta del gestor
     void UnloadTexture(const std::string& filename);
 
@@ -19,8 +36,25 @@ public:
     void UnloadAll();
 
     // encontrar la ruta completa de un asset dentro del proyecto o el sistema de ficheros
+    // (consulta el índice de assets; solo si no está se prueba en disco).
+    // Solo para archivos sueltos: si el asset únicamente está en assets.pak devuelve
+    // una cadena vacía (las texturas se leen del paquete con GetTexture/RequestTexture;
+    // otros datos, con Pack()).
     std::string GetAssetPath(const std::string& filename);
 
+    // true si el asset está en el índice; si no, se comprueba en disco como en GetAssetPath
+    bool HasAsset(const std::string& filename);
+
+    // Índice de assets (ruta, tamaño y dimensiones); se monta en la primera consulta
+    AssetIndex& Assets();
+
+    // Vuelve a montar el índice (p.ej. tras añadir assets con el juego abierto)
+    // y reabre el paquete de assets; espera antes a las decodificaciones en curso
+    void RescanAssets();
+
+    // Paquete de assets proyectado en memoria (abierto si alguna raíz trae assets.pak)
+    const AssetPack& Pack();
+
 private:
     ResourceManager() = default;
     ~ResourceManager() = default;
@@ -28,7 +62,28 @@ private:
     ResourceManager(const ResourceManager&) = delete;
     ResourceManager& operator=(const ResourceManager&) = delete;
 
+    // Espera la decodificación pendiente de filename y la sube a GPU
+    void _finishPending(const std::string& filename);
+
+    // Sube una imagen decodificada a su entrada de la caché y libera la imagen
+    void _upload(const std::string& filename, Image image);
+
+    // Entrada del paquete si el índice resuelve filename a assets.pak (nullptr si es suelto)
+    const AssetPackEntry* _findPacked(const std::string& filename);
+
+    // Decodifica una imagen del paquete directamente desde la proyección (sin
+    // copiarla salvo que esté comprimida). Sin GPU: vale desde cualquier hilo.
+    static Image _decodePacked(const AssetPack& pack, const AssetPackEntry& entry, const std::string& filename);
+
 private:
+    //índice nombre lógico → ruta resuelta (raíz local antes que la instalada)
+    AssetIndex _assets;
+    bool _assetsIndexed = false;
+    //paquete de la primera raíz que lo trae; sus entradas están en _assets como 'packed'
+    AssetPack _pack;
+
     //cache texturas
     std::unordered_map<std::string, Texture2D> _textures;
+    //decodificaciones en curso (la entrada de _textures es el placeholder)
+    std::unordered_map<std::string, std::future<Image>> _pending;
 };
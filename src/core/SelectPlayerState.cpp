@@ -11,6 +11,7 @@
 #include "ecs/components/World/MovementComponent.hpp"
 #include "ecs/components/World/SpriteComponent.hpp"
 #include "ecs/components/World/TransformComponent.hpp"
+#include "ecs/systems/LevelSetupSystem.hpp"
 #include "ecs/systems/RenderSystems.hpp"
 #include "ecs/systems/WorldSystems.hpp"
 #include <algorithm>
@@ -34,6 +35,14 @@ void SelectPlayerState::init() {
     previewTileSize_ = (float)TILE_SIZE;
     previewPos_ = { WINDOW_WIDTH - 220.0f, 360.0f };
 
+    // Decodificar todos los sets en segundo plano: cambiar de selección no bloquea
+    auto& rm = ResourceManager::Get();
+    for (const auto& set : sets_) {
+        if (!set.hasIdle || !set.hasWalk) continue;
+        rm.RequestTexture(set.idlePath);
+        rm.RequestTexture(set.walkPath);
+    }
+
     if (!defaultId_.empty()) {
         auto it = std::find_if(sets_.begin(), sets_.end(),
                                [&](const PlayerSpriteSet& set) { return set.id == defaultId_; });
@@ -91,6 +100,7 @@ void SelectPlayerState::handleInput() {
             PlayerSelection::SetSelectedSpriteSet(resolved->id, resolved->idlePath, resolved->walkPath,
                                                  resolved->hasIdle, resolved->hasWalk);
         }
+        RequestLevelTextures();
         this->state_machine->add_state(std::make_unique<MainGameState>(), true);
         return;
     }
@@ -103,6 +113,11 @@ void SelectPlayerState::update(float deltaTime) {
     previewHasFocus_ = false;
     previewIdleHold_ = std::max(0.0f, previewIdleHold_ - deltaTime);
 
+    // Montar el preview en cuanto las texturas del set terminen de subirse
+    if (previewPending_ && !sets_.empty()) {
+        UpdatePreviewForSet(sets_[selectedIndex_]);
+    }
+
     previewTimer_ += deltaTime;
     bool wantsWalk = previewIdleHold_ <= 0.0f && std::fmod(previewTimer_, 2.0f) >= 1.0f;
 
@@ -204,9 +219,19 @@ void SelectPlayerState::UpdatePreviewForSet(const PlayerSpriteSet& set) {
     if (previewId_ == validSet.id && previewEntity_ != entt::null && previewRegistry_.valid(previewEntity_)) {
         return;
     }
-    previewId_ = validSet.id;
 
+    // Sin las texturas en GPU se mantiene el preview anterior: los frames
+    // dependen del ancho real y el placeholder no lo tiene.
     auto& rm = ResourceManager::Get();
+    if (!rm.IsTextureReady(validSet.idlePath) || !rm.IsTextureReady(validSet.walkPath)) {
+        rm.RequestTexture(validSet.idlePath);
+        rm.RequestTexture(validSet.walkPath);
+        previewPending_ = true;
+        return;
+    }
+    previewPending_ = false;
+    previewId_ = validSet.id;
+
     const Texture2D& idleTex = rm.GetTexture(validSet.idlePath);
     const Texture2D& walkTex = rm.GetTexture(validSet.walkPath);
 
@@ -35,6 +35,8 @@ private:
     Vector2 previewPos_{0.0f, 0.0f};
     float previewIdleHold_ = 0.0f;
     bool previewHasFocus_ = false;
+    // El set seleccionado aún se está cargando en segundo plano
+    bool previewPending_ = false;
 
     void UpdatePreviewForSet(const PlayerSpriteSet& set);
     const PlayerSpriteSet* ResolveValidSet(const PlayerSpriteSet& set) const;
@@ -21,6 +21,9 @@ class StateMachine
         bool isRunning() {return this->_is_running;}
 
         bool is_game_ending() {return this->_is_ending;}
+
+        // Hay un cambio de estado pedido que se aplicará en handle_state_changes
+        bool has_pending_change() const {return this->_is_Adding || this->_is_removing;}
         void set_game_ending(bool value) {this->_is_ending = value;}
 
         std::unique_ptr<GameState>& getCurrentState() {return this->_states_machine.top();}
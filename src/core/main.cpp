@@ -2,9 +2,10 @@
 #include "GameState.hpp"
 #include "StateMachine.hpp"
 #include "StartGameState.hpp"
+#include <algorithm>
 #include <memory>
 #include <chrono>
-#include "objects/Map.hpp" // Para medir el mapa antes
+#include "LevelPrefetcher.hpp" // Para medir el mapa antes (LevelMapSize)
 #include "Config.hpp" // Archivo de configuración global (TILE_SIZE, HUD_HEIGHT)
 #include "ResourceManager.hpp"
 #include "Localization.hpp"
@@ -18,18 +19,22 @@ int main() {
   InitLocalization("es");
 
   // 0) Medir el tamaño del mapa y preparar la ventana acorde
-  Map tmp;
+  //    Solo se lee la cabecera (o las filas del texto): el nivel se carga en MainGameState
   auto& rm = ResourceManager::Get();
   int level_ = 6; // Define the level number or get it from user input or configuration
-  std::string relativePath = "maps/map_" + std::to_string(level_) + ".txt";
-  tmp.loadFromFile(rm.GetAssetPath(relativePath), TILE_SIZE);
+  int mapW = 0;
+  int mapH = 0;
+  if (!LevelMapSize(LevelMapPath(level_), mapW, mapH)) {
+    mapH = (WINDOW_HEIGHT - HUD_HEIGHT) / TILE_SIZE;
+  }
 
-  const int MAP_W_PX = tmp.width() * TILE_SIZE;
-  const int MAP_H_PX = tmp.height() * TILE_SIZE;
+  const int MAP_H_PX = mapH * TILE_SIZE;
 
   // 1) Crear ventana con altura extra para el HUD inferior y fijar FPS
-  int winW = std::max(MAP_W_PX, WINDOW_WIDTH);
-  int winH = MAP_H_PX + HUD_HEIGHT;
+  //    El tamaño se acota a WINDOW_WIDTH x WINDOW_HEIGHT: los mapas más grandes
+  //    se recorren con la cámara de MainGameState.
+  int winW = WINDOW_WIDTH;
+  int winH = std::min(MAP_H_PX, WINDOW_HEIGHT - HUD_HEIGHT) + HUD_HEIGHT;
   InitWindow(winW, winH, "Escape del Laberinto");
   SetTargetFPS(60);
 
@@ -43,6 +48,9 @@ int main() {
   state_machine.handle_state_changes(delta_time);
 
   // 3) Bucle principal (hasta que se cierre la ventana o termine el juego)
+  //    La simulación avanza en ticks fijos de SIM_TICK_DT con un acumulador: el
+  //    gameplay no depende de los FPS y el render interpola entre los dos últimos ticks.
+  float accumulator = 0.0f;
 
   while (!WindowShouldClose() && !state_machine.is_game_ending()) {
     delta_time = GetFrameTime();
@@ -52,15 +60,36 @@ int main() {
       SwitchLocalization();
     }
 
-    state_machine.handle_state_changes(delta_time);
+    // Un cambio de estado reinicia el acumulador (handle_state_changes lo pone a 0)
+    state_machine.handle_state_changes(accumulator);
+
+    // Subir a GPU las texturas pedidas en segundo plano sin comerse el frame
+    rm.ProcessPendingUploads(TEXTURE_UPLOAD_BUDGET_S);
 
     // Si hay overlay, solo procesar input del overlay
     if (state_machine.hasOverlay()) {
       state_machine.getOverlayState()->handleInput();
       // NO actualizar el juego si hay overlay (pausa)
+      accumulator = 0.0f;
     } else {
-      state_machine.getCurrentState()->handleInput();
-      state_machine.getCurrentState()->update(delta_time);
+      auto& state = state_machine.getCurrentState();
+      // El input por pulsación (IsKeyPressed) se lee una vez por frame
+      state->handleInput();
+
+      accumulator += delta_time;
+      int ticks = 0;
+      while (accumulator >= SIM_TICK_DT && ticks < MAX_SIM_TICKS_PER_FRAME) {
+        state->update(SIM_TICK_DT);
+        accumulator -= SIM_TICK_DT;
+        ++ticks;
+        // El estado ha pedido salir: no seguir simulándolo este frame
+        if (state_machine.has_pending_change()) break;
+      }
+      // Tras un parón largo se descarta el tiempo que no cabe en el tope de ticks
+      if (ticks == MAX_SIM_TICKS_PER_FRAME) {
+        accumulator = std::min(accumulator, SIM_TICK_DT);
+      }
+      state->setRenderAlpha(std::min(accumulator / SIM_TICK_DT, 1.0f));
     }
 
     // Renderizar: BeginDrawing una sola vez
@@ -0,0 +1,17 @@
+#pragma once
+#include <vector>
+#include <entt/entt.hpp>
+
+// Evento: una entidad ha entrado en una nueva celda del mapa.
+// Lo emite MovementSystem cuando el centro de la entidad cruza el borde de un tile.
+struct CellEnteredEvent {
+    entt::entity entity;
+    int cellX;
+    int cellY;
+};
+
+// Cola de eventos de celda del frame actual (vive en registry.ctx()).
+// La consume y vacía MechanismSystem al final de la actualización.
+struct CellEventQueue {
+    std::vector<CellEnteredEvent> entered;
+};
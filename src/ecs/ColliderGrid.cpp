@@ -0,0 +1,90 @@
+#include "ecs/ColliderGrid.hpp"
+#include "objects/Map.hpp"
+#include "ecs/components/World/TransformComponent.hpp"
+#include "ecs/components/World/ColliderComponent.hpp"
+#include "ecs/components/World/ColliderCellComponent.hpp"
+#include "ecs/components/Player/PlayerInputComponent.hpp"
+#include <algorithm>
+#include <cmath>
+
+void ColliderGrid::reset(int w, int h, float tile, bool sparse) {
+    _w = w > 0 ? w : 1;
+    _h = h > 0 ? h : 1;
+    _tile = tile > 0.0f ? tile : 1.0f;
+    _sparse = sparse;
+
+    _sparseBuckets.clear();
+    if (_sparse) _buckets.clear();
+    else _buckets.assign(static_cast<size_t>(_w) * static_cast<size_t>(_h), {});
+}
+
+int ColliderGrid::cellOf(Vector2 pos) const {
+    int cx = (int)std::floor(pos.x / _tile);
+    int cy = (int)std::floor(pos.y / _tile);
+    cx = std::clamp(cx, 0, _w - 1);
+    cy = std::clamp(cy, 0, _h - 1);
+    return cy * _w + cx;
+}
+
+const std::vector<entt::entity>& ColliderGrid::bucket(int cell) const {
+    if (!_sparse) return _buckets[cell];
+
+    static const std::vector<entt::entity> empty;
+    auto it = _sparseBuckets.find(cell);
+    return it != _sparseBuckets.end() ? it->second : empty;
+}
+
+void ColliderGrid::insert(entt::entity entity, int cell) {
+    if (_sparse) _sparseBuckets[cell].push_back(entity);
+    else _buckets[cell].push_back(entity);
+}
+
+void ColliderGrid::remove(entt::entity entity, int cell) {
+    std::vector<entt::entity>* b = nullptr;
+    if (_sparse) {
+        auto found = _sparseBuckets.find(cell);
+        if (found == _sparseBuckets.end()) return;
+        b = &found->second;
+    } else {
+        b = &_buckets[cell];
+    }
+
+    auto it = std::find(b->begin(), b->end(), entity);
+    if (it != b->end()) {
+        // El orden dentro del cubo no importa: swap-and-pop
+        *it = b->back();
+        b->pop_back();
+    }
+    // Disperso: los cubos vacíos no ocupan memoria
+    if (_sparse && b->empty()) _sparseBuckets.erase(cell);
+}
+
+void ColliderGrid::queryNeighborhood(Vector2 pos, std::vector<entt::entity>& out) const {
+    out.clear();
+    if (_buckets.empty() && !_sparse) return;
+
+    const int center = cellOf(pos);
+    const int cx = center % _w;
+    const int cy = center / _w;
+
+    for (int y = std::max(cy - 1, 0); y <= std::min(cy + 1, _h - 1); ++y) {
+        for (int x = std::max(cx - 1, 0); x <= std::min(cx + 1, _w - 1); ++x) {
+            const auto &b = bucket(y * _w + x);
+            out.insert(out.end(), b.begin(), b.end());
+        }
+    }
+}
+
+ColliderGrid& BuildColliderGrid(entt::registry& registry, const Map& map) {
+    auto &grid = registry.ctx().insert_or_assign(ColliderGrid{});
+    grid.reset(map.width(), map.height(), (float)map.tile(), map.isChunked());
+
+    auto view = registry.view<const TransformComponent, const ColliderComponent>(entt::exclude<PlayerInputComponent>);
+    for (auto entity : view) {
+        const auto &tr = view.get<const TransformComponent>(entity);
+        int cell = grid.cellOf(tr.position);
+        grid.insert(entity, cell);
+        registry.emplace_or_replace<ColliderCellComponent>(entity, cell);
+    }
+    return grid;
+}
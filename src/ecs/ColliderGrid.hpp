@@ -0,0 +1,60 @@
+#pragma once
+#include <unordered_map>
+#include <vector>
+#include <entt/entt.hpp>
+extern "C" {
+  #include <raylib.h>
+}
+
+class Map;
+
+/**
+ * Clase ColliderGrid
+ *  - Broadphase de colisiones: un cubo (bucket) de entidades por tile del mapa.
+ *  - Las entidades con ColliderComponent se insertan al montar el nivel y solo se
+ *    reubican cuando MovementSystem las lleva a otro tile.
+ *  - CollisionSystem consulta únicamente el tile del jugador y sus 8 vecinos.
+ *  - En mapas por chunks los cubos van en una tabla hash (solo los no vacíos):
+ *    un cubo por tile de un mapa enorme no cabría en memoria.
+ *  - Se guarda en el contexto del registry (registry.ctx()).
+ */
+class ColliderGrid {
+    public:
+        /// Reinicia la rejilla para un mapa de w x h tiles de tamaño 'tile' píxeles.
+        /// 'sparse': cubos en tabla hash en vez de un vector por tile.
+        void reset(int w, int h, float tile, bool sparse = false);
+
+        /// Celda (índice lineal) que contiene la posición; se acota a los límites del mapa.
+        int cellOf(Vector2 pos) const;
+
+        void insert(entt::entity entity, int cell);
+        void remove(entt::entity entity, int cell);
+
+        /**
+         * Recorre las entidades de la celda de 'pos' y de sus 8 vecinas.
+         * @param out Se vacía y se rellena con las entidades encontradas.
+         */
+        void queryNeighborhood(Vector2 pos, std::vector<entt::entity>& out) const;
+
+        /// Entidades registradas en una celda concreta.
+        const std::vector<entt::entity>& bucket(int cell) const;
+
+    private:
+        int _w = 0, _h = 0;
+        float _tile = 32.0f;
+
+        // Un vector de entidades por tile, fila a fila (mismo índice que Map::cells()).
+        std::vector<std::vector<entt::entity>> _buckets;
+
+        // Modo disperso: solo los cubos con entidades, por índice de celda.
+        bool _sparse = false;
+        std::unordered_map<int, std::vector<entt::entity>> _sparseBuckets;
+};
+
+/**
+ * Construye el ColliderGrid del registry a partir de todas las entidades con
+ * TransformComponent + ColliderComponent (salvo el jugador) y les añade
+ * ColliderCellComponent. Sustituye cualquier rejilla anterior.
+ * Disperso si el mapa es por chunks.
+ */
+ColliderGrid& BuildColliderGrid(entt::registry& registry, const Map& map);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <entt/entt.hpp>
 #include "ecs/Ecstypes.hpp"
 
 /**
@@ -8,12 +9,16 @@
 
 // Componentes de World
 #include "ecs/components/World/AnimationComponent.hpp"
+#include "ecs/components/World/ChunkMemberComponent.hpp"
 #include "ecs/components/World/ColliderComponent.hpp"
+#include "ecs/components/World/ColliderCellComponent.hpp"
 #include "ecs/components/World/GridClipComponent.hpp"
 #include "ecs/components/World/ItemComponent.hpp"
 #include "ecs/components/World/ManualSpriteComponent.hpp"
 #include "ecs/components/World/MechanismComponent.hpp"
 #include "ecs/components/World/MovementComponent.hpp"
+#include "ecs/components/World/PreviousTransformComponent.hpp"
+#include "ecs/components/World/RandomStreamComponent.hpp"
 #include "ecs/components/World/SpikeComponent.hpp"
 #include "ecs/components/World/SpriteComponent.hpp"
 #include "ecs/components/World/TransformComponent.hpp"
@@ -25,7 +30,39 @@
 #include "ecs/components/Player/PlayerStatsComponent.hpp"
 
 // Componentes de Enemy
+#include "ecs/components/Enemy/EnemyAIScheduleComponent.hpp"
 #include "ecs/components/Enemy/EnemyIAComponent.hpp"
+#include "ecs/components/Enemy/EnemyPathComponent.hpp"
+
+/**
+ * Todos los componentes de partida, en el orden en que LevelSnapshot guarda sus
+ * pools. Un componente nuevo se añade aquí junto a su #include: capturar un
+ * registry con un pool que no esté en la lista lanza std::logic_error.
+ */
+using GameComponents = entt::type_list<
+    TransformComponent,
+    PreviousTransformComponent,
+    MovementComponent,
+    ColliderComponent,
+    ColliderCellComponent,
+    ChunkMemberComponent,
+    SpriteComponent,
+    AnimationComponent,
+    GridClipComponent,
+    ManualSpriteComponent,
+    ItemComponent,
+    SpikeComponent,
+    MechanismComponent,
+    MechanismTriggerComponent,
+    MechanismTargetComponent,
+    RandomStreamComponent,
+    PlayerStatsComponent,
+    PlayerStateComponent,
+    PlayerCheatComponent,
+    PlayerInputComponent,
+    EnemyAIComponent,
+    EnemyPathComponent,
+    EnemyAIScheduleComponent>;
 
 #include "ecs/systems/PlayerSystems.hpp"
 #include "ecs/systems/EnemySystems.hpp"
@@ -0,0 +1,203 @@
+#include "LevelSnapshot.hpp"
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include "core/BinaryIO.hpp"
+#include "core/Random.hpp"
+#include "ecs/Ecs.hpp"
+#include "ecs/ColliderGrid.hpp"
+#include "ecs/MechanismIndex.hpp"
+#include "objects/Map.hpp"
+
+namespace {
+    // Adaptadores de ByteWriter/ByteReader al formato de archivo de entt::snapshot
+    struct OutArchive {
+        ByteWriter& out;
+        template <typename T>
+        void operator()(const T& value) { out.pod(value); }
+    };
+
+    struct InArchive {
+        ByteReader& in;
+        template <typename T>
+        void operator()(T& value) { value = in.pod<T>(); }
+    };
+
+    // Componentes con datos dinámicos: se empaquetan campo a campo
+    void WriteComponent(ByteWriter& out, const EnemyPathComponent& path) {
+        out.array(path.waypoints);
+        out.pod(static_cast<uint32_t>(path.next));
+        out.pod(path.goal);
+        out.pod(path.revision);
+    }
+
+    template <typename T>
+    void WriteComponent(ByteWriter& out, const T& component) {
+        out.pod(component);
+    }
+
+    template <typename T>
+    T ReadComponent(ByteReader& in) {
+        return in.pod<T>();
+    }
+
+    template <>
+    EnemyPathComponent ReadComponent<EnemyPathComponent>(ByteReader& in) {
+        EnemyPathComponent path;
+        in.array(path.waypoints);
+        path.next = in.pod<uint32_t>();
+        path.goal = in.pod<IVec2>();
+        path.revision = in.pod<unsigned>();
+        return path;
+    }
+
+    /**
+     * Pool de T en orden empaquetado: [n] y n x [entidad][bytes de T].
+     * Al volver a emplazar en ese orden el pool restaurado itera igual que el original.
+     */
+    template <typename T>
+    void WritePool(ByteWriter& out, const entt::registry& registry) {
+        const auto* storage = registry.storage<T>();
+        const uint32_t count = storage ? static_cast<uint32_t>(storage->size()) : 0u;
+        out.pod(count);
+        if (!count) return;
+
+        const entt::sparse_set& base = *storage;
+        for (auto it = base.rbegin(); it != base.rend(); ++it) {
+            out.pod(*it);
+            if constexpr (!std::is_empty_v<T>) WriteComponent(out, storage->get(*it));
+        }
+    }
+
+    template <typename T>
+    void ReadPool(ByteReader& in, entt::registry& registry) {
+        const uint32_t count = in.pod<uint32_t>();
+        if (!count) return;
+
+        auto& storage = registry.storage<T>();
+        storage.reserve(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            const auto entity = in.pod<entt::entity>();
+            if (!registry.valid(entity)) throw std::runtime_error("Snapshot references a missing entity");
+            if constexpr (std::is_empty_v<T>) {
+                storage.emplace(entity);
+            } else {
+                storage.emplace(entity, ReadComponent<T>(in));
+            }
+        }
+    }
+
+    struct TypeCollector {
+        std::unordered_set<entt::id_type>& ids;
+        template <typename T>
+        void operator()() { ids.insert(entt::type_hash<T>::value()); }
+    };
+
+    // Un pool por componente de GameComponents (Ecs.hpp), en su orden
+    template <typename Func, typename... T>
+    void ForEachPool(Func&& func, entt::type_list<T...>) {
+        (func.template operator()<T>(), ...);
+    }
+
+    template <typename Func>
+    void ForEachPool(Func&& func) {
+        ForEachPool(func, GameComponents{});
+    }
+
+    // Un pool con entidades que no está en GameComponents se perdería al restaurar
+    void CheckPoolsCovered(const entt::registry& registry) {
+        std::unordered_set<entt::id_type> known;
+        ForEachPool(TypeCollector{ known });
+        for (auto [id, storage] : registry.storage()) {
+            if (!storage.empty() && !known.count(storage.type().hash())) {
+                throw std::logic_error("Component missing from GameComponents: " +
+                                       std::string(storage.type().name()));
+            }
+        }
+    }
+
+    struct PoolWriter {
+        ByteWriter& out;
+        const entt::registry& registry;
+        template <typename T>
+        void operator()() { WritePool<T>(out, registry); }
+    };
+
+    struct PoolReader {
+        ByteReader& in;
+        entt::registry& registry;
+        template <typename T>
+        void operator()() { ReadPool<T>(in, registry); }
+    };
+}
+
+/**
+ * capture
+ *  - Formato: estado del mapa (Map::saveState), entidades (formato de
+ *    entt::snapshot, con lista libre) y un pool por componente.
+ *  - Las cachés del contexto solo se copian si corresponden a la revisión actual.
+ */
+void LevelSnapshot::capture(const entt::registry& registry, const Map& map) {
+    CheckPoolsCovered(registry);
+    _data.clear();
+    ByteWriter out(_data);
+
+    map.saveState(out);
+
+    OutArchive archive{ out };
+    entt::snapshot{ registry }.get<entt::entity>(archive);
+    ForEachPool(PoolWriter{ out, registry });
+
+    const auto* oracle = registry.ctx().find<DistanceOracle>();
+    _oracle = (oracle && !oracle->isStale(map)) ? std::make_shared<const DistanceOracle>(*oracle) : nullptr;
+
+    const auto* nav = registry.ctx().find<NavHierarchy>();
+    _nav = (nav && !nav->isStale(map)) ? std::make_shared<const NavHierarchy>(*nav) : nullptr;
+
+    const auto* scheduler = registry.ctx().find<EnemyAIScheduler>();
+    _scheduler = scheduler ? std::make_shared<const EnemyAIScheduler>(*scheduler) : nullptr;
+}
+
+/**
+ * restore
+ *  - El registry se sustituye por uno vacío (entt::snapshot_loader lo exige y así
+ *    no quedan cachés del contexto de la partida anterior).
+ *  - Índices derivados de los componentes (ColliderGrid, MechanismIndex) se
+ *    reconstruyen; son lineales en el número de entidades.
+ */
+void LevelSnapshot::restore(entt::registry& registry, Map& map) const {
+    if (_data.empty()) throw std::runtime_error("Empty level snapshot");
+
+    ByteReader in(_data.data(), _data.size());
+    map.restoreState(in);
+
+    registry = entt::registry{};
+    InArchive archive{ in };
+    entt::snapshot_loader{ registry }.get<entt::entity>(archive);
+    ForEachPool(PoolReader{ in, registry });
+    if (!in.atEnd()) throw std::runtime_error("Trailing data in level snapshot");
+
+    BuildColliderGrid(registry, map);
+    BuildMechanismIndex(registry, map);
+
+    // Misma navegación que al capturar: las tablas copiadas siguen valiendo
+    if (_oracle) registry.ctx().insert_or_assign(DistanceOracle{ *_oracle }).adopt(map);
+    if (_nav) registry.ctx().insert_or_assign(NavHierarchy{ *_nav }).adopt(map);
+    if (_scheduler) registry.ctx().insert_or_assign(EnemyAIScheduler{ *_scheduler });
+}
+
+void LevelSnapshot::clear() {
+    _data.clear();
+    _data.shrink_to_fit();
+    _oracle.reset();
+    _nav.reset();
+    _scheduler.reset();
+}
+
+void ReseedRandomStreams(entt::registry& registry, uint64_t seed) {
+    auto view = registry.view<RandomStreamComponent>();
+    for (auto entity : view) {
+        view.get<RandomStreamComponent>(entity).rng =
+            RandomStream{ RandomStream::KeyFor(seed, (uint64_t)entt::to_integral(entity)), 0 };
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <entt/entt.hpp>
+#include "objects/DistanceOracle.hpp"
+#include "objects/NavHierarchy.hpp"
+#include "ecs/systems/EnemySystems.hpp"
+
+class Map;
+
+/**
+ * Clase LevelSnapshot
+ *  - Copia en memoria del estado de una partida: entidades y componentes del
+ *    registry más el estado lógico del Map, empaquetados como POD en un único
+ *    buffer (id de entidad + bytes del componente, pool a pool).
+ *  - Las texturas se guardan como handle (Texture2D): siguen cacheadas en el
+ *    ResourceManager, así que restaurar no recarga nada.
+ *  - Las cachés caras del contexto (DistanceOracle, NavHierarchy) se copian tal
+ *    cual si estaban al día; el resto (ColliderGrid, MechanismIndex, FlowField,
+ *    VisibilityGrid...) se reconstruye o se recalcula bajo demanda.
+ *  - Sirve para reiniciar el nivel sin releer el mapa ni repetir LevelSetupSystem
+ *    y para checkpoints periódicos durante la partida.
+ */
+class LevelSnapshot {
+    public:
+        /**
+         * Guarda el registry y el mapa (sustituye cualquier captura anterior).
+         * @throws std::logic_error si el registry tiene un componente que no está
+         *         en GameComponents (Ecs.hpp): no se podría restaurar.
+         */
+        void capture(const entt::registry& registry, const Map& map);
+
+        /**
+         * Sustituye el registry (entidades y contexto) y el estado del mapa por la captura.
+         *  - Las entidades conservan sus ids y los pools su orden: la simulación
+         *    sigue igual que desde el estado capturado.
+         * @throws std::runtime_error si no hay captura.
+         */
+        void restore(entt::registry& registry, Map& map) const;
+
+        bool empty() const { return _data.empty(); }
+        void clear();
+
+        /// Tamaño del buffer empaquetado (sin contar las cachés copiadas).
+        size_t byteSize() const { return _data.size(); }
+
+    private:
+        std::vector<uint8_t> _data;
+
+        // Cachés del contexto válidas para la navegación capturada (pueden faltar)
+        std::shared_ptr<const DistanceOracle> _oracle;
+        std::shared_ptr<const NavHierarchy> _nav;
+        std::shared_ptr<const EnemyAIScheduler> _scheduler;
+};
+
+/**
+ * Cambia la semilla del nivel en una partida restaurada: vuelve a derivar el
+ * RandomStream de cada entidad igual que LevelSetupSystem (semilla + id de entidad).
+ */
+void ReseedRandomStreams(entt::registry& registry, uint64_t seed);
@@ -0,0 +1,55 @@
+#include "ecs/MechanismIndex.hpp"
+#include "objects/Map.hpp"
+#include "ecs/components/World/TransformComponent.hpp"
+#include <cmath>
+
+void MechanismIndex::reset(int w, int h) {
+    _w = w;
+    _h = h;
+    _triggerByCell.clear();
+    _entitiesById.clear();
+}
+
+MechanismId MechanismIndex::triggerAt(int x, int y) const {
+    if (x < 0 || y < 0 || x >= _w || y >= _h) return NONE;
+    auto it = _triggerByCell.find(y * _w + x);
+    return it != _triggerByCell.end() ? it->second : NONE;
+}
+
+void MechanismIndex::setTrigger(int x, int y, MechanismId id) {
+    if (x < 0 || y < 0 || x >= _w || y >= _h) return;
+    if (id == NONE) _triggerByCell.erase(y * _w + x);
+    else _triggerByCell[y * _w + x] = id;
+}
+
+const std::vector<entt::entity>& MechanismIndex::entities(MechanismId id) const {
+    static const std::vector<entt::entity> empty;
+    if (id < 0 || id >= static_cast<MechanismId>(_entitiesById.size())) return empty;
+    return _entitiesById[id];
+}
+
+void MechanismIndex::addEntity(MechanismId id, entt::entity entity) {
+    if (id < 0) return;
+    if (id >= static_cast<MechanismId>(_entitiesById.size())) _entitiesById.resize(id + 1);
+    _entitiesById[id].push_back(entity);
+}
+
+MechanismIndex& BuildMechanismIndex(entt::registry& registry, const Map& map) {
+    auto &index = registry.ctx().insert_or_assign(MechanismIndex{});
+    index.reset(map.width(), map.height());
+
+    float tileSize = (float)map.tile();
+    auto view = registry.view<const MechanismComponent, const TransformComponent>();
+    for (auto entity : view) {
+        const auto &mech = view.get<const MechanismComponent>(entity);
+        index.addEntity(mech.id, entity);
+
+        // Solo los triggers activos se registran por celda
+        if (mech.active && registry.all_of<MechanismTriggerComponent>(entity)) {
+            const auto &tr = view.get<const TransformComponent>(entity);
+            index.setTrigger((int)std::floor(tr.position.x / tileSize),
+                             (int)std::floor(tr.position.y / tileSize), mech.id);
+        }
+    }
+    return index;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <unordered_map>
+#include <vector>
+#include <entt/entt.hpp>
+#include "ecs/components/World/MechanismComponent.hpp"
+
+class Map;
+
+/**
+ * Clase MechanismIndex
+ *  - Índice celda → id de trigger activo (tabla hash: ocupa memoria por trigger,
+ *    no por celda, también en mapas enormes por chunks).
+ *  - Índice id → entidades del mecanismo (trigger + target).
+ *  - Permite que MechanismSystem reaccione solo a eventos de cambio de celda
+ *    sin recorrer todos los mecanismos cada frame.
+ *  - Se guarda en el contexto del registry (registry.ctx()).
+ */
+class MechanismIndex {
+    public:
+        static constexpr MechanismId NONE = -1;
+
+        /// Reinicia el índice para un mapa de w x h celdas.
+        void reset(int w, int h);
+
+        /// Id del trigger activo en la celda (x,y); NONE si no hay o está fuera de rango.
+        MechanismId triggerAt(int x, int y) const;
+
+        void setTrigger(int x, int y, MechanismId id);
+
+        /// Entidades (trigger y target) que comparten el id. Vacío si el id no existe.
+        const std::vector<entt::entity>& entities(MechanismId id) const;
+
+        void addEntity(MechanismId id, entt::entity entity);
+
+    private:
+        int _w = 0, _h = 0;
+        std::unordered_map<int, MechanismId> _triggerByCell;   // índice lineal → id
+        std::vector<std::vector<entt::entity>> _entitiesById;
+};
+
+/**
+ * Construye el MechanismIndex del registry a partir de las entidades con
+ * MechanismComponent + TransformComponent. Sustituye cualquier índice anterior.
+ */
+MechanismIndex& BuildMechanismIndex(entt::registry& registry, const Map& map);
@@ -0,0 +1,22 @@
+#include "ecs/RenderQueue.hpp"
+#include <algorithm>
+
+void RenderQueue::push(const Texture2D& texture, Rectangle src, Rectangle dst, Vector2 origin,
+                       RenderLayer layer, float sortY) {
+    _commands.push_back({ texture, src, dst, origin, layer, sortY, static_cast<uint32_t>(_commands.size()) });
+}
+
+void RenderQueue::sort() {
+    std::sort(_commands.begin(), _commands.end(), [](const DrawCommand& a, const DrawCommand& b) {
+        if (a.layer != b.layer) return a.layer < b.layer;
+        if (a.sortY != b.sortY) return a.sortY < b.sortY;
+        if (a.texture.id != b.texture.id) return a.texture.id < b.texture.id;
+        return a.order < b.order;
+    });
+}
+
+void RenderQueue::submit() const {
+    for (const auto& cmd : _commands) {
+        DrawTexturePro(cmd.texture, cmd.src, cmd.dst, cmd.origin, 0.0f, WHITE);
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+extern "C" {
+  #include <raylib.h>
+}
+
+// Capas de dibujo: primero lo que está "en el suelo", luego los personajes.
+enum class RenderLayer : uint8_t {
+    Props  = 0,  // pinchos, mecanismos, llaves (sprites manuales)
+    Actors = 1   // jugador y enemigos (sprites animados)
+};
+
+// Comando de dibujo plano: todo lo necesario para un DrawTexturePro.
+struct DrawCommand {
+    Texture2D texture;
+    Rectangle src;
+    Rectangle dst;
+    Vector2 origin;
+    RenderLayer layer;
+    float sortY;       // y del "pie" del sprite en mundo (para el orden de solape)
+    uint32_t order;    // orden de inserción (desempate estable)
+};
+
+/**
+ * Clase RenderQueue
+ *  - Buffer reutilizable de DrawCommand (no reserva memoria cada frame).
+ *  - sort(): ordena por capa, y, y textura para que los sprites que se solapan
+ *    se dibujen de atrás hacia delante y se agrupen las texturas iguales.
+ *  - submit(): emite los DrawTexturePro en orden; rlgl agrupa en un mismo batch
+ *    los comandos consecutivos que comparten textura.
+ *  - Se guarda en el contexto del registry (registry.ctx()).
+ */
+class RenderQueue {
+    public:
+        void clear() { _commands.clear(); }
+
+        void push(const Texture2D& texture, Rectangle src, Rectangle dst, Vector2 origin,
+                  RenderLayer layer, float sortY);
+
+        void sort();
+        void submit() const;
+
+        const std::vector<DrawCommand>& commands() const { return _commands; }
+
+    private:
+        std::vector<DrawCommand> _commands;
+};
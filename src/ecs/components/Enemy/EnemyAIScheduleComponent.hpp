@@ -0,0 +1,9 @@
+#pragma once
+
+// Estado del enemigo en el planificador de IA (ver EnemyAIScheduler).
+// El tiempo de los ticks en que no se actualiza se acumula en pendingDt y se
+// entrega entero en la siguiente actualización, así ai.timer no se retrasa.
+struct EnemyAIScheduleComponent {
+    float pendingDt = 0.0f;     // tiempo transcurrido desde su última actualización
+    bool queued = false;        // esperando en la cola diferida (no se vuelve a encolar)
+};
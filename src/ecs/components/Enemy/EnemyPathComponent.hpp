@@ -0,0 +1,15 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "core/Config.hpp"
+
+// Ruta cacheada de un enemigo: waypoints comprimidos de PathService o, en mapas
+// enormes, la ruta abstracta de NavHierarchy (entradas de cluster hasta el objetivo).
+// Se replanifica solo si cambia el objetivo (su cluster, con NavHierarchy) o la
+// navegación del mapa.
+struct EnemyPathComponent {
+    std::vector<IVec2> waypoints;   // puntos de giro hasta el objetivo (sin la celda de partida)
+    size_t next = 0;                // siguiente waypoint por alcanzar
+    IVec2 goal{ -1, -1 };           // celda objetivo con la que se planificó
+    unsigned revision = 0;          // Map::navRevision() al planificar
+};
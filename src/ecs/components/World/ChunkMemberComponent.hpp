@@ -0,0 +1,13 @@
+#pragma once
+
+// Entidad de un mapa por chunks.
+//  - chunk: chunk (Map::chunkOf) en el que está ahora; MovementSystem lo
+//    actualiza al cruzar de chunk. Al descargarse ese chunk la entidad se destruye.
+//  - originCell: celda (Map::index) del mapa de la que nació. Mientras viva,
+//    SpawnChunkEntities no vuelve a crear la entidad de esa celda.
+struct ChunkMemberComponent {
+    int chunk;
+    int originCell;
+
+    explicit ChunkMemberComponent(int c = 0, int origin = -1) : chunk(c), originCell(origin) {}
+};
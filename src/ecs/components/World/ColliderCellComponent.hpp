@@ -0,0 +1,9 @@
+#pragma once
+
+// Celda (índice lineal del mapa) en la que está registrada la entidad dentro del
+// ColliderGrid. Se actualiza solo cuando el movimiento cruza el borde de un tile.
+struct ColliderCellComponent {
+    int cell;
+
+    explicit ColliderCellComponent(int c = 0) : cell(c) {}
+};
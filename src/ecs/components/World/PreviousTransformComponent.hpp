@@ -0,0 +1,10 @@
+#pragma once
+extern "C" {
+  #include <raylib.h>
+}
+
+// Posición al empezar el tick de simulación actual. El render interpola entre
+// esta y TransformComponent::position con lo que sobra del acumulador de tiempo.
+struct PreviousTransformComponent {
+    Vector2 position;
+};
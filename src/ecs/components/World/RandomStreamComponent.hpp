@@ -0,0 +1,8 @@
+#pragma once
+#include "core/Random.hpp"
+
+// Flujo aleatorio propio de la entidad (p.ej. orden de patrulla de un enemigo).
+// Se siembra al crear el nivel con la semilla del nivel y el id de la entidad.
+struct RandomStreamComponent {
+    RandomStream rng;
+};
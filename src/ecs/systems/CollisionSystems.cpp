@@ -1,4 +1,6 @@
 #include "ecs/systems/CollisionSystems.hpp"
+#include "ecs/ColliderGrid.hpp"
+#include <vector>
 
 extern "C" {
     #include <raylib.h>
@@ -14,6 +16,8 @@ void CollisionSystem(entt::registry &registry, Map &map) {
     auto &playerCol = playerView.get<ColliderComponent>(playerEntity);
     auto &playerState = playerView.get<PlayerStateComponent>(playerEntity);
     auto &cheats = playerView.get<PlayerCheatComponent>(playerEntity);
+    auto *playerMove = registry.try_get<MovementComponent>(playerEntity);
+    auto *playerStats = registry.try_get<PlayerStatsComponent>(playerEntity);
 
     Rectangle playerBox = {
         playerTrans.position.x + playerCol.rect.x,
@@ -22,100 +26,112 @@ void CollisionSystem(entt::registry &registry, Map &map) {
         playerCol.rect.height
     };
 
-    auto hazardView = registry.view<TransformComponent, ColliderComponent>();
+    // Broadphase: solo las entidades registradas en el tile del jugador y sus vecinos
+    auto *grid = registry.ctx().find<ColliderGrid>();
+    if (!grid) grid = &BuildColliderGrid(registry, map);
 
-    hazardView.each([&](auto entity, auto &hazardTrans, auto &hazardCol) {
-        if(entity == playerEntity) return;
-        if (!hazardCol.active) return;
+    static std::vector<entt::entity> nearby;
+    grid->queryNeighborhood(playerTrans.position, nearby);
+
+    // Las llaves recogidas se destruyen al final para no alterar los cubos mientras se recorren
+    static std::vector<entt::entity> collected;
+    collected.clear();
+
+    for (auto entity : nearby) {
+        auto *hazardTrans = registry.try_get<TransformComponent>(entity);
+        auto *hazardColPtr = registry.try_get<ColliderComponent>(entity);
+        if (!hazardTrans || !hazardColPtr) continue;
+        auto &hazardCol = *hazardColPtr;
+
+        if (entity == playerEntity) continue;
+        if (!hazardCol.active) continue;
 
         Rectangle hazardBox = {
-            hazardTrans.position.x + hazardCol.rect.x,
-            hazardTrans.position.y + hazardCol.rect.y,
+            hazardTrans->position.x + hazardCol.rect.x,
+            hazardTrans->position.y + hazardCol.rect.y,
             hazardCol.rect.width,
             hazardCol.rect.height
         };
 
-        if (CheckCollisionRecs(playerBox, hazardBox)) {
-            if (hazardCol.type == CollisionType::Spike || hazardCol.type == CollisionType::Enemy) {
-                if (hazardCol.type == CollisionType::Spike && registry.all_of<SpikeComponent>(entity)) {
-                    const auto &spike = registry.get<SpikeComponent>(entity);
-                    if (!spike.active) return;
-                }
-                if (cheats.godMode) return;
-                if (playerState.invulnerableTimer > 0.0f && playerState.invulnerableTimer < playerState.invulnerableDuration) {
-                    return;
-                }
-                if (hazardCol.type == CollisionType::Enemy && registry.all_of<EnemyAIComponent>(entity)) {
-                    auto &ai = registry.get<EnemyAIComponent>(entity);
-                    if (ai.state == EnemyAIState::Chase) {
-                        ai.state = EnemyAIState::Retreat;
-                        ai.retreatTimer = ai.retreatDuration;
-                        if (registry.all_of<MovementComponent>(entity)) {
-                            auto &move = registry.get<MovementComponent>(entity);
-                            move.isMoving = false;
-                            move.progress = 0.0f;
-                        }
+        if (!CheckCollisionRecs(playerBox, hazardBox)) continue;
+
+        if (hazardCol.type == CollisionType::Spike || hazardCol.type == CollisionType::Enemy) {
+            if (hazardCol.type == CollisionType::Spike) {
+                const auto *spike = registry.try_get<SpikeComponent>(entity);
+                if (spike && !spike->active) continue;
+            }
+            if (cheats.godMode) continue;
+            if (playerState.invulnerableTimer > 0.0f && playerState.invulnerableTimer < playerState.invulnerableDuration) {
+                continue;
+            }
+            if (hazardCol.type == CollisionType::Enemy) {
+                if (auto *ai = registry.try_get<EnemyAIComponent>(entity); ai && ai->state == EnemyAIState::Chase) {
+                    ai->state = EnemyAIState::Retreat;
+                    ai->retreatTimer = ai->retreatDuration;
+                    if (auto *move = registry.try_get<MovementComponent>(entity)) {
+                        move->isMoving = false;
+                        move->progress = 0.0f;
                     }
                 }
+            }
 
-                float tileSize = (float)map.tile();
-                int prevCellX = (int)(playerState.lastTilePos.x / tileSize);
-                int prevCellY = (int)(playerState.lastTilePos.y / tileSize);
-
-                bool validRespawn = true;
-                if (prevCellX < 0 || prevCellX >= map.width() || prevCellY < 0 || prevCellY >= map.height()) {
-                    validRespawn = false;
-                } else if (map.at(prevCellX, prevCellY) == '#') {
-                    validRespawn = false;
-                }
+            float tileSize = (float)map.tile();
+            int prevCellX = (int)(playerState.lastTilePos.x / tileSize);
+            int prevCellY = (int)(playerState.lastTilePos.y / tileSize);
 
-                if (!validRespawn) {
-                    IVec2 startGrid = map.playerStart();
-                    playerTrans.position = {
-                        startGrid.x * tileSize + tileSize / 2.0f,
-                        startGrid.y * tileSize + tileSize / 2.0f
-                    };
-                } else {
-                    playerTrans.position = {
-                        prevCellX * tileSize + tileSize / 2.0f,
-                        prevCellY * tileSize + tileSize / 2.0f
-                    };
-                }
+            bool validRespawn = true;
+            if (!map.inBounds(prevCellX, prevCellY)) {
+                validRespawn = false;
+            } else if (map.isWall(prevCellX, prevCellY)) {
+                validRespawn = false;
+            }
 
-                if (registry.all_of<MovementComponent>(playerEntity)) {
-                    auto &move = registry.get<MovementComponent>(playerEntity);
-                    move.isMoving = false;
-                    move.progress = 0.0f;
-                    move.targetPos = playerTrans.position;
-                }
+            if (!validRespawn) {
+                IVec2 startGrid = map.playerStart();
+                playerTrans.position = {
+                    startGrid.x * tileSize + tileSize / 2.0f,
+                    startGrid.y * tileSize + tileSize / 2.0f
+                };
+            } else {
+                playerTrans.position = {
+                    prevCellX * tileSize + tileSize / 2.0f,
+                    prevCellY * tileSize + tileSize / 2.0f
+                };
+            }
 
-                if (registry.all_of<PlayerStatsComponent>(playerEntity)) {
-                    auto &stats = registry.get<PlayerStatsComponent>(playerEntity);
-                    stats.lives--;
-                }
+            if (playerMove) {
+                playerMove->isMoving = false;
+                playerMove->progress = 0.0f;
+                playerMove->targetPos = playerTrans.position;
+            }
 
-                playerState.invulnerableTimer = 0.0001f;
-            } else if (hazardCol.type == CollisionType::Item) {
-                if (registry.all_of<ItemComponent>(entity)) {
-                    auto &item = registry.get<ItemComponent>(entity);
-                    if (!item.collected) {
-                        item.collected = true;
-                        if (registry.all_of<PlayerStatsComponent>(playerEntity)) {
-                            auto &stats = registry.get<PlayerStatsComponent>(playerEntity);
-                            if (item.isKey) {
-                                stats.keysCollected++;
-                            }
-                        }
-
-                        float tileSize = (float)map.tile();
-                        int cellX = (int)(hazardTrans.position.x / tileSize);
-                        int cellY = (int)(hazardTrans.position.y / tileSize);
-                        map.clearCell(cellX, cellY);
-
-                        registry.destroy(entity);
-                    }
+            if (playerStats) {
+                playerStats->lives--;
+            }
+
+            playerState.invulnerableTimer = 0.0001f;
+        } else if (hazardCol.type == CollisionType::Item) {
+            auto *item = registry.try_get<ItemComponent>(entity);
+            if (item && !item->collected) {
+                item->collected = true;
+                if (playerStats && item->isKey) {
+                    playerStats->keysCollected++;
                 }
+
+                float tileSize = (float)map.tile();
+                int cellX = (int)(hazardTrans->position.x / tileSize);
+                int cellY = (int)(hazardTrans->position.y / tileSize);
+                map.clearCell(cellX, cellY);
+
+                collected.push_back(entity);
             }
         }
-    });
+    }
+
+    for (auto entity : collected) {
+        if (const auto *cell = registry.try_get<ColliderCellComponent>(entity)) {
+            grid->remove(entity, cell->cell);
+        }
+        registry.destroy(entity);
+    }
 }
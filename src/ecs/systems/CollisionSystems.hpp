@@ -6,6 +6,7 @@
 #include "ecs/components/Player/PlayerStateComponent.hpp"
 #include "ecs/components/Player/PlayerStatsComponent.hpp"
 #include "ecs/components/World/ColliderComponent.hpp"
+#include "ecs/components/World/ColliderCellComponent.hpp"
 #include "ecs/components/World/TransformComponent.hpp"
 #include "ecs/components/World/ItemComponent.hpp"
 #include "ecs/components/World/SpikeComponent.hpp"
@@ -1,53 +1,257 @@
 #include "ecs/systems/EnemySystems.hpp"
 #include "ecs/systems/WorldSystems.hpp"
+#include "objects/DistanceOracle.hpp"
+#include "objects/FlowField.hpp"
+#include "objects/NavHierarchy.hpp"
+#include "objects/PathService.hpp"
+#include "objects/VisibilityGrid.hpp"
+#include "core/JobSystem.hpp"
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <cstdlib>
+#include <vector>
 
 extern "C" {
     #include <raylib.h>
 }
 
-static void ShuffledNeighbors(int out[4]) {
+// Orden aleatorio de vecinos sacado del flujo propio del enemigo (sin estado global)
+static void ShuffledNeighbors(int out[4], RandomStream &rng) {
     out[0]=0; out[1]=1; out[2]=2; out[3]=3;
     for (int i = 3; i > 0; --i) {
-        int j = GetRandomValue(0, i);
+        int j = rng.nextInt(0, i);
         std::swap(out[i], out[j]);
     }
 }
 
-static bool HasLineOfSight(const Map &map, int x0, int y0, int x1, int y1) {
-    int dx = std::abs(x1 - x0);
-    int dy = std::abs(y1 - y0);
-    int sx = (x0 < x1) ? 1 : -1;
-    int sy = (y0 < y1) ? 1 : -1;
-    int err = dx - dy;
+// Inicia el paso de un enemigo hacia la celda (nx, ny).
+static void StartEnemyStep(const TransformComponent &transform, MovementComponent &move, EnemyAIComponent &ai,
+                           int nx, int ny, float tileSize, float speedMul) {
+    move.startPos = transform.position;
+    move.targetPos = { nx * tileSize + tileSize / 2.0f, ny * tileSize + tileSize / 2.0f };
+    move.duration = (move.speed > 0) ? (tileSize / (move.speed * speedMul)) : 0.12f;
+    move.progress = 0.0f;
+    move.isMoving = true;
+    ai.timer = 0.0f;
+}
+
+// Orienta el sprite según la dirección del paso que acaba de empezar
+static void FaceMovement(const TransformComponent &transform, const MovementComponent &move, SpriteComponent &sprite) {
+    float dirX = move.targetPos.x - transform.position.x;
+    if (dirX > 0.0f) {
+        sprite.flipX = false; // der
+    } else if (dirX < 0.0f) {
+        sprite.flipX = true;  // izq
+    }
+}
+
+// Datos compartidos por todos los enemigos en un tick (solo lectura durante el reparto)
+struct EnemyAIContext {
+    const Map &map;
+    const DistanceOracle &oracle;
+    const FlowField &flow;
+    const NavHierarchy &nav;
+    bool useNav;            // mapa enorme: NavHierarchy en lugar de FlowField
+    const VisibilityGrid &vis;
+    Vector2 playerPos;
+    int playerCellX;
+    int playerCellY;
+    float tileSize;
+};
 
-    int currentX = x0;
-    int currentY = y0;
+// Paso de patrulla a un vecino transitable en orden aleatorio (en cualquier
+// tamaño de mapa: la patrulla es local y no planifica rutas)
+static void StartPatrolStep(const Map &map, TransformComponent &transform, MovementComponent &move,
+                            EnemyAIComponent &ai, SpriteComponent &sprite, RandomStream &rng,
+                            int cellX, int cellY, float tileSize) {
+    const int dx[4] = {0, 0, 1, -1};
+    const int dy[4] = {1, -1, 0, 0};
 
-    while (true) {
-        if (currentX == x1 && currentY == y1) {
-            return true;
+    int order[4];
+    ShuffledNeighbors(order, rng);
+
+    for (int k = 0; k < 4; ++k) {
+        int i = order[k];
+        int nx = cellX + dx[i];
+        int ny = cellY + dy[i];
+        if (map.isWalkableForEnemy(nx, ny) && !IsMechanismBlockingCell(map, nx, ny)) {
+            StartEnemyStep(transform, move, ai, nx, ny, tileSize, 1.0f);
+            FaceMovement(transform, move, sprite);
+            return;
         }
+    }
+    move.isMoving = false;
+}
 
-        if (!(currentX == x0 && currentY == y0)) {
-            if (currentX < 0 || currentX >= map.width() || currentY < 0 || currentY >= map.height()) {
-                return false;
-            }
-            char cell = map.at(currentX, currentY);
-            if (cell == '#') {
-                return false;
-            }
+// Sigue la ruta cacheada hacia el jugador. Solo se replanifica (JPS) si el
+// jugador ha cambiado de celda, ha cambiado la navegación o el enemigo se ha
+// salido de la ruta; un objetivo inalcanzable no se reintenta hasta entonces.
+static bool FollowPath(const EnemyAIContext &ctx, EnemyPathComponent &path, int cellX, int cellY, IVec2 &next) {
+    const IVec2 playerCell{ ctx.playerCellX, ctx.playerCellY };
+
+    auto reached = [&](const IVec2 &wp) { return wp.x == cellX && wp.y == cellY; };
+    while (path.next < path.waypoints.size() && reached(path.waypoints[path.next])) ++path.next;
+
+    const bool sameGoal = path.goal.x == playerCell.x && path.goal.y == playerCell.y &&
+                          path.revision == ctx.map.navRevision();
+    const bool onRoute = path.next >= path.waypoints.size() ||
+                         path.waypoints[path.next].x == cellX || path.waypoints[path.next].y == cellY;
+
+    if (!sameGoal || !onRoute) {
+        path.goal = playerCell;
+        path.revision = ctx.map.navRevision();
+        path.next = 0;
+        if (!PathService::Get().findPath(ctx.map, { cellX, cellY }, playerCell, path.waypoints)) return false;
+    }
+    if (path.next >= path.waypoints.size()) return false;
+
+    // Los waypoints comparten fila o columna con la celda actual: un paso hacia él
+    const IVec2 &wp = path.waypoints[path.next];
+    next = { cellX + (wp.x > cellX) - (wp.x < cellX), cellY + (wp.y > cellY) - (wp.y < cellY) };
+    return true;
+}
+
+// Igual que FollowPath en mapas enormes: la ruta abstracta de NavHierarchy se
+// guarda en EnemyPathComponent y el A* sobre el grafo de entradas solo se repite
+// si el jugador cambia de cluster, cambia la navegación o el enemigo se sale de
+// la ruta. Si el jugador se mueve dentro de su cluster basta con cambiar el
+// último waypoint; cada paso cuesta solo el BFS del cluster actual.
+static bool FollowNavRoute(const EnemyAIContext &ctx, EnemyPathComponent &path, int cellX, int cellY, IVec2 &next) {
+    const IVec2 from{ cellX, cellY };
+    const IVec2 playerCell{ ctx.playerCellX, ctx.playerCellY };
+    if (from.x == playerCell.x && from.y == playerCell.y) return false;
+
+    const NavHierarchy &nav = ctx.nav;
+    const bool sameGoal = path.goal.x >= 0 && path.revision == ctx.map.navRevision() &&
+                          nav.clusterOf(path.goal.x, path.goal.y) == nav.clusterOf(playerCell.x, playerCell.y);
+    if (sameGoal) {
+        // Objetivo inalcanzable: no se reintenta hasta que cambie algo
+        if (path.waypoints.empty()) return false;
+
+        // Una ruta parcial (tope de expansiones) no acaba en el objetivo: se sigue
+        // hasta su final y allí se replanifica
+        IVec2 &last = path.waypoints.back();
+        if (last.x == path.goal.x && last.y == path.goal.y) last = playerCell;
+        path.goal = playerCell;
+        auto reached = [&](const IVec2 &wp) { return wp.x == cellX && wp.y == cellY; };
+        while (path.next < path.waypoints.size() && reached(path.waypoints[path.next])) ++path.next;
+        if (path.next < path.waypoints.size() &&
+            nav.stepToWaypoint(ctx.map, from, path.waypoints[path.next], next)) return true;
+    }
+
+    path.goal = playerCell;
+    path.revision = ctx.map.navRevision();
+    path.next = 0;
+    if (!nav.findRoute(ctx.map, from, playerCell, path.waypoints)) {
+        path.waypoints.clear();
+        return false;
+    }
+    return nav.stepToWaypoint(ctx.map, from, path.waypoints.front(), next);
+}
+
+// Paso de persecución: tabla de distancias (mapas pequeños), ruta jerárquica
+// (mapas enormes) o ruta cacheada con PathService (resto).
+static bool ChaseStep(const EnemyAIContext &ctx, EnemyPathComponent &path, int cellX, int cellY, IVec2 &next) {
+    const IVec2 playerCell{ ctx.playerCellX, ctx.playerCellY };
+    if (ctx.oracle.ready()) return ctx.oracle.stepToward(cellX, cellY, playerCell, next);
+    if (ctx.useNav) return FollowNavRoute(ctx, path, cellX, cellY, next);
+    return FollowPath(ctx, path, cellX, cellY, next);
+}
+
+// Paso de huida. En mapas enormes no hay campo global: se elige el vecino libre
+// que más aleja en línea recta (la huida dura poco y es local).
+static bool RetreatStep(const EnemyAIContext &ctx, int cellX, int cellY, IVec2 &next) {
+    const IVec2 playerCell{ ctx.playerCellX, ctx.playerCellY };
+    if (ctx.oracle.ready()) return ctx.oracle.stepAway(cellX, cellY, playerCell, next);
+    if (!ctx.useNav) return ctx.flow.stepAway(cellX, cellY, next);
+
+    const int dx[4] = {0, 0, 1, -1};
+    const int dy[4] = {1, -1, 0, 0};
+    auto dist2 = [&](int x, int y) {
+        return (x - playerCell.x) * (x - playerCell.x) + (y - playerCell.y) * (y - playerCell.y);
+    };
+
+    int best = dist2(cellX, cellY);
+    bool found = false;
+    for (int i = 0; i < 4; ++i) {
+        int nx = cellX + dx[i];
+        int ny = cellY + dy[i];
+        if (!ctx.map.isWalkableForEnemy(nx, ny) || ctx.map.isMechanismBlocked(nx, ny)) continue;
+        if (dist2(nx, ny) > best) {
+            best = dist2(nx, ny);
+            next = { nx, ny };
+            found = true;
         }
+    }
+    return found;
+}
+
+// Decide y aplica el comportamiento de un enemigo. Solo escribe en sus propios
+// componentes (incluido su flujo aleatorio), así que puede ejecutarse en paralelo
+// con los demás y el resultado no depende del reparto entre hilos.
+// deltaTime es el tiempo desde su última actualización (varios ticks si es lejano).
+static void UpdateEnemy(const EnemyAIContext &ctx, float deltaTime, TransformComponent &transform,
+                        MovementComponent &move, EnemyAIComponent &ai, EnemyPathComponent &path,
+                        SpriteComponent &sprite, RandomStream &rng) {
+    const float tileSize = ctx.tileSize;
+    ai.timer += deltaTime;
+
+    int cellX = (int)std::round((transform.position.x - tileSize / 2.0f) / tileSize);
+    int cellY = (int)std::round((transform.position.y - tileSize / 2.0f) / tileSize);
+
+    float dxp = transform.position.x - ctx.playerPos.x;
+    float dyp = transform.position.y - ctx.playerPos.y;
+    float distToPlayer = std::sqrt(dxp * dxp + dyp * dyp);
+    float distInTiles = distToPlayer / tileSize;
+
+    // LOS aproximada como "el jugador ve la celda del enemigo" (una consulta)
+    bool hasLos = ctx.vis.isVisible(cellX, cellY);
 
-        int e2 = 2 * err;
-        if (e2 > -dy) {
-            err -= dy;
-            currentX += sx;
+    switch (ai.state) {
+        case EnemyAIState::Patrol: {
+            if (distInTiles <= ai.detectionRange && hasLos) {
+                ai.state = EnemyAIState::Chase;
+                ai.timer = 0.0f;
+                path.goal = { -1, -1 };   // la ruta anterior ya no sirve
+            } else if (!move.isMoving && (ai.moveCooldown == 0.0f || ai.timer >= ai.moveCooldown)) {
+                StartPatrolStep(ctx.map, transform, move, ai, sprite, rng, cellX, cellY, tileSize);
+            }
+            break;
         }
-        if (e2 < dx) {
-            err += dx;
-            currentY += sy;
+        case EnemyAIState::Chase: {
+            if (distInTiles > ai.detectionRange * 1.5f || !hasLos) {
+                ai.state = EnemyAIState::Patrol;
+                ai.timer = 0.0f;
+            } else if (!move.isMoving && ai.timer >= 0.05f) {
+                // Caminos reales hacia el jugador: rodean las paredes cóncavas
+                IVec2 next;
+                if (ChaseStep(ctx, path, cellX, cellY, next)) {
+                    StartEnemyStep(transform, move, ai, next.x, next.y, tileSize, 1.05f);
+                    FaceMovement(transform, move, sprite);
+                } else {
+                    move.isMoving = false;
+                }
+            }
+            break;
+        }
+        case EnemyAIState::Retreat: {
+            ai.retreatTimer -= deltaTime;
+            if (ai.retreatTimer <= 0.0f) {
+                ai.state = EnemyAIState::Patrol;
+                ai.retreatTimer = 0.0f;
+                ai.timer = 0.0f;
+            } else if (!move.isMoving && ai.timer >= 0.1f) {
+                // Subir por el gradiente: alejarse del jugador por caminos reales
+                IVec2 next;
+                if (RetreatStep(ctx, cellX, cellY, next)) {
+                    StartEnemyStep(transform, move, ai, next.x, next.y, tileSize, 1.1f);
+                    FaceMovement(transform, move, sprite);
+                } else {
+                    move.isMoving = false;
+                }
+            }
+            break;
         }
     }
 }
@@ -59,205 +263,123 @@ void EnemyAISystem(entt::registry &registry, const Map &map, float deltaTime) {
     auto playerEntity = *playerView.begin();
     const auto &playerTrans = playerView.get<const TransformComponent>(playerEntity);
 
-    auto view = registry.view<TransformComponent, MovementComponent, ColliderComponent, EnemyAIComponent, SpriteComponent>();
+    float tileSize = (float)map.tile();
+    int playerCellX = (int)std::round((playerTrans.position.x - tileSize / 2.0f) / tileSize);
+    int playerCellY = (int)std::round((playerTrans.position.y - tileSize / 2.0f) / tileSize);
 
-    for (auto entity : view) {
-        auto &transform = view.get<TransformComponent>(entity);
-        auto &move = view.get<MovementComponent>(entity);
-        auto &col = view.get<ColliderComponent>(entity);
-        auto &ai = view.get<EnemyAIComponent>(entity);
-        auto &sprite = view.get<SpriteComponent>(entity);
-
-        if (col.type != CollisionType::Enemy) continue;
-
-        ai.timer += deltaTime;
-
-        float tileSize = (float)map.tile();
-        int cellX = (int)std::round((transform.position.x - tileSize / 2.0f) / tileSize);
-        int cellY = (int)std::round((transform.position.y - tileSize / 2.0f) / tileSize);
-
-        int playerCellX = (int)std::round((playerTrans.position.x - tileSize / 2.0f) / tileSize);
-        int playerCellY = (int)std::round((playerTrans.position.y - tileSize / 2.0f) / tileSize);
-
-        float dxp = transform.position.x - playerTrans.position.x;
-        float dyp = transform.position.y - playerTrans.position.y;
-        float distToPlayer = std::sqrt(dxp * dxp + dyp * dyp);
-        float distInTiles = distToPlayer / tileSize;
-
-        bool hasLos = HasLineOfSight(map, cellX, cellY, playerCellX, playerCellY);
-        bool startedMovementThisFrame = false;
-
-
-        switch (ai.state) {
-            case EnemyAIState::Patrol: {
-                if (distInTiles <= ai.detectionRange && hasLos) {
-                    ai.state = EnemyAIState::Chase;
-                    ai.timer = 0.0f;
-                } else if (!move.isMoving && (ai.moveCooldown == 0.0f || ai.timer >= ai.moveCooldown)) {
-                    const int dx[4] = {0, 0, 1, -1};
-                    const int dy[4] = {1, -1, 0, 0};
-
-                    int order[4];
-                    ShuffledNeighbors(order);
-
-                    bool found = false;
-                    for (int k = 0; k < 4; ++k) {
-                        int i = order[k];
-                        int nx = cellX + dx[i];
-                        int ny = cellY + dy[i];
-                        if (map.isWalkableForEnemy(nx, ny) && !IsMechanismBlockingCell(registry, nx, ny)) {
-                            move.startPos = transform.position;
-                            move.targetPos = { nx * tileSize + tileSize / 2.0f, ny * tileSize + tileSize / 2.0f };
-                            move.duration = (move.speed > 0) ? (tileSize / move.speed) : 0.12f;
-                            move.progress = 0.0f;
-                            move.isMoving = true;
-                            ai.timer = 0.0f;
-                            found = true;
-                            startedMovementThisFrame = true;
-                            break;
-                        }
-                    }
-                    if (!found) {
-                        move.isMoving = false;
-                    }
-                }
-                break;
-            }
-            case EnemyAIState::Chase: {
-                if (distInTiles > ai.detectionRange * 1.5f || !hasLos) {
-                    ai.state = EnemyAIState::Patrol;
-                    ai.timer = 0.0f;
-                } else if (!move.isMoving && ai.timer >= 0.05f) {
-                    int deltaX = playerCellX - cellX;
-                    int deltaY = playerCellY - cellY;
-
-                    int priorities[4];
-                    if (std::abs(deltaX) > std::abs(deltaY)) {
-                        if (deltaX > 0) {
-                            priorities[0] = 2;
-                            priorities[1] = (deltaY > 0) ? 0 : 1;
-                            priorities[2] = (deltaY > 0) ? 1 : 0;
-                            priorities[3] = 3;
-                        } else {
-                            priorities[0] = 3;
-                            priorities[1] = (deltaY > 0) ? 0 : 1;
-                            priorities[2] = (deltaY > 0) ? 1 : 0;
-                            priorities[3] = 2;
-                        }
-                    } else {
-                        if (deltaY > 0) {
-                            priorities[0] = 0;
-                            priorities[1] = (deltaX > 0) ? 2 : 3;
-                            priorities[2] = (deltaX > 0) ? 3 : 2;
-                            priorities[3] = 1;
-                        } else {
-                            priorities[0] = 1;
-                            priorities[1] = (deltaX > 0) ? 2 : 3;
-                            priorities[2] = (deltaX > 0) ? 3 : 2;
-                            priorities[3] = 0;
-                        }
-                    }
-
-                    const int dx[4] = {0, 0, 1, -1};
-                    const int dy[4] = {1, -1, 0, 0};
-
-                    bool found = false;
-                    for (int k = 0; k < 4; ++k) {
-                        int i = priorities[k];
-                        int nx = cellX + dx[i];
-                        int ny = cellY + dy[i];
-                        if (map.isWalkableForEnemy(nx, ny) && !IsMechanismBlockingCell(registry, nx, ny)) {
-                            move.startPos = transform.position;
-                            move.targetPos = { nx * tileSize + tileSize / 2.0f, ny * tileSize + tileSize / 2.0f };
-                            float speedMul = 1.05f;
-                            move.duration = (move.speed > 0) ? (tileSize / (move.speed * speedMul)) : 0.12f;
-                            move.progress = 0.0f;
-                            move.isMoving = true;
-                            ai.timer = 0.0f;
-                            found = true;
-                            startedMovementThisFrame = true;
-                            break;
-                        }
-                    }
-                    if (!found) {
-                        move.isMoving = false;
-                    }
-                }
-                break;
-            }
-            case EnemyAIState::Retreat: {
-                ai.retreatTimer -= deltaTime;
-                if (ai.retreatTimer <= 0.0f) {
-                    ai.state = EnemyAIState::Patrol;
-                    ai.retreatTimer = 0.0f;
-                    ai.timer = 0.0f;
-                } else if (!move.isMoving && ai.timer >= 0.1f) {
-                    int deltaX = cellX - playerCellX;
-                    int deltaY = cellY - playerCellY;
-
-                    int priorities[4];
-                    if (std::abs(deltaX) > std::abs(deltaY)) {
-                        if (deltaX > 0) {
-                            priorities[0] = 2;
-                            priorities[1] = (deltaY > 0) ? 0 : 1;
-                            priorities[2] = (deltaY > 0) ? 1 : 0;
-                            priorities[3] = 3;
-                        } else {
-                            priorities[0] = 3;
-                            priorities[1] = (deltaY > 0) ? 0 : 1;
-                            priorities[2] = (deltaY > 0) ? 1 : 0;
-                            priorities[3] = 2;
-                        }
-                    } else {
-                        if (deltaY > 0) {
-                            priorities[0] = 0;
-                            priorities[1] = (deltaX > 0) ? 2 : 3;
-                            priorities[2] = (deltaX > 0) ? 3 : 2;
-                            priorities[3] = 1;
-                        } else {
-                            priorities[0] = 1;
-                            priorities[1] = (deltaX > 0) ? 2 : 3;
-                            priorities[2] = (deltaX > 0) ? 3 : 2;
-                            priorities[3] = 0;
-                        }
-                    }
-
-                    const int dx[4] = {0, 0, 1, -1};
-                    const int dy[4] = {1, -1, 0, 0};
-
-                    bool found = false;
-                    for (int k = 0; k < 4; ++k) {
-                        int i = priorities[k];
-                        int nx = cellX + dx[i];
-                        int ny = cellY + dy[i];
-                        if (map.isWalkableForEnemy(nx, ny) && !IsMechanismBlockingCell(registry, nx, ny)) {
-                            move.startPos = transform.position;
-                            move.targetPos = { nx * tileSize + tileSize / 2.0f, ny * tileSize + tileSize / 2.0f };
-                            float speedMul = 1.1f;
-                            move.duration = (move.speed > 0) ? (tileSize / (move.speed * speedMul)) : 0.12f;
-                            move.progress = 0.0f;
-                            move.isMoving = true;
-                            ai.timer = 0.0f;
-                            found = true;
-                            startedMovementThisFrame = true;
-                            break;
-                        }
-                    }
-                    if (!found) {
-                        move.isMoving = false;
-                    }
-                }
-                break;
+    // En mapas pequeños todas las distancias están precalculadas (LevelSetupSystem);
+    // aquí solo se reconstruye la tabla si un mecanismo ha cambiado la navegación.
+    auto &oracle = registry.ctx().emplace<DistanceOracle>();
+    oracle.update(map);
+
+    // Mapas enormes: navegación jerárquica. Un BFS completo por cada cambio de
+    // celda del jugador sería proporcional al área; tras un mecanismo solo se
+    // rehacen los clusters tocados.
+    const size_t cells = (size_t)map.width() * (size_t)map.height();
+    const bool useNav = !oracle.ready() && cells >= NAV_HIERARCHY_MIN_CELLS;
+    auto &nav = registry.ctx().emplace<NavHierarchy>();
+    if (useNav) nav.update(map);
+
+    // Resto de mapas: cada enemigo persigue con su ruta cacheada (PathService) y
+    // para huir se usa el campo de distancias compartido hacia el jugador, que
+    // solo se reconstruye cuando el jugador cambia de celda o la navegación.
+    // Todo se actualiza aquí, antes del reparto: durante los trozos solo se lee.
+    auto &flow = registry.ctx().emplace<FlowField>();
+    if (!oracle.ready() && !useNav) flow.update(map, { playerCellX, playerCellY });
+
+    // Celdas visibles desde el jugador (shadowcasting), con la misma política de
+    // recálculo: la línea de visión de cada enemigo queda en una consulta.
+    auto &vis = registry.ctx().emplace<VisibilityGrid>();
+    vis.update(map, { playerCellX, playerCellY });
+
+    const EnemyAIContext ctx{ map, oracle, flow, nav, useNav, vis, playerTrans.position, playerCellX, playerCellY, tileSize };
+
+    auto view = registry.view<TransformComponent, MovementComponent, ColliderComponent, EnemyAIComponent,
+                              EnemyPathComponent, EnemyAIScheduleComponent, SpriteComponent, RandomStreamComponent>();
+
+    // Actualiza en paralelo una lista de enemigos con su tiempo acumulado
+    auto runEnemies = [&](const std::vector<entt::entity> &list) {
+        JobSystem::Get().parallelFor(list.size(), ENEMY_AI_CHUNK_SIZE, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                auto entity = list[i];
+                auto &slot = view.get<EnemyAIScheduleComponent>(entity);
+                UpdateEnemy(ctx, slot.pendingDt,
+                            view.get<TransformComponent>(entity),
+                            view.get<MovementComponent>(entity),
+                            view.get<EnemyAIComponent>(entity),
+                            view.get<EnemyPathComponent>(entity),
+                            view.get<SpriteComponent>(entity),
+                            view.get<RandomStreamComponent>(entity).rng);
+                slot.pendingDt = 0.0f;
+                slot.queued = false;
             }
+        });
+    };
+
+    // 1) Reparto por cubos: los cercanos van a la lista de este tick; los demás,
+    //    cuando les toca, a la cola diferida (solo una vez aunque sigan esperando)
+    auto &schedule = registry.ctx().emplace<EnemyAIScheduler>();
+    ++schedule.tick;
+
+    static std::vector<entt::entity> enemies;
+    enemies.clear();
+    for (auto entity : view) {
+        if (view.get<ColliderComponent>(entity).type != CollisionType::Enemy) continue;
+
+        auto &slot = view.get<EnemyAIScheduleComponent>(entity);
+        slot.pendingDt += deltaTime;
+
+        const auto &pos = view.get<TransformComponent>(entity).position;
+        const int cellX = (int)std::round((pos.x - tileSize / 2.0f) / tileSize);
+        const int cellY = (int)std::round((pos.y - tileSize / 2.0f) / tileSize);
+        const int dist = std::max(std::abs(cellX - playerCellX), std::abs(cellY - playerCellY));
+
+        const bool near = view.get<EnemyAIComponent>(entity).state != EnemyAIState::Patrol ||
+                          dist <= schedule.nearRadius ||
+                          (dist <= schedule.midRadius && vis.isVisible(cellX, cellY));
+        if (near) {
+            enemies.push_back(entity);
+            continue;
+        }
+
+        const uint32_t interval = std::max<uint32_t>(1, dist <= schedule.midRadius ? schedule.midInterval
+                                                                                     : schedule.farInterval);
+        if (!slot.queued && (schedule.tick + (uint32_t)entt::to_integral(entity)) % interval == 0) {
+            slot.queued = true;
+            schedule.backlog.push_back(entity);
         }
-        // Actualizar orientación del sprite según dirección de movimiento
-        if (startedMovementThisFrame) {
-            float dirX = move.targetPos.x - transform.position.x;
-            if (dirX > 0.0f) {
-                sprite.flipX = false; // der
-            } else if (dirX < 0.0f) {
-                sprite.flipX = true;  // izq
+    }
+
+    // 2) Cercanos: siempre, sin presupuesto
+    runEnemies(enemies);
+
+    // 3) Diferidos por lotes hasta agotar el presupuesto; lo que quede sigue
+    //    en cola para el siguiente tick acumulando su tiempo
+    const auto start = std::chrono::steady_clock::now();
+    const size_t batchSize = (size_t)ENEMY_AI_CHUNK_SIZE * (JobSystem::Get().workerCount() + 1);
+    while (schedule.head < schedule.backlog.size()) {
+        enemies.clear();
+        while (schedule.head < schedule.backlog.size() && enemies.size() < batchSize) {
+            auto entity = schedule.backlog[schedule.head++];
+            // Entidades destruidas o ya actualizadas por estar cerca se descartan
+            if (view.contains(entity) && view.get<EnemyAIScheduleComponent>(entity).queued) {
+                enemies.push_back(entity);
             }
-        }    
+        }
+        runEnemies(enemies);
+
+        if (schedule.budgetSeconds > 0.0f) {
+            std::chrono::duration<float> elapsed = std::chrono::steady_clock::now() - start;
+            if (elapsed.count() >= schedule.budgetSeconds) break;
+        }
+    }
+
+    // Compactar la cola cuando lo consumido domina
+    if (schedule.head == schedule.backlog.size()) {
+        schedule.backlog.clear();
+        schedule.head = 0;
+    } else if (schedule.head > schedule.backlog.size() / 2) {
+        schedule.backlog.erase(schedule.backlog.begin(), schedule.backlog.begin() + (std::ptrdiff_t)schedule.head);
+        schedule.head = 0;
     }
 }
@@ -1,8 +1,37 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 #include <entt/entt.hpp>
 #include "objects/Map.hpp"
+#include "ecs/components/Enemy/EnemyAIScheduleComponent.hpp"
 #include "ecs/components/Enemy/EnemyIAComponent.hpp"
+#include "ecs/components/Enemy/EnemyPathComponent.hpp"
+#include "ecs/components/World/RandomStreamComponent.hpp"
 #include "ecs/components/Player/PlayerStateComponent.hpp"
 #include "ecs/components/Player/PlayerInputComponent.hpp"
 
+/**
+ * Planificador de la IA de enemigos (nivel de detalle). Vive en el ctx del registry.
+ *  - Cerca del jugador, persiguiendo/huyendo o a la vista dentro de midRadius:
+ *    se actualizan en cada tick.
+ *  - Hasta midRadius: cada midInterval ticks; más lejos: cada farInterval ticks.
+ *    Se escalonan por id de entidad para repartir la carga entre ticks.
+ *  - Los enemigos diferidos pasan por una cola. Con budgetSeconds > 0 la cola se
+ *    procesa por lotes hasta agotar el presupuesto y el resto sigue en el
+ *    siguiente tick (con su tiempo acumulado). 0 = sin límite (determinista).
+ * Radios en celdas (distancia de Chebyshev a la celda del jugador).
+ */
+struct EnemyAIScheduler {
+    int nearRadius = AI_NEAR_RADIUS_TILES;
+    int midRadius = AI_MID_RADIUS_TILES;
+    uint32_t midInterval = AI_MID_INTERVAL_TICKS;
+    uint32_t farInterval = AI_FAR_INTERVAL_TICKS;
+    float budgetSeconds = ENEMY_AI_TIME_BUDGET_S;
+
+    uint32_t tick = 0;
+    std::vector<entt::entity> backlog;   // diferidos pendientes, en orden de llegada
+    size_t head = 0;                     // primer pendiente de backlog
+};
+
 void EnemyAISystem(entt::registry &registry, const Map &map, float deltaTime);
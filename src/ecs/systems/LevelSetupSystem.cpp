@@ -3,7 +3,12 @@
 #include "core/PlayerSelection.hpp"
 #include "core/PlayerSpriteCatalog.hpp"
 #include <algorithm>
+#include <cmath>
+#include <unordered_set>
 #include "ecs/Ecs.hpp"
+#include "ecs/ColliderGrid.hpp"
+#include "ecs/MechanismIndex.hpp"
+#include "objects/DistanceOracle.hpp"
 
 static int ComputeFramesForTexture(const Texture2D& tex) {
     if (tex.height <= 0) return 1;
@@ -11,8 +16,23 @@ static int ComputeFramesForTexture(const Texture2D& tex) {
     return frames > 0 ? frames : 1;
 }
 
+static void SpawnCellEntities_(entt::registry& registry, const Map& map, int x0, int y0, int x1, int y1,
+                               uint64_t seed, int chunk);
 
-void LevelSetupSystem(entt::registry& registry, Map& map) {
+void RequestLevelTextures() {
+    auto& rm = ResourceManager::Get();
+    for (const char* path : LEVEL_TEXTURES) {
+        rm.RequestTexture(path);
+    }
+
+    if (PlayerSelection::HasSelectedSpriteSet() &&
+        PlayerSelection::SelectedHasIdle() && PlayerSelection::SelectedHasWalk()) {
+        rm.RequestTexture(PlayerSelection::GetSelectedIdlePath());
+        rm.RequestTexture(PlayerSelection::GetSelectedWalkPath());
+    }
+}
+
+void LevelSetupSystem(entt::registry& registry, Map& map, uint64_t seed) {
     auto& rm = ResourceManager::Get();
     float tile = (float)map.tile();
 
@@ -20,6 +40,9 @@ void LevelSetupSystem(entt::registry& registry, Map& map) {
     // --- MECANISMOS ---
     for (auto m : map.getMechanisms()) {
         createMechanism_(registry, m, tile, mecId++);
+
+        // El target nace activo: bloquea su celda en el bitmap del mapa hasta que se pise el trigger
+        map.setMechanismBlocked(m.target.x, m.target.y, true);
     }
 
 
@@ -100,15 +123,146 @@ void LevelSetupSystem(entt::registry& registry, Map& map) {
         CollisionType::Player
     );
 
-    // --- ENTIDADES DEL MAPA ---
-    Texture2D spikeTex = rm.GetTexture("sprites/spikes.png");
-    Texture2D enemyIdleTex = rm.GetTexture("sprites/enemy/Skeleton/Idle.png");
-    Texture2D enemyWalkTex = rm.GetTexture("sprites/enemy/Skeleton/Walk.png");
-    Texture2D keyTex = rm.GetTexture("sprites/icons/Icons.png");
+    if (map.isChunked()) {
+        // --- MAPA POR CHUNKS ---
+        // Solo se crean las entidades de los chunks cercanos al jugador; el resto
+        // aparece y desaparece con ChunkStreamingSystem. El broadphase va primero
+        // porque las entidades de cada chunk se registran en él al crearse.
+        BuildColliderGrid(registry, map);
+        StreamMapChunks(registry, map, startGridPos, seed);
+    } else {
+        // --- ENTIDADES DEL MAPA ---
+        SpawnCellEntities_(registry, map, 0, 0, map.width(), map.height(), seed, -1);
+
+        // --- BROADPHASE ---
+        // Indexar colliders por tile para que CollisionSystem no recorra todo el registry
+        BuildColliderGrid(registry, map);
+    }
+
+    // --- ÍNDICE DE MECANISMOS ---
+    // Celda → trigger para que MechanismSystem solo reaccione a eventos de cambio de celda
+    BuildMechanismIndex(registry, map);
+
+    // --- DISTANCIAS ---
+    // Mapas pequeños: todas las distancias entre celdas para la IA, ya con los
+    // targets de mecanismo bloqueados
+    auto& oracle = registry.ctx().insert_or_assign(DistanceOracle{});
+    oracle.update(map);
+}
+
+
+static void createMechanism_( entt::registry& registry, const MechanismPair& m, float tile, int mechId) {
+    auto& rm = ResourceManager::Get();
+
+    //target
+    {
+        auto entity = registry.create();
+
+        float cx = m.target.x * tile + tile / 2.0f;
+        float cy = m.target.y * tile + tile / 2.0f;
+
+        registry.emplace<TransformComponent>( entity, Vector2{cx, cy}, Vector2{tile, tile});
+
+        registry.emplace<MechanismComponent>( entity, mechId, m.type, true);
+
+        registry.emplace<MechanismTargetComponent>(entity, mechId);
+
+        const Texture2D* tex = nullptr;
+        Rectangle srcActive{};
+        Rectangle srcInactive{};
+
+        switch (m.type) {
+            case MechanismType::DOOR:
+                tex = &rm.GetTexture(TEX_DOORS_LEVER);
+                srcActive   = { 0, 95, 32, 32 };
+                srcInactive = { 64, 95, 32, 32 };
+                break;
+
+            case MechanismType::TRAP:
+                tex = &rm.GetTexture(TEX_TRAP_SAW);
+                srcActive   = { 0, 26, 32, 32 };
+                srcInactive = { 336, 192, 50, 30 };
+                break;
+
+            case MechanismType::BRIDGE:
+                tex = &rm.GetTexture(TEX_FIRE_TRAP);
+                srcActive   = { 715, 128, 65, 65 };
+                srcInactive = { 45, 128, 65, 65 };
+                break;
+
+            case MechanismType::LEVER:
+                tex = &rm.GetTexture(TEX_DOORS_LEVER);
+                srcActive   = { 0, 64, 32, 32 };
+                srcInactive = { 64, 64, 32, 32 };
+                break;
+
+            default:
+                tex = &rm.GetTexture(TEX_DOORS_LEVER);
+                srcActive   = { 0, 95, 32, 32 };
+                srcInactive = { 64, 95, 32, 32 };
+                break;
+        }
+
+        registry.emplace<SpriteComponent>(entity, *tex, Vector2{0,0}, 1.0f);
+        registry.emplace<ManualSpriteComponent>(entity, srcActive, srcInactive);
+    }
+
+    //triger
+    {
+        auto entity = registry.create();
+
+        float cx = m.trigger.x * tile + tile / 2.0f;
+        float cy = m.trigger.y * tile + tile / 2.0f;
+
+        registry.emplace<TransformComponent>(entity, Vector2{cx, cy}, Vector2{tile, tile});
+
+        registry.emplace<MechanismComponent>(entity, mechId, m.type, true);
+
+        registry.emplace<MechanismTriggerComponent>(entity, mechId);
+
+        auto& tex = rm.GetTexture(TEX_DOORS_LEVER);
+
+        Rectangle srcActive   = { 30, 174, 18, 18 };
+        Rectangle srcInactive = { 62, 174, 18, 18 };
+
+        registry.emplace<SpriteComponent>(entity, tex, Vector2{0, 0}, 0.7f);
+        registry.emplace<ManualSpriteComponent>(entity, srcActive, srcInactive);
+    }
+}
 
-   for (int y = 0; y < map.height(); y++) {
-        for (int x = 0; x < map.width(); x++) {
+/**
+ * SpawnCellEntities_
+ *  - Pinchos, enemigos y llaves de las celdas [x0,x1) x [y0,y1), fila a fila
+ *    (el orden fija los ids de entidad y con ellos el flujo aleatorio de cada enemigo).
+ *  - chunk >= 0 (mapas por chunks): cada entidad lleva ChunkMemberComponent y
+ *    se registra en el ColliderGrid del contexto, que ya existe. Se saltan las
+ *    celdas cuya entidad sigue viva en otro chunk (originCell).
+ */
+static void SpawnCellEntities_(entt::registry& registry, const Map& map, int x0, int y0, int x1, int y1,
+                               uint64_t seed, int chunk) {
+    std::vector<entt::entity> spawned;
+
+    // Mapas por chunks: las celdas cuya entidad sigue viva (se alejó del chunk
+    // antes de descargarlo) no vuelven a crearla
+    std::unordered_set<int> alive;
+    if (chunk >= 0) {
+        auto members = registry.view<const ChunkMemberComponent>();
+        for (auto entity : members) {
+            const int origin = members.get<const ChunkMemberComponent>(entity).originCell;
+            if (origin >= 0 && map.chunkOf(origin % map.width(), origin / map.width()) == chunk) alive.insert(origin);
+        }
+    }
+
+    auto& rm = ResourceManager::Get();
+    Texture2D spikeTex = rm.GetTexture(TEX_SPIKES);
+    Texture2D enemyIdleTex = rm.GetTexture(TEX_SKELETON_IDLE);
+    Texture2D enemyWalkTex = rm.GetTexture(TEX_SKELETON_WALK);
+    Texture2D keyTex = rm.GetTexture(TEX_ICONS);
+
+    for (int y = y0; y < y1; y++) {
+        for (int x = x0; x < x1; x++) {
             char cell = map.at(x, y);
+            if (!alive.empty() && alive.count(map.index(x, y))) continue;
 
             // Calculamos posición central del tile en píxeles
             float centerX = x * map.tile() + map.tile() / 2.0f;
@@ -120,6 +274,7 @@ void LevelSetupSystem(entt::registry& registry, Map& map) {
             // --- CASO 1: PINCHOS (^) ---
             if (cell == '^') {
                 auto entity = registry.create();
+                spawned.push_back(entity);
                 registry.emplace<TransformComponent>(entity, pos, size);
 
                 manualOffset = Vector2{0.5f, 1.0f};
@@ -146,6 +301,7 @@ void LevelSetupSystem(entt::registry& registry, Map& map) {
             // --- CASO 2: ENEMIGOS (E) ---
             else if (cell == 'E') {
                 auto entity = registry.create();
+                spawned.push_back(entity);
                 registry.emplace<TransformComponent>(entity, pos, size);
 
                 // Configuración visual del enemigo (igual que el player: 6 frames, offset 8,-8)
@@ -157,6 +313,11 @@ void LevelSetupSystem(entt::registry& registry, Map& map) {
                 // Movimiento (IA)
                 registry.emplace<MovementComponent>(entity, 40.0f); // Velocidad más lenta que el jugador
                 registry.emplace<EnemyAIComponent>(entity);
+                registry.emplace<EnemyPathComponent>(entity);
+                registry.emplace<EnemyAIScheduleComponent>(entity);
+                // Flujo aleatorio propio: semilla del nivel + id de la entidad
+                registry.emplace<RandomStreamComponent>(entity,
+                    RandomStream{ RandomStream::KeyFor(seed, (uint64_t)entt::to_integral(entity)), 0 });
 
                 // Collider (90% del tile)
                 float hitSize = map.tile() * 0.9f;
@@ -169,6 +330,7 @@ void LevelSetupSystem(entt::registry& registry, Map& map) {
             // --- CASO 3: LLAVES (K) ---
             if (cell == 'K') {
                 auto entity = registry.create();
+                spawned.push_back(entity);
                 registry.emplace<TransformComponent>(entity, pos, size);
 
                 // solo textura de llave
@@ -191,84 +353,101 @@ void LevelSetupSystem(entt::registry& registry, Map& map) {
             }
         }
     }
-}
-
-
-static void createMechanism_( entt::registry& registry, const MechanismPair& m, float tile, int mechId) {
-    auto& rm = ResourceManager::Get();
-
-    //target
-    {
-        auto entity = registry.create();
-
-        float cx = m.target.x * tile + tile / 2.0f;
-        float cy = m.target.y * tile + tile / 2.0f;
-
-        registry.emplace<TransformComponent>( entity, Vector2{cx, cy}, Vector2{tile, tile});
-
-        registry.emplace<MechanismComponent>( entity, mechId, m.type, true);
-
-        registry.emplace<MechanismTargetComponent>(entity, mechId);
-
-        const Texture2D* tex = nullptr;
-        Rectangle srcActive{};
-        Rectangle srcInactive{};
 
-        switch (m.type) {
-            case MechanismType::DOOR:
-                tex = &rm.GetTexture("sprites/mecs/doors_lever_chest_animation.png");
-                srcActive   = { 0, 95, 32, 32 };
-                srcInactive = { 64, 95, 32, 32 };
-                break;
-
-            case MechanismType::TRAP:
-                tex = &rm.GetTexture("sprites/mecs/trap_saw.png");
-                srcActive   = { 0, 26, 32, 32 };
-                srcInactive = { 336, 192, 50, 30 };
-                break;
+    if (chunk < 0) return;
+
+    auto* grid = registry.ctx().find<ColliderGrid>();
+    const float tile = (float)map.tile();
+    for (auto entity : spawned) {
+        const Vector2 pos = registry.get<TransformComponent>(entity).position;
+        registry.emplace<ChunkMemberComponent>(entity, chunk, map.index((int)(pos.x / tile), (int)(pos.y / tile)));
+        if (grid && registry.all_of<ColliderComponent>(entity)) {
+            const int cell = grid->cellOf(pos);
+            grid->insert(entity, cell);
+            registry.emplace<ColliderCellComponent>(entity, cell);
+        }
+    }
+}
 
-            case MechanismType::BRIDGE:
-                tex = &rm.GetTexture("sprites/mecs/fire_trap.png");
-                srcActive   = { 715, 128, 65, 65 };
-                srcInactive = { 45, 128, 65, 65 };
-                break;
+void SpawnChunkEntities(entt::registry& registry, const Map& map, int chunk, uint64_t seed) {
+    const int x0 = (chunk % map.chunksX()) * MAP_CHUNK_SIZE;
+    const int y0 = (chunk / map.chunksX()) * MAP_CHUNK_SIZE;
+    SpawnCellEntities_(registry, map, x0, y0, std::min(x0 + MAP_CHUNK_SIZE, map.width()),
+                       std::min(y0 + MAP_CHUNK_SIZE, map.height()), seed, chunk);
+}
 
-            case MechanismType::LEVER:
-                tex = &rm.GetTexture("sprites/mecs/doors_lever_chest_animation.png");
-                srcActive   = { 0, 64, 32, 32 };
-                srcInactive = { 64, 64, 32, 32 };
-                break;
+void DespawnChunkEntities(entt::registry& registry, int chunk) {
+    std::vector<entt::entity> doomed;
+    auto view = registry.view<const ChunkMemberComponent>();
+    for (auto entity : view) {
+        if (view.get<const ChunkMemberComponent>(entity).chunk == chunk) doomed.push_back(entity);
+    }
 
-            default:
-                tex = &rm.GetTexture("sprites/mecs/doors_lever_chest_animation.png");
-                srcActive   = { 0, 95, 32, 32 };
-                srcInactive = { 64, 95, 32, 32 };
-                break;
+    auto* grid = registry.ctx().find<ColliderGrid>();
+    for (auto entity : doomed) {
+        if (const auto* cell = registry.try_get<ColliderCellComponent>(entity); cell && grid) {
+            grid->remove(entity, cell->cell);
         }
-
-        registry.emplace<SpriteComponent>(entity, *tex, Vector2{0,0}, 1.0f);
-        registry.emplace<ManualSpriteComponent>(entity, srcActive, srcInactive);
+        registry.destroy(entity);
     }
+}
 
-    //triger
-    {
-        auto entity = registry.create();
-
-        float cx = m.trigger.x * tile + tile / 2.0f;
-        float cy = m.trigger.y * tile + tile / 2.0f;
-
-        registry.emplace<TransformComponent>(entity, Vector2{cx, cy}, Vector2{tile, tile});
+/**
+ * StreamMapChunks
+ *  - Carga (y puebla) los chunks a MAP_CHUNK_LOAD_RADIUS o menos del chunk de
+ *    'center' y los marca como recién usados.
+ *  - Si quedan más de MAP_CHUNK_MAX_RESIDENT cargados, descarga los de fuera
+ *    del radio empezando por el que lleva más tiempo sin usarse (LRU).
+ */
+void StreamMapChunks(entt::registry& registry, Map& map, IVec2 center, uint64_t seed) {
+    if (!map.isChunked()) return;
+
+    const int centerX = std::clamp(center.x, 0, map.width() - 1) / MAP_CHUNK_SIZE;
+    const int centerY = std::clamp(center.y, 0, map.height() - 1) / MAP_CHUNK_SIZE;
+    auto inRadius = [&](int chunk) {
+        return std::abs(chunk % map.chunksX() - centerX) <= MAP_CHUNK_LOAD_RADIUS &&
+               std::abs(chunk / map.chunksX() - centerY) <= MAP_CHUNK_LOAD_RADIUS;
+    };
+
+    for (int cy = std::max(0, centerY - MAP_CHUNK_LOAD_RADIUS);
+         cy <= std::min(map.chunksY() - 1, centerY + MAP_CHUNK_LOAD_RADIUS); ++cy) {
+        for (int cx = std::max(0, centerX - MAP_CHUNK_LOAD_RADIUS);
+             cx <= std::min(map.chunksX() - 1, centerX + MAP_CHUNK_LOAD_RADIUS); ++cx) {
+            const int chunk = cy * map.chunksX() + cx;
+            if (map.loadChunk(chunk)) SpawnChunkEntities(registry, map, chunk, seed);
+            map.touchChunk(chunk);
+        }
+    }
 
-        registry.emplace<MechanismComponent>(entity, mechId, m.type, true);
+    if (map.residentChunks().size() <= MAP_CHUNK_MAX_RESIDENT) return;
 
-        registry.emplace<MechanismTriggerComponent>(entity, mechId);
+    std::vector<int> victims;
+    for (int chunk : map.residentChunks()) {
+        if (!inRadius(chunk)) victims.push_back(chunk);
+    }
+    std::sort(victims.begin(), victims.end(),
+              [&](int a, int b) { return map.chunkLastUse(a) < map.chunkLastUse(b); });
+    bool evicted = false;
+    for (int chunk : victims) {
+        if (map.residentChunks().size() <= MAP_CHUNK_MAX_RESIDENT) break;
+        DespawnChunkEntities(registry, chunk);
+        map.unloadChunk(chunk);
+        evicted = true;
+    }
 
-        auto& tex = rm.GetTexture("sprites/mecs/doors_lever_chest_animation.png");
+    // Las entidades destruidas fuera de su chunk de origen vuelven a él si sigue
+    // cargado (si no, al recargarlo): el número de entidades no cambia
+    if (evicted) {
+        for (int chunk : map.residentChunks()) SpawnChunkEntities(registry, map, chunk, seed);
+    }
+}
 
-        Rectangle srcActive   = { 30, 174, 18, 18 };
-        Rectangle srcInactive = { 62, 174, 18, 18 };
+void ChunkStreamingSystem(entt::registry& registry, Map& map, uint64_t seed) {
+    if (!map.isChunked()) return;
 
-        registry.emplace<SpriteComponent>(entity, tex, Vector2{0, 0}, 0.7f);
-        registry.emplace<ManualSpriteComponent>(entity, srcActive, srcInactive);
-    }
+    auto view = registry.view<const TransformComponent, const PlayerInputComponent>();
+    if (view.begin() == view.end()) return;
+    const auto& pos = view.get<const TransformComponent>(*view.begin()).position;
+    const float tile = (float)map.tile();
+    StreamMapChunks(registry, map, IVec2{ (int)std::floor(pos.x / tile), (int)std::floor(pos.y / tile) }, seed);
 }
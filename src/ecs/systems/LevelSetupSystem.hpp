@@ -2,7 +2,30 @@
 #include <entt/entt.hpp>
 #include "objects/Map.hpp"
 
-void LevelSetupSystem(entt::registry& registry, Map& map);
+// 'seed': semilla del nivel; de ella sale el flujo aleatorio de cada enemigo.
+// En mapas por chunks solo puebla los chunks cercanos al jugador (StreamMapChunks).
+void LevelSetupSystem(entt::registry& registry, Map& map, uint64_t seed = 0);
+
+// Mapas por chunks: crea las entidades (pinchos, enemigos, llaves) de un chunk ya
+// cargado, marcadas con ChunkMemberComponent y registradas en el ColliderGrid.
+// Solo crea las que faltan: la de una celda cuya entidad sigue viva no se repite.
+void SpawnChunkEntities(entt::registry& registry, const Map& map, int chunk, uint64_t seed);
+
+// Destruye las entidades que están en el chunk según su ChunkMemberComponent.
+// Las que nacieron en él pero están en otro chunk siguen vivas; las de otros
+// chunks que estaban en él vuelven a crearse en su celda de origen (StreamMapChunks).
+void DespawnChunkEntities(entt::registry& registry, int chunk);
+
+// Carga y puebla los chunks alrededor de la celda 'center' y descarga (LRU) los
+// que sobren por encima de MAP_CHUNK_MAX_RESIDENT. No hace nada en mapas normales.
+void StreamMapChunks(entt::registry& registry, Map& map, IVec2 center, uint64_t seed);
+
+// StreamMapChunks alrededor del jugador; se llama en cada tick (la vista sigue al jugador).
+void ChunkStreamingSystem(entt::registry& registry, Map& map, uint64_t seed);
+
+// Pide en segundo plano las texturas que usa LevelSetupSystem (y el mapa), LEVEL_TEXTURES, para que
+// al montar el nivel solo quede la subida a GPU y no la decodificación de los PNG.
+void RequestLevelTextures();
 
 inline const char* MechanismTypeToString(MechanismType type) {
     switch (type) {
@@ -43,15 +43,15 @@ void InputSystem(entt::registry &registry, const Map &map) {
         int targetX = cellX + dx;
         int targetY = cellY + dy;
 
-        if (targetX < 0 || targetX >= map.width() || targetY < 0 || targetY >= map.height()) {
+        if (!map.inBounds(targetX, targetY)) {
             continue;
         }
 
-        if (!cheats.noClip && map.at(targetX, targetY) == '#') {
+        if (!cheats.noClip && map.isWall(targetX, targetY)) {
             continue;
         }
 
-        if (!cheats.noClip && IsMechanismBlockingCell(registry, targetX, targetY)) {
+        if (!cheats.noClip && IsMechanismBlockingCell(map, targetX, targetY)) {
             continue;
         }
 
@@ -1,104 +1,137 @@
 #include "ecs/systems/RenderSystems.hpp"
+#include "ecs/RenderQueue.hpp"
 #include <cmath>
 
 extern "C" {
     #include <raylib.h>
 }
 
-void RenderSystem(entt::registry &registry, float offset_x, float offset_y, float tileSize) {
-    auto view = registry.view<const TransformComponent, const SpriteComponent>();
-
-    for (auto entity : view) {
-        const auto &transform = view.get<const TransformComponent>(entity);
-        const auto &sprite = view.get<const SpriteComponent>(entity);
-
-        //PARPADEO JUGADOR 
-                if (registry.all_of<PlayerStateComponent>(entity)) {
-            const auto &state = registry.get<PlayerStateComponent>(entity);
-            if (state.invulnerableTimer > 0.0f &&
-                state.invulnerableTimer < state.invulnerableDuration) {
-
-                float blink = std::fmod(state.invulnerableTimer, 0.2f);
-                if (blink < 0.1f) {
-                    continue; // no dibujar este frame
-                }
-            }
-        }
+// Calcula el rectángulo destino escalado al tile y encola el comando de dibujo.
+static void PushSprite(RenderQueue &queue, Vector2 position, const SpriteComponent &sprite,
+                       Rectangle src, float frameW, float frameH,
+                       float offset_x, float offset_y, float tileSize, RenderLayer layer,
+                       const Rectangle *visible) {
+    // Culling: fuera del rectángulo visible (ya incluye margen) no se encola
+    if (visible && !CheckCollisionPointRec(position, *visible)) return;
+
+    //direccion de dibujo
+    if (sprite.flipX) {
+        src.width = -src.width;
+    }
 
-        
-        //variables para el escalado ancho/alto al tileSize
-        float frameW = 0.0;
-        float frameH = 0.0f;
-        Rectangle src;
+    //escala
+    float baseScale = sprite.customScale != 0.0f ? sprite.customScale : 1.5f;
+    float tileScale = (tileSize / frameH) * baseScale;
 
-        //1 SPRITE MANUAL 
-        if (registry.all_of<ManualSpriteComponent>(entity)) {
-            const auto &manual = registry.get<ManualSpriteComponent>(entity);
+    Rectangle destRec = {
+        position.x + offset_x + sprite.visualOffset.x,
+        position.y + offset_y + sprite.visualOffset.y,
+        frameW * tileScale,
+        frameH * tileScale
+    };
 
-            // Sprite fijo
-            if (manual.src.width > 0.0f) {
-                src = manual.src;
-            }
-            // Sprite activo / inactivo
-            else {
-                bool active = true;
+    Vector2 origin = { destRec.width / 2.0f, destRec.height / 2.0f };
 
-                if (registry.all_of<SpikeComponent>(entity)) {
-                    active = registry.get<SpikeComponent>(entity).active;
-                } else if (registry.all_of<MechanismComponent>(entity)) {
-                    active = registry.get<MechanismComponent>(entity).active;
-                }
+    // El "pie" del sprite decide quién tapa a quién dentro de la misma capa
+    queue.push(sprite.texture, src, destRec, origin, layer, position.y);
+}
 
-                src = active ? manual.srcActive : manual.srcInactive;
-            }
+Vector2 InterpolatedPosition(const entt::registry &registry, entt::entity entity,
+                             const TransformComponent &transform, float alpha) {
+    const auto *previous = registry.try_get<PreviousTransformComponent>(entity);
+    if (!previous) return transform.position;
+    return {
+        previous->position.x + (transform.position.x - previous->position.x) * alpha,
+        previous->position.y + (transform.position.y - previous->position.y) * alpha
+    };
+}
 
-            frameW = src.width;
-            frameH = src.height;
-        
-        //2 SPRITE GRID CLIP
-        } else if (registry.all_of<GridClipComponent>(entity)) {
-            const auto &grid = registry.get<GridClipComponent>(entity);
-
-            if (grid.fixedFrameSize.x > 0.0f && grid.fixedFrameSize.y > 0.0f) {
-                frameW = grid.fixedFrameSize.x;
-                frameH = grid.fixedFrameSize.y;
-            } else {
-                frameW = sprite.texture.width / (float)grid.numFrames;
-                frameH = sprite.texture.height;
+void RenderSystem(entt::registry &registry, float offset_x, float offset_y, float tileSize,
+                  const Rectangle *visible, float alpha) {
+    auto &queue = registry.ctx().emplace<RenderQueue>();
+    queue.clear();
+
+    //PARPADEO JUGADOR: se resuelve antes para no consultar componentes dentro de los bucles
+    entt::entity hidden = entt::null;
+    auto stateView = registry.view<const PlayerStateComponent>();
+    for (auto entity : stateView) {
+        const auto &state = stateView.get<const PlayerStateComponent>(entity);
+        if (state.invulnerableTimer > 0.0f &&
+            state.invulnerableTimer < state.invulnerableDuration) {
+
+            float blink = std::fmod(state.invulnerableTimer, 0.2f);
+            if (blink < 0.1f) {
+                hidden = entity; // no dibujar este frame
             }
-
-            src = {
-                frameW * grid.currentFrame,
-                frameH * grid.currentRow,
-                frameW,
-                frameH
-            };
-        
-        //3 SPRITE COMPLETO
-        } else {
-            frameW = (float)sprite.texture.width;
-            frameH = (float)sprite.texture.height;
-            src = {0, 0, frameW, frameH};
         }
+    }
 
-        //direccion de dibujo
-        if (sprite.flipX) {
-            src.width = -src.width;
+    //1 SPRITE MANUAL ACTIVO/INACTIVO: PINCHOS
+    auto spikeView = registry.view<const TransformComponent, const SpriteComponent,
+                                   const ManualSpriteComponent, const SpikeComponent>();
+    spikeView.each([&](auto entity, const auto &transform, const auto &sprite, const auto &manual, const auto &spike) {
+        if (entity == hidden) return;
+        Rectangle src = manual.src.width > 0.0f ? manual.src
+                       : (spike.active ? manual.srcActive : manual.srcInactive);
+        PushSprite(queue, transform.position, sprite, src, src.width, src.height, offset_x, offset_y, tileSize, RenderLayer::Props, visible);
+    });
+
+    //1 SPRITE MANUAL ACTIVO/INACTIVO: MECANISMOS
+    auto mechView = registry.view<const TransformComponent, const SpriteComponent,
+                                  const ManualSpriteComponent, const MechanismComponent>(entt::exclude<SpikeComponent>);
+    mechView.each([&](auto entity, const auto &transform, const auto &sprite, const auto &manual, const auto &mech) {
+        if (entity == hidden) return;
+        Rectangle src = manual.src.width > 0.0f ? manual.src
+                       : (mech.active ? manual.srcActive : manual.srcInactive);
+        PushSprite(queue, transform.position, sprite, src, src.width, src.height, offset_x, offset_y, tileSize, RenderLayer::Props, visible);
+    });
+
+    //1 SPRITE MANUAL FIJO (llaves...)
+    auto manualView = registry.view<const TransformComponent, const SpriteComponent,
+                                    const ManualSpriteComponent>(entt::exclude<SpikeComponent, MechanismComponent>);
+    manualView.each([&](auto entity, const auto &transform, const auto &sprite, const auto &manual) {
+        if (entity == hidden) return;
+        Rectangle src = manual.src.width > 0.0f ? manual.src : manual.srcActive;
+        PushSprite(queue, transform.position, sprite, src, src.width, src.height, offset_x, offset_y, tileSize, RenderLayer::Props, visible);
+    });
+
+    //2 SPRITE GRID CLIP
+    auto gridView = registry.view<const TransformComponent, const SpriteComponent,
+                                  const GridClipComponent>(entt::exclude<ManualSpriteComponent>);
+    gridView.each([&](auto entity, const auto &transform, const auto &sprite, const auto &grid) {
+        if (entity == hidden) return;
+
+        float frameW = 0.0f;
+        float frameH = 0.0f;
+        if (grid.fixedFrameSize.x > 0.0f && grid.fixedFrameSize.y > 0.0f) {
+            frameW = grid.fixedFrameSize.x;
+            frameH = grid.fixedFrameSize.y;
+        } else {
+            frameW = sprite.texture.width / (float)grid.numFrames;
+            frameH = sprite.texture.height;
         }
 
-        //escala
-        float baseScale = sprite.customScale != 0.0f ? sprite.customScale : 1.5f;
-        float tileScale = (tileSize / frameH) * baseScale;
-        
-        Rectangle destRec = {
-            transform.position.x + offset_x + sprite.visualOffset.x,
-            transform.position.y + offset_y + sprite.visualOffset.y,
-            frameW * tileScale,
-            frameH * tileScale
+        Rectangle src = {
+            frameW * grid.currentFrame,
+            frameH * grid.currentRow,
+            frameW,
+            frameH
         };
-
-        Vector2 origin = { destRec.width / 2.0f, destRec.height / 2.0f };
-
-        DrawTexturePro(sprite.texture, src, destRec, origin, 0.0f, WHITE);
-    }
+        PushSprite(queue, InterpolatedPosition(registry, entity, transform, alpha), sprite, src, frameW, frameH, offset_x, offset_y, tileSize, RenderLayer::Actors, visible);
+    });
+
+    //3 SPRITE COMPLETO
+    auto fullView = registry.view<const TransformComponent, const SpriteComponent>(
+        entt::exclude<ManualSpriteComponent, GridClipComponent>);
+    fullView.each([&](auto entity, const auto &transform, const auto &sprite) {
+        if (entity == hidden) return;
+        float frameW = (float)sprite.texture.width;
+        float frameH = (float)sprite.texture.height;
+        PushSprite(queue, InterpolatedPosition(registry, entity, transform, alpha), sprite, Rectangle{0, 0, frameW, frameH}, frameW, frameH,
+                   offset_x, offset_y, tileSize, RenderLayer::Actors, visible);
+    });
+
+    // Orden por capa / y / textura y envío en bloque
+    queue.sort();
+    queue.submit();
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include <entt/entt.hpp>
 #include "ecs/components/World/TransformComponent.hpp"
+#include "ecs/components/World/PreviousTransformComponent.hpp"
 #include "ecs/components/World/SpriteComponent.hpp"
 #include "ecs/components/World/ManualSpriteComponent.hpp"
 #include "ecs/components/World/GridClipComponent.hpp"
@@ -8,5 +9,13 @@
 #include "ecs/components/World/MechanismComponent.hpp"
 #include "ecs/components/Player/PlayerStateComponent.hpp"
 
-void RenderSystem(entt::registry &registry, float offset_x, float offset_y, float tileSize);
+// 'visible' (opcional): rectángulo en píxeles de mundo; las entidades fuera no se dibujan.
+// 'alpha': fracción del tick de simulación ya transcurrida; las entidades con
+// PreviousTransformComponent se dibujan interpoladas entre el tick anterior y el actual.
+void RenderSystem(entt::registry &registry, float offset_x, float offset_y, float tileSize,
+                  const Rectangle *visible = nullptr, float alpha = 1.0f);
+
+// Posición de dibujo de una entidad: interpolada si tiene snapshot del tick anterior
+Vector2 InterpolatedPosition(const entt::registry &registry, entt::entity entity,
+                             const TransformComponent &transform, float alpha);
 void RenderMechanismSystem(entt::registry &registry, int offset_x, int offset_y);
@@ -1,12 +1,38 @@
 #include "ecs/systems/WorldSystems.hpp"
+#include "ecs/ColliderGrid.hpp"
+#include "ecs/CellEvents.hpp"
+#include "ecs/MechanismIndex.hpp"
 #include <cmath>
+#include <vector>
+
+void SnapshotTransformSystem(entt::registry &registry) {
+    // Entidades móviles nuevas: se les da snapshot fuera del bucle de la vista
+    static std::vector<entt::entity> fresh;
+    fresh.clear();
+    auto freshView = registry.view<TransformComponent, MovementComponent>(entt::exclude<PreviousTransformComponent>);
+    for (auto entity : freshView) fresh.push_back(entity);
+    for (auto entity : fresh) {
+        registry.emplace<PreviousTransformComponent>(entity, registry.get<TransformComponent>(entity).position);
+    }
+
+    auto view = registry.view<const TransformComponent, PreviousTransformComponent>();
+    view.each([](const auto &transform, auto &previous) {
+        previous.position = transform.position;
+    });
+}
 
-void MovementSystem(entt::registry &registry, float deltaTime) {
+void MovementSystem(entt::registry &registry, const Map &map, float deltaTime) {
     auto view = registry.view<TransformComponent, MovementComponent>();
+    auto *grid = registry.ctx().find<ColliderGrid>();
+    auto &events = registry.ctx().emplace<CellEventQueue>();
+    float tileSize = (float)map.tile();
 
-    view.each([deltaTime](auto &transform, auto &move) {
+    view.each([&registry, &map, grid, &events, tileSize, deltaTime](auto entity, auto &transform, auto &move) {
         if (!move.isMoving) return;
 
+        const int oldCellX = (int)std::floor(transform.position.x / tileSize);
+        const int oldCellY = (int)std::floor(transform.position.y / tileSize);
+
         move.progress += deltaTime;
         float t = move.progress / move.duration;
 
@@ -18,6 +44,31 @@ void MovementSystem(entt::registry &registry, float deltaTime) {
             transform.position.x = move.startPos.x + (move.targetPos.x - move.startPos.x) * t;
             transform.position.y = move.startPos.y + (move.targetPos.y - move.startPos.y) * t;
         }
+
+        const int cellX = (int)std::floor(transform.position.x / tileSize);
+        const int cellY = (int)std::floor(transform.position.y / tileSize);
+        if (cellX == oldCellX && cellY == oldCellY) return;
+
+        // Cruce de tile: avisar a los sistemas basados en eventos (mecanismos)
+        events.entered.push_back({ entity, cellX, cellY });
+
+        // Broadphase: reubicar en el ColliderGrid solo al cruzar el borde de un tile
+        if (grid) {
+            if (auto *cc = registry.try_get<ColliderCellComponent>(entity)) {
+                int cell = grid->cellOf(transform.position);
+                if (cell != cc->cell) {
+                    grid->remove(entity, cc->cell);
+                    grid->insert(entity, cell);
+                    cc->cell = cell;
+                }
+            }
+        }
+
+        // Mapas por chunks: la entidad pasa al chunk en el que está, para que se
+        // descargue con él y no con el chunk en el que nació
+        if (auto *member = registry.try_get<ChunkMemberComponent>(entity)) {
+            member->chunk = map.chunkOf(cellX, cellY);
+        }
     });
 }
 
@@ -74,63 +125,48 @@ void SpikeSystem(entt::registry &registry, float deltaTime) {
     }
 }
 
-void MechanismSystem(entt::registry &registry, const Map &map) {
-    auto playerView = registry.view<const TransformComponent, PlayerInputComponent>();
-    if(!playerView) return;
+void MechanismSystem(entt::registry &registry, Map &map) {
+    // Solo hay trabajo si alguna entidad ha cambiado de celda este frame
+    auto &events = registry.ctx().emplace<CellEventQueue>();
+    if (events.entered.empty()) return;
 
-    auto playerEntity = *playerView.begin();
-    const auto &pTrans = playerView.get<const TransformComponent>(playerEntity);
+    auto *index = registry.ctx().find<MechanismIndex>();
+    if (!index) index = &BuildMechanismIndex(registry, map);
 
     float tileSize = (float)map.tile();
-    int pCellX = (int)std::floor(pTrans.position.x / tileSize);
-    int pCellY = (int)std::floor(pTrans.position.y / tileSize);
 
-    // 1) detectar si el player está pisando algún TRIGGER activo
-    int triggeredId = -1;
+    for (const auto &ev : events.entered) {
+        // 1) ¿hay un TRIGGER activo en la celda a la que se ha entrado?
+        MechanismId triggeredId = index->triggerAt(ev.cellX, ev.cellY);
+        if (triggeredId == MechanismIndex::NONE) continue;
 
-    auto triggerView = registry.view<const MechanismComponent, const MechanismTriggerComponent, const TransformComponent>();
-    for (auto e : triggerView) {
-        const auto &mech = triggerView.get<const MechanismComponent>(e);
-        if (!mech.active) continue;
+        // Solo el jugador activa mecanismos
+        if (!registry.valid(ev.entity) || !registry.all_of<PlayerInputComponent>(ev.entity)) continue;
 
-        const auto &t = triggerView.get<const TransformComponent>(e);
-        int cx = (int)std::floor(t.position.x / tileSize);
-        int cy = (int)std::floor(t.position.y / tileSize);
+        // 2) desactivar TODO lo que pertenezca a ese id (trigger + target)
+        //    y liberar en el bitmap del mapa la celda de los targets
+        for (auto e : index->entities(triggeredId)) {
+            auto *mech = registry.try_get<MechanismComponent>(e);
+            if (!mech) continue;
 
-        if (cx == pCellX && cy == pCellY) {
-            triggeredId = mech.id;     // <-- asumo que MechanismComponent tiene 'int id'
-            break;
-        }
-    }
-
-    if (triggeredId == -1) return;
+            mech->active = false;
 
-    // 2) desactivar TODO lo que pertenezca a ese id (trigger + target)
-    auto mechView = registry.view<MechanismComponent>();
-    for (auto e : mechView) {
-        auto &mech = mechView.get<MechanismComponent>(e);
-        if (mech.id == triggeredId) {
-            mech.active = false;
+            if (registry.all_of<MechanismTargetComponent>(e)) {
+                const auto &tr = registry.get<TransformComponent>(e);
+                map.setMechanismBlocked((int)std::floor(tr.position.x / tileSize),
+                                        (int)std::floor(tr.position.y / tileSize), false);
+            }
         }
-    }
-}
-
 
-bool IsMechanismBlockingCell(entt::registry &registry, int cellX, int cellY) {
-    float tileSize = TILE_SIZE;
-    // solo targets bloquean (la puerta/trampa/puente), el trigger no
-    auto view = registry.view<const MechanismComponent, const MechanismTargetComponent, const TransformComponent>();
-
-    for (auto entity : view) {
-        const auto &mech = view.get<const MechanismComponent>(entity);
-        if (!mech.active) continue;
+        // El trigger ya está gastado: volver a pisarlo no hace nada
+        index->setTrigger(ev.cellX, ev.cellY, MechanismIndex::NONE);
+    }
 
-        const auto &tr = view.get<const TransformComponent>(entity);
+    events.entered.clear();
+}
 
-        int tx = (int)std::floor(tr.position.x / tileSize);
-        int ty = (int)std::floor(tr.position.y / tileSize);
 
-        if (tx == cellX && ty == cellY) return true;
-    }
-    return false;
+// Consulta O(1) sobre el bitmap de celdas bloqueadas que mantiene el Map
+bool IsMechanismBlockingCell(const Map &map, int cellX, int cellY) {
+    return map.isMechanismBlocked(cellX, cellY);
 }
\ No newline at end of file
@@ -3,16 +3,21 @@
 #include "objects/Map.hpp"
 #include "ecs/components/World/TransformComponent.hpp"
 #include "ecs/components/World/MovementComponent.hpp"
+#include "ecs/components/World/PreviousTransformComponent.hpp"
 #include "ecs/components/World/SpriteComponent.hpp"
 #include "ecs/components/World/GridClipComponent.hpp"
 #include "ecs/components/World/AnimationComponent.hpp"
 #include "ecs/components/World/SpikeComponent.hpp"
 #include "ecs/components/World/MechanismComponent.hpp"
 #include "ecs/components/World/ColliderComponent.hpp"
+#include "ecs/components/World/ChunkMemberComponent.hpp"
+#include "ecs/components/World/ColliderCellComponent.hpp"
 #include "ecs/components/Player/PlayerInputComponent.hpp"
 
-bool IsMechanismBlockingCell(entt::registry &registry, int cellX, int cellY);
-void MovementSystem(entt::registry &registry, float deltaTime);
+bool IsMechanismBlockingCell(const Map &map, int cellX, int cellY);
+// Guarda la posición de cada entidad móvil antes del tick (para interpolar el render)
+void SnapshotTransformSystem(entt::registry &registry);
+void MovementSystem(entt::registry &registry, const Map &map, float deltaTime);
 void AnimationSystem(entt::registry &registry, float deltaTime);
 void SpikeSystem(entt::registry &registry, float deltaTime);
-void MechanismSystem(entt::registry &registry, const Map &map);
+void MechanismSystem(entt::registry &registry, Map &map);
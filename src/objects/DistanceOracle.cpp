@@ -0,0 +1,163 @@
+#include "DistanceOracle.hpp"
+#include "core/JobSystem.hpp"
+
+namespace {
+    // Mismo orden de vecinos que FlowField y EnemyAISystem: abajo, arriba, derecha, izquierda.
+    const int kDx[4] = {0, 0, 1, -1};
+    const int kDy[4] = {1, -1, 0, 0};
+}
+
+bool DistanceOracle::isStale(const Map& map) const {
+    return !_valid ||
+           map.width() != _w || map.height() != _h ||
+           map.navRevision() != _revision;
+}
+
+bool DistanceOracle::update(const Map& map, size_t maxCells) {
+    if (!isStale(map)) return false;
+
+    _w = map.width();
+    _h = map.height();
+    _revision = map.navRevision();
+    _ready = static_cast<size_t>(_w) * static_cast<size_t>(_h) <= maxCells;
+    if (_ready) {
+        _build(map);
+    } else {
+        // Mapa grande: no se reserva nada, la IA usa el FlowField
+        _nodeOf.clear();
+        _cellOf.clear();
+        _adj.clear();
+        _table.clear();
+    }
+    _valid = true;
+    return true;
+}
+
+/**
+ * _build
+ *  - Numera las celdas con Map::isWalkableForEnemy que no estén bloqueadas por
+ *    un mecanismo (mismo criterio que FlowField) y precalcula sus vecinos.
+ *  - Lanza un BFS por nodo. Cada trabajo escribe solo sus filas de la tabla,
+ *    así que los trozos no comparten nada salvo el grafo (solo lectura).
+ */
+void DistanceOracle::_build(const Map& map) {
+    const size_t cells = static_cast<size_t>(_w) * static_cast<size_t>(_h);
+    _nodeOf.assign(cells, -1);
+    _cellOf.clear();
+
+    for (int y = 0; y < _h; ++y) {
+        for (int x = 0; x < _w; ++x) {
+            if (!map.isWalkableForEnemy(x, y) || map.isMechanismBlocked(x, y)) continue;
+            const int idx = map.index(x, y);
+            _nodeOf[idx] = static_cast<int>(_cellOf.size());
+            _cellOf.push_back(idx);
+        }
+    }
+
+    const size_t n = _cellOf.size();
+    _adj.assign(n * 4, -1);
+    for (size_t i = 0; i < n; ++i) {
+        const int cx = _cellOf[i] % _w;
+        const int cy = _cellOf[i] / _w;
+        for (int k = 0; k < 4; ++k) {
+            _adj[i * 4 + k] = _node(cx + kDx[k], cy + kDy[k]);
+        }
+    }
+
+    _table.assign(n * n, UNREACHABLE);
+
+    JobSystem::Get().parallelFor(n, DISTANCE_ORACLE_SOURCES_PER_JOB, [this](size_t begin, size_t end) {
+        std::vector<int> queue;
+        queue.reserve(_cellOf.size());
+        for (size_t s = begin; s < end; ++s) {
+            _bfs(static_cast<int>(s), queue);
+        }
+    });
+}
+
+void DistanceOracle::_bfs(int source, std::vector<int>& queue) {
+    const size_t n = _cellOf.size();
+    uint16_t* row = _table.data() + static_cast<size_t>(source) * n;
+
+    queue.clear();
+    row[source] = 0;
+    queue.push_back(source);
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        const int node = queue[head];
+        const uint16_t next = static_cast<uint16_t>(row[node] + 1);
+        if (next == UNREACHABLE) continue;
+
+        for (int k = 0; k < 4; ++k) {
+            const int nb = _adj[static_cast<size_t>(node) * 4 + k];
+            if (nb < 0 || row[nb] != UNREACHABLE) continue;
+            row[nb] = next;
+            queue.push_back(nb);
+        }
+    }
+}
+
+int DistanceOracle::_node(int x, int y) const {
+    if (x < 0 || y < 0 || x >= _w || y >= _h) return -1;
+    return _nodeOf[static_cast<size_t>(y) * _w + x];
+}
+
+uint16_t DistanceOracle::distance(int x, int y, IVec2 target) const {
+    if (!ready()) return UNREACHABLE;
+    if (target.x < 0 || target.y < 0 || target.x >= _w || target.y >= _h) return UNREACHABLE;
+    if (x == target.x && y == target.y) return 0;
+
+    const int from = _node(x, y);
+    if (from < 0) return UNREACHABLE;
+
+    const uint16_t* row = _table.data() + static_cast<size_t>(from) * _cellOf.size();
+    const int to = _node(target.x, target.y);
+    if (to >= 0) return row[to];
+
+    // Objetivo no transitable para enemigos: el mejor de sus vecinos más un paso
+    uint16_t best = UNREACHABLE;
+    for (int k = 0; k < 4; ++k) {
+        const int nb = _node(target.x + kDx[k], target.y + kDy[k]);
+        if (nb < 0 || row[nb] == UNREACHABLE) continue;
+        const uint16_t d = static_cast<uint16_t>(row[nb] + 1);
+        if (d < best) best = d;
+    }
+    return best;
+}
+
+bool DistanceOracle::stepToward(int x, int y, IVec2 target, IVec2& next) const {
+    uint16_t best = distance(x, y, target);
+    bool found = false;
+
+    for (int k = 0; k < 4; ++k) {
+        const int nx = x + kDx[k];
+        const int ny = y + kDy[k];
+        const uint16_t d = distance(nx, ny, target);
+        if (d < best) {
+            best = d;
+            next = { nx, ny };
+            found = true;
+        }
+    }
+    return found;
+}
+
+bool DistanceOracle::stepAway(int x, int y, IVec2 target, IVec2& next) const {
+    const uint16_t current = distance(x, y, target);
+    if (current == UNREACHABLE) return false;
+
+    uint16_t best = current;
+    bool found = false;
+
+    for (int k = 0; k < 4; ++k) {
+        const int nx = x + kDx[k];
+        const int ny = y + kDy[k];
+        const uint16_t d = distance(nx, ny, target);
+        if (d != UNREACHABLE && d > best) {
+            best = d;
+            next = { nx, ny };
+            found = true;
+        }
+    }
+    return found;
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "core/Config.hpp"
+#include "Map.hpp"
+
+/**
+ * Clase DistanceOracle
+ *  - Tabla de distancias (pasos, 4-vecinos) entre todos los pares de celdas
+ *    transitables para enemigos y no bloqueadas por mecanismos, en uint16_t.
+ *  - Solo para mapas pequeños (ancho*alto <= DISTANCE_ORACLE_MAX_CELLS): con 800
+ *    celdas la tabla ocupa ~1.2 MB. En mapas mayores ready() es false y la IA
+ *    sigue usando el FlowField.
+ *  - Se construye al cargar el nivel (un BFS por celda, repartidos con JobSystem)
+ *    y se reconstruye entera cuando cambia la revisión de navegación del mapa
+ *    (mecanismos, clearCell). A cambio, cualquier distancia es una consulta O(1).
+ */
+class DistanceOracle {
+    public:
+        /// Distancia marcada para pares sin camino.
+        static constexpr uint16_t UNREACHABLE = 0xFFFF;
+
+        /**
+         * Reconstruye la tabla si la revisión o el tamaño del mapa han cambiado.
+         * @return true si se ha reconstruido (o descartado por tamaño).
+         */
+        bool update(const Map& map, size_t maxCells = DISTANCE_ORACLE_MAX_CELLS);
+
+        /// Fuerza la reconstrucción en la siguiente llamada a update().
+        void invalidate() { _valid = false; }
+
+        /// true si la revisión o el tamaño del mapa no coinciden con la tabla.
+        bool isStale(const Map& map) const;
+
+        /**
+         * Da la tabla por vigente para la revisión actual del mapa sin recalcularla.
+         * Solo es válido si la navegación del mapa es la misma con la que se construyó
+         * (p.ej. al restaurar una LevelSnapshot junto con esta copia de la tabla).
+         */
+        void adopt(const Map& map) { if (_valid && map.width() == _w && map.height() == _h) _revision = map.navRevision(); }
+
+        /// true si hay tabla para el mapa actual (mapa lo bastante pequeño).
+        bool ready() const { return _valid && _ready; }
+
+        /// Número de celdas indexadas (filas/columnas de la tabla).
+        size_t nodeCount() const { return _cellOf.size(); }
+
+        /**
+         * Distancia en pasos desde (x,y) hasta target.
+         *  - target puede no ser transitable para enemigos (jugador sobre la salida):
+         *    se llega a través de su mejor vecino, igual que en FlowField.
+         * @return UNREACHABLE si no hay camino, fuera de rango o sin tabla.
+         */
+        uint16_t distance(int x, int y, IVec2 target) const;
+
+        /**
+         * Vecino con menor distancia a target que (x,y) (paso hacia el objetivo).
+         * @return false si no hay ningún vecino que acerque.
+         */
+        bool stepToward(int x, int y, IVec2 target, IVec2& next) const;
+
+        /**
+         * Vecino alcanzable con mayor distancia a target que (x,y) (paso alejándose).
+         * @return false si está acorralado o sin camino al objetivo.
+         */
+        bool stepAway(int x, int y, IVec2 target, IVec2& next) const;
+
+    private:
+        int _w = 0, _h = 0;
+        unsigned _revision = 0;
+        bool _valid = false;
+        bool _ready = false;
+
+        // Celda (índice de Map::cells()) → nodo de la tabla, -1 si no es transitable.
+        std::vector<int> _nodeOf;
+        // Nodo → celda.
+        std::vector<int> _cellOf;
+        // 4 vecinos por nodo (-1 si no hay), en el mismo orden que FlowField.
+        std::vector<int> _adj;
+        // Fila i = distancias desde el nodo i a todos los demás (nodeCount() x nodeCount()).
+        std::vector<uint16_t> _table;
+
+        void _build(const Map& map);
+        void _bfs(int source, std::vector<int>& queue);
+        int _node(int x, int y) const;
+};
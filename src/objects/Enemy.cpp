@@ -5,10 +5,10 @@ extern "C" {
 #include <algorithm>
 #include <cmath>
 
-static void shuffledNeighbors(int out[4]) {
+static void shuffledNeighbors(int out[4], RandomStream &rng) {
     out[0]=0; out[1]=1; out[2]=2; out[3]=3;
     for (int i = 3; i > 0; --i) {
-        int j = GetRandomValue(0, i);
+        int j = rng.nextInt(0, i);
         std::swap(out[i], out[j]);
     }
 }
@@ -158,7 +158,7 @@ void Enemy::_patrolBehavior(const Map &map)
         const int dy[4] = {1, -1, 0, 0};
 
         int order[4];
-        shuffledNeighbors(order);
+        shuffledNeighbors(order, rng);
 
         bool found = false;
         for (int k = 0; k < 4; ++k) {
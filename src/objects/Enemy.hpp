@@ -1,5 +1,6 @@
 #pragma once
 #include "Map.hpp"
+#include "core/Random.hpp"
 extern "C" {
   #include <raylib.h>
 }
@@ -33,6 +34,9 @@ public:
     float retreatTimer = 0.0f;       // Tiempo restante en estado RETREAT
     float retreatDuration = 3.0f;    // Duración del retroceso (segundos)
 
+    // Flujo aleatorio propio (orden de patrulla); por defecto sembrado con la celda inicial
+    RandomStream rng;
+
     bool collidesWithPlayer(float playerPx, float playerPy, float playerRadius) const;
 
 
@@ -49,6 +53,7 @@ public:
         bboxH = tileSize * 0.7f;
         state = EnemyState::PATROL;
         retreatTimer = 0.0f;
+        rng.key = RandomStream::KeyFor(0, ((uint64_t)(uint32_t)y_ << 32) | (uint32_t)x_);
     }
 
     void update(const Map &map, float dt, int tileSize, float playerX, float playerY);
@@ -0,0 +1,106 @@
+#include "FlowField.hpp"
+
+namespace {
+    // Mismo orden de vecinos que EnemyAISystem: abajo, arriba, derecha, izquierda.
+    const int kDx[4] = {0, 0, 1, -1};
+    const int kDy[4] = {1, -1, 0, 0};
+}
+
+bool FlowField::isStale(const Map& map, IVec2 target) const {
+    return !_valid ||
+           target.x != _target.x || target.y != _target.y ||
+           map.width() != _w || map.height() != _h ||
+           map.navRevision() != _revision;
+}
+
+bool FlowField::update(const Map& map, IVec2 target) {
+    if (!isStale(map, target)) return false;
+
+    _target = target;
+    _revision = map.navRevision();
+    _build(map);
+    _valid = true;
+    return true;
+}
+
+/**
+ * _build
+ *  - BFS desde _target sobre celdas con Map::isWalkableForEnemy que no estén
+ *    bloqueadas por un mecanismo activo (Map::isMechanismBlocked).
+ *  - La celda objetivo siempre recibe distancia 0 aunque no sea transitable
+ *    para enemigos (p.ej. el jugador sobre la salida).
+ */
+void FlowField::_build(const Map& map) {
+    _w = map.width();
+    _h = map.height();
+    _dist.assign(static_cast<size_t>(_w) * static_cast<size_t>(_h), UNREACHABLE);
+    _queue.clear();
+
+    if (!map.inBounds(_target.x, _target.y)) return;
+
+    const int start = map.index(_target.x, _target.y);
+    _dist[start] = 0;
+    _queue.push_back(start);
+
+    for (size_t head = 0; head < _queue.size(); ++head) {
+        const int idx = _queue[head];
+        const int cx = idx % _w;
+        const int cy = idx / _w;
+        const uint16_t next = static_cast<uint16_t>(_dist[idx] + 1);
+        if (next == UNREACHABLE) continue;
+
+        for (int i = 0; i < 4; ++i) {
+            const int nx = cx + kDx[i];
+            const int ny = cy + kDy[i];
+            if (!map.isWalkableForEnemy(nx, ny) || map.isMechanismBlocked(nx, ny)) continue;
+
+            const int nidx = map.index(nx, ny);
+            if (_dist[nidx] != UNREACHABLE) continue;
+
+            _dist[nidx] = next;
+            _queue.push_back(nidx);
+        }
+    }
+}
+
+uint16_t FlowField::distance(int x, int y) const {
+    if (x < 0 || y < 0 || x >= _w || y >= _h) return UNREACHABLE;
+    return _dist[static_cast<size_t>(y) * _w + x];
+}
+
+bool FlowField::stepToward(int x, int y, IVec2& next) const {
+    uint16_t best = distance(x, y);
+    bool found = false;
+
+    for (int i = 0; i < 4; ++i) {
+        const int nx = x + kDx[i];
+        const int ny = y + kDy[i];
+        const uint16_t d = distance(nx, ny);
+        if (d < best) {
+            best = d;
+            next = { nx, ny };
+            found = true;
+        }
+    }
+    return found;
+}
+
+bool FlowField::stepAway(int x, int y, IVec2& next) const {
+    const uint16_t current = distance(x, y);
+    if (current == UNREACHABLE) return false;
+
+    uint16_t best = current;
+    bool found = false;
+
+    for (int i = 0; i < 4; ++i) {
+        const int nx = x + kDx[i];
+        const int ny = y + kDy[i];
+        const uint16_t d = distance(nx, ny);
+        if (d != UNREACHABLE && d > best) {
+            best = d;
+            next = { nx, ny };
+            found = true;
+        }
+    }
+    return found;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "core/Config.hpp"
+#include "Map.hpp"
+
+/**
+ * Clase FlowField
+ *  - Campo de distancias (BFS, 4-vecinos) desde una celda objetivo (el jugador)
+ *    sobre las celdas transitables para enemigos y no bloqueadas por mecanismos.
+ *  - Se comparte entre todos los enemigos: se recalcula solo cuando cambia la
+ *    celda objetivo o la revisión de navegación del mapa (mecanismos, clearCell).
+ *  - Los enemigos leen el gradiente: bajar distancia = perseguir, subir = huir.
+ */
+class FlowField {
+    public:
+        /// Distancia marcada para celdas no alcanzables desde el objetivo.
+        static constexpr uint16_t UNREACHABLE = 0xFFFF;
+
+        /**
+         * Recalcula el campo si el objetivo o la revisión del mapa han cambiado.
+         * @return true si se ha reconstruido el campo.
+         */
+        bool update(const Map& map, IVec2 target);
+
+        /// Fuerza la reconstrucción en la siguiente llamada a update().
+        void invalidate() { _valid = false; }
+
+        /// true si el objetivo o la revisión del mapa no coinciden con el último cálculo.
+        bool isStale(const Map& map, IVec2 target) const;
+
+        /// Distancia en pasos hasta el objetivo; UNREACHABLE si no hay camino o fuera de rango.
+        uint16_t distance(int x, int y) const;
+
+        /**
+         * Vecino con menor distancia que (x,y) (paso hacia el objetivo).
+         * @return false si no hay ningún vecino que acerque (ya en destino o sin camino).
+         */
+        bool stepToward(int x, int y, IVec2& next) const;
+
+        /**
+         * Vecino alcanzable con mayor distancia que (x,y) (paso alejándose del objetivo).
+         * @return false si el enemigo está acorralado o fuera del campo.
+         */
+        bool stepAway(int x, int y, IVec2& next) const;
+
+        IVec2 target() const { return _target; }
+
+    private:
+        int _w = 0, _h = 0;
+        IVec2 _target{ -1, -1 };
+        unsigned _revision = 0;
+        bool _valid = false;
+
+        // Distancias por celda (fila a fila, mismo índice que Map::cells()).
+        std::vector<uint16_t> _dist;
+
+        // Cola BFS reutilizada entre reconstrucciones (sin reservas por frame).
+        std::vector<int> _queue;
+
+        void _build(const Map& map);
+};
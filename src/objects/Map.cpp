@@ -1,16 +1,24 @@
 #include "Map.hpp"
+#include <cstring>
 #include <fstream>
+#include "core/MappedFile.hpp"
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
 #include <sstream>   // para construir mensajes de error detallados
 extern "C" {
     #include <raylib.h>
+    #include <rlgl.h>
 }
 #include <iostream>
 
 /**
  * Carga un mapa ASCII desde archivo.
- * - Lee línea a línea y rellena _grid.
+ * - Proyecta el archivo en memoria (MappedFile) y lo recorre una sola vez:
+ *   cada fila se valida, se copia a _chars y se clasifica en el momento.
  * - Valida que el mapa sea no vacío y rectangular.
- * - Escanea 'P' y 'E' para inicializar spawns.
+ * - En la misma pasada registra 'P', 'E', 'K', '^' y las letras de mecanismo.
+ * - Clasifica cada celda en el array plano _cells y en las máscaras de bits.
  *
  * Errores comunes gestionados:
  *  - Archivo inexistente/imposible de abrir → throw runtime_error.
@@ -24,87 +32,577 @@ extern "C" {
  */
 bool Map::loadFromFile(const std::string& path, int tileSize) {
     // Limpia estado previo por si se reutiliza la instancia.
-    _grid.clear();
+    _resetChunks();
+    _chars.clear();
+    _gridRowsValid = false;
     _enemies.clear();
     _player = { -1, -1 };
     _keys.clear();
     _spikes.clear();
+    _cells.clear();
+    _walkMask.clear();
+    _enemyWalkMask.clear();
+    _wallMask.clear();
+    _doorMask.clear();
+    _blockedMask.clear();
+    _w = _h = 0;
+    _dirtyCells.clear();
+    _unloadStaticLayer();
 
-    // 1) Apertura del archivo
-    std::ifstream in(path);
-    std::cout << "Cargando mapa desde: " << path << std::endl;
-    if (!in) throw std::runtime_error("Cannot open map: " + path);
+    // 1) Proyección del archivo
+    std::cout << "Cargando mapa desde: " << path << '\n';
+    MappedFile file(path);
+    if (!file.isOpen()) throw std::runtime_error("Cannot open map: " + path);
+    if (file.size() == 0) throw std::runtime_error("Empty map file");
+
+    // 2) Aplica tamaño de tile (usado luego para render)
+    _tile = tileSize;
+
+    //guardamos las posiciones de los mecanismos y el caracter que los identifica para juntarlos despues
+    std::unordered_map<char, IVec2> triggers;
+    std::unordered_map<char, IVec2> targets;
+
+    // 3) Filas: memchr (vectorizado en la libc) busca cada salto de línea.
+    //    Todas las filas deben medir lo que la primera; se valida al llegar.
+    const char* data = file.data();
+    const size_t size = file.size();
+    size_t pos = 0;
+    int y = 0;
+    while (pos < size) {
+        const char* line = data + pos;
+        const char* newline = static_cast<const char*>(std::memchr(line, '\n', size - pos));
+        size_t len = newline ? static_cast<size_t>(newline - line) : size - pos;
+        pos += len + (newline ? 1 : 0);
 
-    // 2) Lectura línea a línea (cada línea es una fila del grid)
-    std::string line;
-    while (std::getline(in, line)) {
         // Compatibilidad CRLF: elimina '\r' final si existe
-        if (!line.empty() && line.back() == '\r') line.pop_back();
-        _grid.push_back(line);
-    }
-    if (_grid.empty()) throw std::runtime_error("Empty map file");
+        if (len > 0 && line[len - 1] == '\r') --len;
 
-    // 3) Validación de rectangularidad
-    _h = static_cast<int>(_grid.size());
-    _w = static_cast<int>(_grid[0].size());
-    for (const auto& row : _grid) {
-        if (static_cast<int>(row.size()) != _w)
+        if (y == 0) {
+            _w = static_cast<int>(len);
+            // Estimación de filas por el tamaño de la primera (exacta si todo es igual)
+            const size_t rowBytes = static_cast<size_t>(pos);
+            _reserveRows(static_cast<int>(size / rowBytes + 1));
+        } else if (static_cast<int>(len) != _w) {
             throw std::runtime_error("Non-rectangular map");
+        }
+
+        _reserveRows(y + 1);
+        _appendRow(line, y, triggers, targets);
+        ++y;
     }
+    _h = y;
+
+    // Ajuste al tamaño real (la reserva podía sobrar)
+    const size_t cellCount = static_cast<size_t>(_w) * static_cast<size_t>(_h);
+    const size_t maskWords = (cellCount + 63) / 64;
+    _chars.resize(cellCount);
+    _cells.resize(cellCount);
+    _walkMask.resize(maskWords);
+    _enemyWalkMask.resize(maskWords);
+    _wallMask.resize(maskWords);
+    _doorMask.resize(maskWords);
+    _blockedMask.assign(maskWords, 0);
+
+    // 4) Post-condición: debe existir un spawn de jugador
+    if (_player.x < 0) throw std::runtime_error("Missing player start 'P'");
+
+    // 5) Mecanismos: emparejamos triggers y targets
+    pairMechanisms(triggers, targets);
+
+    // Nuevo layout: invalida cualquier caché de navegación previa
+    markNavigationDirty();
+
+    // 6) cargamos texturas SE HACE EN MAINGAMESTATE
+
+    return true;
+}
+
+void Map::_reserveRows(int rows) {
+    const size_t needed = static_cast<size_t>(_w) * static_cast<size_t>(rows);
+    if (needed <= _cells.size()) return;
+
+    const size_t cellCount = std::max(needed, _cells.size() * 2);
+    // Una palabra de margen: _orBits puede escribir en la siguiente a la última celda
+    const size_t maskWords = cellCount / 64 + 2;
+    _chars.resize(cellCount);
+    _cells.resize(cellCount);
+    _walkMask.resize(maskWords, 0);
+    _enemyWalkMask.resize(maskWords, 0);
+    _wallMask.resize(maskWords, 0);
+    _doorMask.resize(maskWords, 0);
+}
+
+/**
+ * _appendRow
+ *  - Bloques de 16 celdas con SSE2: las de '.' y '#' (casi todo el mapa) se
+ *    clasifican con comparaciones y movemask, escribiendo 16 bits de máscara de
+ *    golpe; solo las demás pasan por _scanSpecial.
+ *  - Sin SSE2 (o en la cola de la fila) se clasifica celda a celda.
+ */
+void Map::_appendRow(const char* row, int y, std::unordered_map<char, IVec2>& triggers,
+                     std::unordered_map<char, IVec2>& targets) {
+    const size_t base = static_cast<size_t>(y) * static_cast<size_t>(_w);
+    std::memcpy(_chars.data() + base, row, static_cast<size_t>(_w));
+
+    int x = 0;
+#if defined(__SSE2__)
+    const __m128i dot = _mm_set1_epi8('.');
+    const __m128i wall = _mm_set1_epi8('#');
+    const __m128i one = _mm_set1_epi8(1);
+    static_assert(static_cast<uint8_t>(CellType::Floor) == 0 && static_cast<uint8_t>(CellType::Wall) == 1,
+                  "El camino rápido escribe Floor=0 y Wall=1 directamente");
+    for (; x + 16 <= _w; x += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x));
+        const __m128i isWall = _mm_cmpeq_epi8(v, wall);
+        const __m128i isDot = _mm_cmpeq_epi8(v, dot);
+        const uint32_t wallBits = static_cast<uint32_t>(_mm_movemask_epi8(isWall));
+        const uint32_t dotBits = static_cast<uint32_t>(_mm_movemask_epi8(isDot));
+        const size_t idx = base + static_cast<size_t>(x);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(_cells.data() + idx), _mm_and_si128(isWall, one));
+        _orBits(_wallMask, idx, wallBits);
+        _orBits(_walkMask, idx, dotBits);
+        _orBits(_enemyWalkMask, idx, dotBits);
+
+        uint32_t special = ~(wallBits | dotBits) & 0xFFFFu;
+        while (special) {
+            const int bit = __builtin_ctz(special);
+            special &= special - 1;
+            _scanSpecial(x + bit, y, row[x + bit], triggers, targets);
+        }
+    }
+#endif
+    for (; x < _w; ++x) {
+        _scanSpecial(x, y, row[x], triggers, targets);
+    }
+}
+
+void Map::_scanSpecial(int x, int y, char c, std::unordered_map<char, IVec2>& triggers,
+                       std::unordered_map<char, IVec2>& targets) {
+    _classifyCell(index(x, y), c);
+    if (c == 'P') {
+        _player = { x, y };
+    } else if (c == 'E') {
+        _enemies.push_back({ x, y });
+    } else if (c == 'K') {
+        _keys.push_back({ x, y });
+    } else if (c == '^') {
+        _spikes.push_back({ x, y });
+    } else if (std::islower(static_cast<unsigned char>(c))) {
+        triggers[c] = { x, y };
+    } else if (std::isupper(static_cast<unsigned char>(c)) && c != 'X') {
+        targets[c] = { x, y };
+    }
+}
+
+namespace {
+    // Cabecera del formato binario de nivel (.lvl)
+    struct BinaryHeader {
+        char magic[4];
+        uint32_t version;
+        uint64_t payloadSize;   // bytes de saveState() que siguen a la cabecera
+    };
+
+    constexpr char BINARY_MAGIC[4] = { 'M', 'A', 'P', 'B' };
+}
+
+/**
+ * loadFromBinary
+ *  - Proyecta el archivo (MappedFile) y restaura el estado con restoreState().
+ *  - El mapa binario ya viene validado por loadFromFile al compilarlo (rectangular,
+ *    con 'P' y mecanismos emparejados); aquí solo se comprueba la coherencia.
+ */
+bool Map::loadFromBinary(const std::string& path, int tileSize) {
+    MappedFile file(path);
+    if (!file.isOpen()) throw std::runtime_error("Cannot open map: " + path);
+    if (file.size() < sizeof(BinaryHeader)) throw std::runtime_error("Truncated binary map: " + path);
+
+    ByteReader reader(reinterpret_cast<const uint8_t*>(file.data()), file.size());
+    const BinaryHeader header = reader.pod<BinaryHeader>();
+    if (std::memcmp(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0) {
+        throw std::runtime_error("Not a binary map: " + path);
+    }
+    if (header.version != BINARY_VERSION) {
+        throw std::runtime_error("Unsupported binary map version " + std::to_string(header.version) + ": " + path);
+    }
+    if (header.payloadSize != file.size() - sizeof(BinaryHeader)) {
+        throw std::runtime_error("Truncated binary map: " + path);
+    }
+
+    // Carga desde cero: nada de la capa horneada anterior sirve
+    _unloadStaticLayer();
+    _dirtyCells.clear();
+    _w = _h = 0;
+    restoreState(reader);
+    if (!reader.atEnd()) throw std::runtime_error("Trailing data in binary map: " + path);
+    if (_player.x < 0) throw std::runtime_error("Missing player start 'P'");
 
-    // 4) Aplica tamaño de tile (usado luego para render)
     _tile = tileSize;
+    return true;
+}
 
-    // 5) Escaneo para localizar 'P' (jugador) y 'E' (enemigos)
-    //    Nota: si hay varias 'P', la última sobrescribiría a la anterior; el
-    //    diseño actual asume exactamente una 'P'. En futuras iteraciones
-    //    podemos comprobar y fallar si hay != 1.
-    //   También localiza llaves 'K', Spikes '^' y mecanismos 'D','T','B', 'U'
+void Map::saveBinary(const std::string& path) const {
+    std::vector<uint8_t> payload;
+    ByteWriter writer(payload);
+    saveState(writer);
 
-    //guardamos las posiciones de los mecanismos y el caracter que los identifica para juntarlos despues
-    std::unordered_map<char, IVec2> triggers;
-    std::unordered_map<char, IVec2> targets;
+    BinaryHeader header{};
+    std::memcpy(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    header.version = BINARY_VERSION;
+    header.payloadSize = payload.size();
 
-    for (int y = 0; y < _h; ++y) {
-        for (int x = 0; x < _w; ++x) {
-            const char c = _grid[y][x];
-            if (c == 'P') {
-                _player = { x, y };
-            } else if (c == 'E') {
-                _enemies.push_back({ x, y });
-            } else if (c == 'K') {
-                _keys.push_back({ x, y });
-            } else if (c == 'X') {
-                // Salida, no se necesita almacenar posición aquí?
-            } else if (c == '^') {
-                _spikes.push_back({x, y});
-            }else if (std::islower(c)) {
-                triggers[c] = {x, y};
-            } else if (std::isupper(c)) {
-                targets[c] = {x, y};
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("Cannot write map: " + path);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(payload.data()), static_cast<std::streamsize>(payload.size()));
+    if (!out) throw std::runtime_error("Cannot write map: " + path);
+}
+
+namespace {
+    // Cabecera del formato por chunks (.lvc). Le siguen jugador, llaves,
+    // mecanismos y el directorio de chunks (ByteWriter) y después los chunks.
+    struct ChunkedHeader {
+        char magic[4];
+        uint32_t version;
+        int32_t width;
+        int32_t height;
+        int32_t chunkSize;
+    };
+
+    constexpr char CHUNKED_MAGIC[4] = { 'M', 'A', 'P', 'K' };
+}
+
+/**
+ * saveChunked
+ *  - Cada chunk se guarda como MAP_CHUNK_SIZE² caracteres (relleno con '#' en
+ *    los bordes del mapa); los que quedan enteros en pared no se escriben y su
+ *    entrada del directorio vale 0.
+ */
+void Map::saveChunked(const std::string& path) const {
+    if (_chunked) throw std::runtime_error("Map is already chunked: " + path);
+
+    const int chunksX = (_w + MAP_CHUNK_SIZE - 1) / MAP_CHUNK_SIZE;
+    const int chunksY = (_h + MAP_CHUNK_SIZE - 1) / MAP_CHUNK_SIZE;
+    const size_t chunkCount = static_cast<size_t>(chunksX) * static_cast<size_t>(chunksY);
+
+    std::vector<uint8_t> blobs;
+    std::vector<uint64_t> offsets(chunkCount, 0);   // de momento, relativos a 'blobs' + 1
+    std::vector<char> chunk(CHUNK_CELLS);
+    for (int cy = 0; cy < chunksY; ++cy) {
+        for (int cx = 0; cx < chunksX; ++cx) {
+            std::fill(chunk.begin(), chunk.end(), '#');
+            bool empty = true;
+            for (int ly = 0; ly < MAP_CHUNK_SIZE && cy * MAP_CHUNK_SIZE + ly < _h; ++ly) {
+                const int y = cy * MAP_CHUNK_SIZE + ly;
+                const int x0 = cx * MAP_CHUNK_SIZE;
+                const int len = std::min(MAP_CHUNK_SIZE, _w - x0);
+                const char* row = _chars.data() + index(x0, y);
+                std::memcpy(chunk.data() + ly * MAP_CHUNK_SIZE, row, static_cast<size_t>(len));
+                if (empty && std::any_of(row, row + len, [](char c) { return c != '#'; })) empty = false;
             }
+            if (empty) continue;
+
+            offsets[static_cast<size_t>(cy) * chunksX + cx] = blobs.size() + 1;
+            blobs.insert(blobs.end(), chunk.begin(), chunk.end());
         }
     }
 
-    // 6) Post-condición: debe existir un spawn de jugador
-    if (_player.x < 0) throw std::runtime_error("Missing player start 'P'");
+    ChunkedHeader header{};
+    std::memcpy(header.magic, CHUNKED_MAGIC, sizeof(CHUNKED_MAGIC));
+    header.version = CHUNKED_VERSION;
+    header.width = _w;
+    header.height = _h;
+    header.chunkSize = MAP_CHUNK_SIZE;
 
-    //7 Mecanismos: emparejamos triggers y targets
-    pairMechanisms(triggers, targets);
+    // El directorio tiene tamaño fijo: se calcula dónde empiezan los chunks y se reescribe
+    auto writeMeta = [&](const std::vector<uint64_t>& directory) {
+        std::vector<uint8_t> meta;
+        ByteWriter writer(meta);
+        writer.pod(header);
+        writer.pod(_player);
+        writer.array(_keys);
+        writer.array(_mechanisms);
+        writer.array(directory);
+        return meta;
+    };
+    const size_t blobStart = writeMeta(offsets).size();
+    for (uint64_t& offset : offsets) {
+        if (offset) offset += blobStart - 1;
+    }
+    const std::vector<uint8_t> meta = writeMeta(offsets);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("Cannot write map: " + path);
+    out.write(reinterpret_cast<const char*>(meta.data()), static_cast<std::streamsize>(meta.size()));
+    out.write(reinterpret_cast<const char*>(blobs.data()), static_cast<std::streamsize>(blobs.size()));
+    if (!out) throw std::runtime_error("Cannot write map: " + path);
+}
+
+bool Map::peekSize(const std::string& path, int& width, int& height) {
+    MappedFile file(path);
+    if (!file.isOpen() || file.size() == 0) return false;
+    ByteReader reader(reinterpret_cast<const uint8_t*>(file.data()), file.size());
+
+    // .lvl: el estado (saveState) empieza por ancho y alto
+    if (file.size() >= sizeof(BinaryHeader) + 2 * sizeof(int) &&
+        std::memcmp(file.data(), BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0) {
+        if (reader.pod<BinaryHeader>().version != BINARY_VERSION) return false;
+        width = reader.pod<int>();
+        height = reader.pod<int>();
+        return width > 0 && height > 0;
+    }
+    if (file.size() >= sizeof(ChunkedHeader) &&
+        std::memcmp(file.data(), CHUNKED_MAGIC, sizeof(CHUNKED_MAGIC)) == 0) {
+        const ChunkedHeader header = reader.pod<ChunkedHeader>();
+        if (header.version != CHUNKED_VERSION) return false;
+        width = header.width;
+        height = header.height;
+        return width > 0 && height > 0;
+    }
+
+    // Texto: solo se buscan los saltos de línea, como en loadFromFile
+    const char* data = file.data();
+    const size_t size = file.size();
+    size_t pos = 0;
+    int rows = 0;
+    int first = 0;
+    while (pos < size) {
+        const char* newline = static_cast<const char*>(std::memchr(data + pos, '\n', size - pos));
+        const size_t end = newline ? static_cast<size_t>(newline - data) : size;
+        size_t len = end - pos;
+        if (len > 0 && data[end - 1] == '\r') --len;
+        if (rows++ == 0) first = static_cast<int>(len);
+        pos = end + 1;
+    }
+    width = first;
+    height = rows;
+    return rows > 0;
+}
+
+bool Map::loadChunked(const std::string& path, int tileSize) {
+    MappedFile file(path);
+    if (!file.isOpen()) throw std::runtime_error("Cannot open map: " + path);
+    if (file.size() < sizeof(ChunkedHeader)) throw std::runtime_error("Truncated chunked map: " + path);
+
+    ByteReader reader(reinterpret_cast<const uint8_t*>(file.data()), file.size());
+    const ChunkedHeader header = reader.pod<ChunkedHeader>();
+    if (std::memcmp(header.magic, CHUNKED_MAGIC, sizeof(CHUNKED_MAGIC)) != 0) {
+        throw std::runtime_error("Not a chunked map: " + path);
+    }
+    if (header.version != CHUNKED_VERSION) {
+        throw std::runtime_error("Unsupported chunked map version " + std::to_string(header.version) + ": " + path);
+    }
+    if (header.chunkSize != MAP_CHUNK_SIZE || header.width <= 0 || header.height <= 0) {
+        throw std::runtime_error("Invalid chunked map layout: " + path);
+    }
+
+    const IVec2 player = reader.pod<IVec2>();
+    std::vector<IVec2> keys;
+    std::vector<MechanismPair> mechanisms;
+    std::vector<uint64_t> offsets;
+    reader.array(keys);
+    reader.array(mechanisms);
+    reader.array(offsets);
+
+    const int chunksX = (header.width + MAP_CHUNK_SIZE - 1) / MAP_CHUNK_SIZE;
+    const int chunksY = (header.height + MAP_CHUNK_SIZE - 1) / MAP_CHUNK_SIZE;
+    if (offsets.size() != static_cast<size_t>(chunksX) * static_cast<size_t>(chunksY)) {
+        throw std::runtime_error("Inconsistent chunked map: " + path);
+    }
+    for (uint64_t offset : offsets) {
+        if (offset && (offset > file.size() || file.size() - offset < static_cast<size_t>(CHUNK_CELLS))) {
+            throw std::runtime_error("Truncated chunked map: " + path);
+        }
+    }
+    if (player.x < 0 || player.y < 0 || player.x >= header.width || player.y >= header.height) {
+        throw std::runtime_error("Missing player start 'P'");
+    }
+
+    // Carga válida: se descarta todo el estado anterior (normal o por chunks)
+    _unloadStaticLayer();
+    _dirtyCells.clear();
+    _resetChunks();
+    _chars.clear();
+    _cells.clear();
+    _walkMask.clear();
+    _enemyWalkMask.clear();
+    _wallMask.clear();
+    _doorMask.clear();
+    _blockedMask.clear();
+    _enemies.clear();
+    _spikes.clear();
+    _gridRowsValid = false;
+
+    _w = header.width;
+    _h = header.height;
+    _tile = tileSize;
+    _player = player;
+    _keys = std::move(keys);
+    _mechanisms = std::move(mechanisms);
+
+    _chunked = true;
+    _chunksX = chunksX;
+    _chunksY = chunksY;
+    _chunkOffsets = std::move(offsets);
+    _chunkSlot.assign(_chunkOffsets.size(), -1);
+    _chunkFile = std::move(file);
+
+    markNavigationDirty();
+    return true;
+}
+
+bool Map::isRegionResident(int x0, int y0, int x1, int y1) const {
+    if (!_chunked) return true;
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, _w - 1);
+    y1 = std::min(y1, _h - 1);
+    for (int cy = y0 / MAP_CHUNK_SIZE; cy <= y1 / MAP_CHUNK_SIZE && y0 <= y1; ++cy) {
+        for (int cx = x0 / MAP_CHUNK_SIZE; cx <= x1 / MAP_CHUNK_SIZE && x0 <= x1; ++cx) {
+            if (_chunkSlot[static_cast<size_t>(cy) * _chunksX + cx] >= 0) return true;
+        }
+    }
+    return false;
+}
+
+bool Map::loadChunk(int chunk) {
+    if (!_chunked || chunk < 0 || chunk >= static_cast<int>(_chunkSlot.size())) return false;
+    if (_chunkSlot[chunk] >= 0) return false;
+
+    int slot;
+    if (!_freeSlots.empty()) {
+        slot = _freeSlots.back();
+        _freeSlots.pop_back();
+    } else {
+        slot = static_cast<int>(_chunkPool.size());
+        _chunkPool.emplace_back();
+    }
+    Chunk& c = _chunkPool[slot];
+
+    // Copia modificada al descargarlo > archivo > todo pared
+    auto edit = _chunkEdits.find(chunk);
+    c.edited = (edit != _chunkEdits.end());
+    if (c.edited) {
+        std::memcpy(c.chars.data(), edit->second.data(), c.chars.size());
+        _chunkEdits.erase(edit);
+    } else if (_chunkOffsets[chunk]) {
+        std::memcpy(c.chars.data(), _chunkFile.data() + _chunkOffsets[chunk], c.chars.size());
+    } else {
+        c.chars.fill('#');
+    }
 
-    //8 cargamos texturas SE HACE EN MAINGAMESTATE
+    std::memset(c.masks, 0, sizeof(c.masks));
+    for (int i = 0; i < CHUNK_CELLS; ++i) _classifyChunkCell(c, i, c.chars[i]);
 
+    // Targets de mecanismo que siguen activos dentro del chunk
+    for (int idx : _blockedCells) {
+        const int x = idx % _w;
+        const int y = idx / _w;
+        if (chunkOf(x, y) == chunk) c.masks[MASK_BLOCKED][y % MAP_CHUNK_SIZE] |= uint64_t{1} << (x % MAP_CHUNK_SIZE);
+    }
+
+    c.lastUse = ++_chunkClock;
+    _chunkSlot[chunk] = slot;
+    _residentChunks.push_back(chunk);
+    _gridRowsValid = false;
+    _recordChunkChange(chunk);
     return true;
 }
 
+void Map::unloadChunk(int chunk) {
+    if (!_chunked || chunk < 0 || chunk >= static_cast<int>(_chunkSlot.size())) return;
+    const int slot = _chunkSlot[chunk];
+    if (slot < 0) return;
+
+    const Chunk& c = _chunkPool[slot];
+    if (c.edited) _chunkEdits[chunk].assign(c.chars.begin(), c.chars.end());
+
+    _chunkSlot[chunk] = -1;
+    _freeSlots.push_back(slot);
+    auto it = std::find(_residentChunks.begin(), _residentChunks.end(), chunk);
+    *it = _residentChunks.back();
+    _residentChunks.pop_back();
+    _gridRowsValid = false;
+    _recordChunkChange(chunk);
+}
+
+void Map::touchChunk(int chunk) {
+    if (!_chunked || chunk < 0 || chunk >= static_cast<int>(_chunkSlot.size())) return;
+    const int slot = _chunkSlot[chunk];
+    if (slot >= 0) _chunkPool[slot].lastUse = ++_chunkClock;
+}
+
+uint64_t Map::chunkLastUse(int chunk) const {
+    if (!_chunked || chunk < 0 || chunk >= static_cast<int>(_chunkSlot.size())) return 0;
+    const int slot = _chunkSlot[chunk];
+    return slot >= 0 ? _chunkPool[slot].lastUse : 0;
+}
+
+void Map::_classifyChunkCell(Chunk& chunk, int cell, char c) {
+    const CellType type = _classify(c);
+    chunk.cells[cell] = static_cast<uint8_t>(type);
+
+    const bool wall = (type == CellType::Wall);
+    const bool door = (type == CellType::Target);
+    const int row = cell / MAP_CHUNK_SIZE;
+    const uint64_t bit = uint64_t{1} << (cell % MAP_CHUNK_SIZE);
+    auto set = [&](ChunkMask mask, bool value) {
+        uint64_t& word = chunk.masks[mask][row];
+        word = value ? (word | bit) : (word & ~bit);
+    };
+    set(MASK_WALL, wall);
+    set(MASK_DOOR, door);
+    set(MASK_WALK, !wall);
+    set(MASK_ENEMY_WALK, !wall && !door && type != CellType::Exit);
+}
+
+/**
+ * _recordChunkChange
+ *  - NavHierarchy ensucia el cluster de cada celda cambiada y, si está en el
+ *    borde, el vecino. Con las esquinas superior-izquierda e inferior-derecha de
+ *    cada cluster del chunk se rehacen todos ellos y los cuatro vecinos exteriores,
+ *    sin apuntar las MAP_CHUNK_SIZE² celdas.
+ */
+void Map::_recordChunkChange(int chunk) {
+    const int x0 = (chunk % _chunksX) * MAP_CHUNK_SIZE;
+    const int y0 = (chunk / _chunksX) * MAP_CHUNK_SIZE;
+    const int x1 = std::min(x0 + MAP_CHUNK_SIZE, _w);
+    const int y1 = std::min(y0 + MAP_CHUNK_SIZE, _h);
+    for (int y = y0; y < y1; y += NAV_CLUSTER_SIZE) {
+        for (int x = x0; x < x1; x += NAV_CLUSTER_SIZE) {
+            _recordNavChange(index(x, y));
+            _recordNavChange(index(std::min(x + NAV_CLUSTER_SIZE, x1) - 1, std::min(y + NAV_CLUSTER_SIZE, y1) - 1));
+        }
+    }
+}
+
+void Map::_resetChunks() {
+    _chunked = false;
+    _chunksX = _chunksY = 0;
+    _chunkFile.close();
+    _chunkOffsets.clear();
+    _chunkSlot.clear();
+    _chunkPool.clear();
+    _chunkPool.shrink_to_fit();
+    _freeSlots.clear();
+    _residentChunks.clear();
+    _chunkClock = 0;
+    _chunkEdits.clear();
+    _blockedCells.clear();
+}
+
 void Map::loadTextures() {
     auto& rm = ResourceManager::Get();
 
-    _mapTexture = &rm.GetTexture("sprites/walls_floor.png");
+    _mapTexture = &rm.GetTexture(TEX_WALLS_FLOOR);
     _floorSrc = { 176, 340, 32, 28 };
     _wallSrc  = { 10, 47, 32, 30 };
     _exitSrc  = { 48, 336, 32, 32 };
 
+    // La capa estática se hornea aquí, fuera del frame: render() solo la dibuja.
+    // Si ya existe (reinicio restaurado con restoreState) se conserva y
+    // prepareRender() repinta solo las celdas que cambiaron
+    if (!_staticLayerTried && !_chunked) _bakeStaticLayer();
 }
 
 /**
@@ -133,7 +631,24 @@ char Map::at(int x, int y) const {
     }
 
     // 2) Retornar el carácter correspondiente
-    return _grid[y][x];
+    return _charAt(x, y);
+}
+
+const std::vector<std::string>& Map::grid() const {
+    if (!_gridRowsValid) {
+        _gridRows.resize(_h);
+        for (int y = 0; y < _h; ++y) {
+            if (!_chunked) {
+                _gridRows[y].assign(_chars.data() + index(0, y), static_cast<size_t>(_w));
+                continue;
+            }
+            // Por chunks: lo no cargado sale como pared
+            _gridRows[y].resize(static_cast<size_t>(_w));
+            for (int x = 0; x < _w; ++x) _gridRows[y][x] = _charAt(x, y);
+        }
+        _gridRowsValid = true;
+    }
+    return _gridRows;
 }
 
 /**
@@ -144,11 +659,11 @@ char Map::at(int x, int y) const {
  * @note Esta función incluye la comprobación de límites para evitar accesos fuera de rango.
  */
 bool Map::isWalkable(int x, int y) const {
-    // 1) Comprobación de límites (importante antes de indexar _grid)
-    if (x < 0 || y < 0 || x >= _w || y >= _h) return false;
+    // 1) Comprobación de límites (importante antes de indexar las máscaras)
+    if (!inBounds(x, y)) return false;
 
-    // 2) Paredes no transitables
-    return _grid[y][x] != '#';
+    // 2) Paredes no transitables (precalculado en _walkMask)
+    return _chunked ? _chunkBit(MASK_WALK, x, y, false) : _testBit(_walkMask, index(x, y));
 }
 
 /**
@@ -163,30 +678,52 @@ bool Map::isWalkable(int x, int y) const {
  * @note Esta función incluye la comprobación de límites para evitar accesos fuera de rango.
  */
 bool Map::isWalkableForEnemy(int x, int y) const {
-    // 1) Comprobación de límites (importante antes de indexar _grid)
-    if (x < 0 || y < 0 || x >= _w || y >= _h) return false;
+    // 1) Comprobación de límites (importante antes de indexar las máscaras)
+    if (!inBounds(x, y)) return false;
 
-    char cell = _grid[y][x];
+    // 2) Paredes, salida y puertas ya están descartadas en _enemyWalkMask
+    return _chunked ? _chunkBit(MASK_ENEMY_WALK, x, y, false) : _testBit(_enemyWalkMask, index(x, y));
+}
 
-    // 2) Paredes no transitables
-    if (cell == '#') return false;
+/**
+ * _classifyCell
+ *  - Traduce el caracter ASCII a CellType y actualiza las máscaras de bits.
+ *  - Reglas equivalentes a las antiguas comprobaciones sobre _grid:
+ *      '#'          → pared (nadie pasa).
+ *      'X'          → salida (solo jugador).
+ *      mayúsculas   → target de mecanismo (solo jugador; el bloqueo real lo decide el ECS).
+ *      'P','E','K'  → mayúsculas transitables para todos.
+ *      resto        → transitable para todos (incluye botones en minúscula).
+ */
+CellType Map::_classify(char c) {
+    const unsigned char uc = static_cast<unsigned char>(c);
+    if (c == '#')                    return CellType::Wall;
+    if (c == 'X')                    return CellType::Exit;
+    if (c == 'K')                    return CellType::Key;
+    if (c == '^')                    return CellType::Spike;
+    if (std::islower(uc))            return CellType::Trigger;
+    if (std::isupper(uc) && c != 'P' && c != 'E') return CellType::Target;
+    return CellType::Floor;
+}
 
-    // 3) Salida no transitable para enemigos
-    if (cell == 'X') return false;
+void Map::_classifyCell(int idx, char c) {
+    const CellType type = _classify(c);
 
-    // 4) Mecanismos en mayúsculas (puertas) no transitables
-    if (std::isupper(cell) && cell != 'P' && cell != 'E' && cell != 'K' && cell != 'X') {
-        return false;
-    }
+    _cells[idx] = static_cast<uint8_t>(type);
 
-    // 5) Todo lo demás es transitable (incluye minúsculas/botones)
-    return true;
+    const bool wall = (type == CellType::Wall);
+    const bool door = (type == CellType::Target);
+    _setBit(_wallMask, idx, wall);
+    _setBit(_doorMask, idx, door);
+    _setBit(_walkMask, idx, !wall);
+    _setBit(_enemyWalkMask, idx, !wall && !door && type != CellType::Exit);
 }
 
 /**
  * clearCell
  *  - Reemplaza la celda (x,y) por 'replacement' (por defecto, suelo '.').
  *  - Si la celda contenía una llave 'K', también la elimina del vector _keys.
+ *  - Reclasifica la celda para mantener _cells y las máscaras sincronizadas.
  *
  * @param x Columna de la celda a modificar.
  * @param y Fila de la celda a modificar.
@@ -195,7 +732,13 @@ bool Map::isWalkableForEnemy(int x, int y) const {
  */
 bool Map::clearCell(int x, int y, char replacement) {
     if (x < 0 || y < 0 || x >= _w || y >= _h) return false;
-    char &cell = _grid[y][x];
+
+    // Por chunks solo se puede tocar lo cargado (lo demás se ve como pared)
+    Chunk* chunk = _chunked ? _chunkAt(x, y) : nullptr;
+    if (_chunked && !chunk) return false;
+
+    char &cell = chunk ? chunk->chars[_chunkCell(x, y)] : _chars[index(x, y)];
+    _gridRowsValid = false;
 
     // Si había una 'K', retírala también del vector _keys
     if (cell == 'K') {
@@ -205,9 +748,148 @@ bool Map::clearCell(int x, int y, char replacement) {
     }
 
     cell = replacement;
+    if (chunk) {
+        _classifyChunkCell(*chunk, _chunkCell(x, y), replacement);
+        chunk->edited = true;
+    } else {
+        _classifyCell(index(x, y), replacement);
+    }
+    _recordNavChange(index(x, y));
+
+    // La capa horneada se repinta solo en esta celda en el siguiente prepareRender
+    if (_staticLayerReady) _dirtyCells.push_back(index(x, y));
+    return true;
+}
+
+/**
+ * setMechanismBlocked
+ *  - Actualiza el bit de la celda en _blockedMask (targets de mecanismo activos).
+ *  - Solo incrementa la revisión de navegación si el estado cambia realmente.
+ */
+void Map::setMechanismBlocked(int x, int y, bool blocked) {
+    if (!inBounds(x, y)) return;
+
+    const int idx = index(x, y);
+    if (_chunked) {
+        // El conjunto manda; el bit del chunk (si está cargado) es una copia
+        const bool changed = blocked ? _blockedCells.insert(idx).second : _blockedCells.erase(idx) > 0;
+        if (!changed) return;
+        if (Chunk* chunk = _chunkAt(x, y)) {
+            const uint64_t bit = uint64_t{1} << (x % MAP_CHUNK_SIZE);
+            uint64_t& row = chunk->masks[MASK_BLOCKED][y % MAP_CHUNK_SIZE];
+            row = blocked ? (row | bit) : (row & ~bit);
+        }
+        _recordNavChange(idx);
+        return;
+    }
+
+    if (_testBit(_blockedMask, idx) == blocked) return;
+
+    _setBit(_blockedMask, idx, blocked);
+    _recordNavChange(idx);
+}
+
+void Map::_recordNavChange(int idx) {
+    if (_navLog.size() >= MAX_NAV_LOG) {
+        markNavigationDirty();
+        return;
+    }
+    ++_navRevision;
+    _navLog.push_back(idx);
+}
+
+bool Map::navChangesSince(unsigned revision, std::vector<int>& cells) const {
+    cells.clear();
+    if (revision < _navLogBase || revision > _navRevision) return false;
+    cells.assign(_navLog.begin() + (revision - _navLogBase), _navLog.end());
     return true;
 }
 
+void Map::saveState(ByteWriter& out) const {
+    if (_chunked) throw std::runtime_error("Cannot save the state of a chunked map");
+    out.pod(_w);
+    out.pod(_h);
+    out.pod(_tile);
+    out.bytes(_chars.data(), _chars.size());
+    out.array(_cells);
+    out.array(_walkMask);
+    out.array(_enemyWalkMask);
+    out.array(_wallMask);
+    out.array(_doorMask);
+    out.array(_blockedMask);
+    out.pod(_player);
+    out.array(_enemies);
+    out.array(_keys);
+    out.array(_spikes);
+    out.array(_mechanisms);
+}
+
+/**
+ * restoreState
+ *  - Lee en el mismo orden que saveState().
+ *  - Con el mismo tamaño reutiliza la capa horneada: compara celda a celda y
+ *    apunta en _dirtyCells solo las celdas cambiadas (p.ej. llaves recogidas).
+ */
+void Map::restoreState(ByteReader& in) {
+    const int w = in.pod<int>();
+    const int h = in.pod<int>();
+    const int tile = in.pod<int>();
+    if (w <= 0 || h <= 0) throw std::runtime_error("Invalid map state size");
+
+    // Un estado guardado siempre es un mapa completo: se sale del modo por chunks
+    if (_chunked) {
+        _resetChunks();
+        _w = _h = 0;
+    }
+
+    const bool sameLayout = (w == _w && h == _h && tile == _tile);
+    if (!sameLayout) {
+        _unloadStaticLayer();
+        _dirtyCells.clear();
+    }
+
+    const size_t count = static_cast<size_t>(w) * static_cast<size_t>(h);
+    if (count > in.remaining()) throw std::runtime_error("Truncated binary data");
+    if (sameLayout && _staticLayerReady) {
+        // Solo se repintan las celdas que cambian
+        std::vector<char> chars(count);
+        in.bytes(chars.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            if (_chars[i] != chars[i]) _dirtyCells.push_back(static_cast<int>(i));
+        }
+        _chars.swap(chars);
+    } else {
+        _chars.resize(count);
+        in.bytes(_chars.data(), count);
+    }
+    _w = w;
+    _h = h;
+    _tile = tile;
+    _gridRowsValid = false;
+
+    in.array(_cells);
+    in.array(_walkMask);
+    in.array(_enemyWalkMask);
+    in.array(_wallMask);
+    in.array(_doorMask);
+    in.array(_blockedMask);
+    _player = in.pod<IVec2>();
+    in.array(_enemies);
+    in.array(_keys);
+    in.array(_spikes);
+    in.array(_mechanisms);
+
+    const size_t cellCount = static_cast<size_t>(_w) * static_cast<size_t>(_h);
+    const size_t maskWords = (cellCount + 63) / 64;
+    if (_cells.size() != cellCount || _walkMask.size() != maskWords || _enemyWalkMask.size() != maskWords ||
+        _wallMask.size() != maskWords || _doorMask.size() != maskWords || _blockedMask.size() != maskWords) {
+        throw std::runtime_error("Inconsistent map state");
+    }
+
+    // Mismo layout que al guardar, pero las cachés no pueden saberlo por la revisión
+    markNavigationDirty();
+}
+
 void Map::pairMechanisms(std::unordered_map<char, IVec2>& triggers, std::unordered_map<char, IVec2>& targets) {
     _mechanisms.clear();
 
@@ -250,32 +932,133 @@ void Map::pairMechanisms(std::unordered_map<char, IVec2>& triggers, std::unorder
     }
 }
 
-void Map::render(int ox, int oy) const {
-    if (_grid.empty()) return;
+Map::~Map() {
+    _unloadStaticLayer();
+}
+
+void Map::_unloadStaticLayer() {
+    if (_staticLayerReady) {
+        UnloadRenderTexture(_staticLayer);
+        _staticLayer = RenderTexture2D{};
+        _staticLayerReady = false;
+    }
+    _staticLayerTried = false;
+}
 
+void Map::_drawCell(int x, int y, float px, float py) const {
+    const char c = _charAt(x, y);
+
+    Rectangle destRect{ px, py, (float)_tile, (float)_tile };
+
+    // 1) Dibujar suelo base
+    DrawTexturePro(*_mapTexture, _floorSrc, destRect, {0,0}, 0.0f, WHITE);
+
+    // 2) Dibujar paredes
+    if (c == '#') {
+        DrawTexturePro(*_mapTexture, _wallSrc, destRect, {0,0}, 0.0f, WHITE);
+    }
+    // 3) Dibujar salida
+    else if (c == 'X') {
+        DrawTexturePro(*_mapTexture, _exitSrc, destRect, {0,0}, 0.0f, WHITE);
+    }
+}
 
+/**
+ * _bakeStaticLayer
+ *  - Crea un RenderTexture2D del tamaño del mapa y dibuja todas las celdas una vez.
+ *  - Si el mapa supera MAX_STATIC_LAYER_PX no se hornea (render() dibuja tile a tile).
+ */
+void Map::_bakeStaticLayer() {
+    _staticLayerTried = true;
+
+    const int wPx = _w * _tile;
+    const int hPx = _h * _tile;
+    if (wPx <= 0 || hPx <= 0 || wPx > MAX_STATIC_LAYER_PX || hPx > MAX_STATIC_LAYER_PX) return;
+
+    _staticLayer = LoadRenderTexture(wPx, hPx);
+    if (_staticLayer.id == 0) return;
+
+    BeginTextureMode(_staticLayer);
+    ClearBackground(BLANK);
     for (int y = 0; y < _h; ++y) {
         for (int x = 0; x < _w; ++x) {
-            const char c = _grid[y][x];
+            _drawCell(x, y, (float)(x * _tile), (float)(y * _tile));
+        }
+    }
+    EndTextureMode();
 
-            Rectangle destRect{
-                (float)(ox + x * _tile),
-                (float)(oy + y * _tile),
-                (float)_tile,
-                (float)_tile
-            };
+    _staticLayerReady = true;
+    _dirtyCells.clear();
+}
 
-            // 1) Dibujar suelo base
-            DrawTexturePro(*_mapTexture, _floorSrc, destRect, {0,0}, 0.0f, WHITE);
+void Map::_refreshDirtyCells() {
+    if (_dirtyCells.empty()) return;
 
-            // 2) Dibujar paredes
-            if (c == '#') {
-                DrawTexturePro(*_mapTexture, _wallSrc, destRect, {0,0}, 0.0f, WHITE);
-            }
-            // 3) Dibujar salida
-            else if (c == 'X') {
-                DrawTexturePro(*_mapTexture, _exitSrc, destRect, {0,0}, 0.0f, WHITE);
-            }
+    BeginTextureMode(_staticLayer);
+
+    // 1) Borrar las celdas (los sprites tienen transparencia): BLANK sustituye al
+    //    píxel en vez de mezclarse, sin tocar el recorte del llamador
+    rlSetBlendFactors(RL_ONE, RL_ZERO, RL_FUNC_ADD);
+    BeginBlendMode(BLEND_CUSTOM);
+    for (int idx : _dirtyCells) {
+        DrawRectangle((idx % _w) * _tile, (idx / _w) * _tile, _tile, _tile, BLANK);
+    }
+    EndBlendMode();
+
+    // 2) Repintarlas con la mezcla alfa normal
+    for (int idx : _dirtyCells) {
+        const int x = idx % _w;
+        const int y = idx / _w;
+        _drawCell(x, y, (float)(x * _tile), (float)(y * _tile));
+    }
+    EndTextureMode();
+
+    _dirtyCells.clear();
+}
+
+void Map::prepareRender() {
+    if (_w == 0 || !_mapTexture || _chunked) return;
+
+    // restoreState con otro tamaño descarta la capa: se vuelve a hornear una vez
+    if (!_staticLayerTried) _bakeStaticLayer();
+    if (_staticLayerReady) _refreshDirtyCells();
+}
+
+void Map::render(int ox, int oy) {
+    render(ox, oy, Rectangle{ 0.0f, 0.0f, (float)(_w * _tile), (float)(_h * _tile) });
+}
+
+void Map::render(int ox, int oy, const Rectangle& visible) {
+    if (_w == 0 || !_mapTexture) return;
+
+    // Recorte del rectángulo visible a los límites del mapa (en píxeles de mundo)
+    const float mapWpx = (float)(_w * _tile);
+    const float mapHpx = (float)(_h * _tile);
+    const float vx0 = std::max(visible.x, 0.0f);
+    const float vy0 = std::max(visible.y, 0.0f);
+    const float vx1 = std::min(visible.x + visible.width, mapWpx);
+    const float vy1 = std::min(visible.y + visible.height, mapHpx);
+    if (vx1 <= vx0 || vy1 <= vy0) return;
+
+    if (_staticLayerReady) {
+        // Un único quad con la porción visible; la textura de un RenderTexture está invertida en Y
+        const Texture2D& tex = _staticLayer.texture;
+        const float vw = vx1 - vx0;
+        const float vh = vy1 - vy0;
+        Rectangle src{ vx0, (float)tex.height - vy0 - vh, vw, -vh };
+        Rectangle dst{ ox + vx0, oy + vy0, vw, vh };
+        DrawTexturePro(tex, src, dst, Vector2{ 0.0f, 0.0f }, 0.0f, WHITE);
+        return;
+    }
+
+    // Mapa demasiado grande para hornearlo (o por chunks): dibujado tile a tile, solo lo visible
+    const int x0 = (int)(vx0 / _tile);
+    const int y0 = (int)(vy0 / _tile);
+    const int x1 = std::min(_w - 1, (int)(vx1 / _tile));
+    const int y1 = std::min(_h - 1, (int)(vy1 / _tile));
+    for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+            _drawCell(x, y, (float)(ox + x * _tile), (float)(oy + y * _tile));
         }
     }
 }
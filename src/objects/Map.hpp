@@ -1,22 +1,44 @@
 #pragma once
+#include <array>
 #include <string>
 #include <vector>
+#include <cstdint>
 #include <stdexcept>
 #include <algorithm>
 #include "core/Config.hpp"
 #include <iostream>
 #include "Mechanism.hpp"
 #include <unordered_map>
+#include <unordered_set>
 #include "core/ResourceManager.hpp"
+#include "core/BinaryIO.hpp"
+#include "core/MappedFile.hpp"
 
 extern "C" {
     #include <raylib.h>
 }
 
+/**
+ * Tipo de celda clasificado una sola vez al cargar el mapa.
+ * Se guarda como uint8_t en un array contiguo (fila a fila) para que las
+ * consultas de la IA y del input no tengan que volver a interpretar caracteres.
+ */
+enum class CellType : uint8_t {
+    Floor,    // '.', 'P', 'E' y cualquier otro caracter transitable
+    Wall,     // '#'
+    Exit,     // 'X'
+    Key,      // 'K'
+    Spike,    // '^'
+    Trigger,  // minúsculas (botones/palancas de mecanismo)
+    Target    // mayúsculas de mecanismo (puertas, trampas, puentes...)
+};
+
 /**
  * Clase Map
  *  - Carga un mapa ASCII desde archivo.
  *  - Mantiene la rejilla (grid) como vector de strings.
+ *  - Mantiene en paralelo un array plano de CellType y máscaras de bits
+ *    (walkable jugador, walkable enemigo, pared, puerta) para consultas O(1).
  *  - Expone utilidades para consultar celdas y posiciones iniciales.
  *
  * Formato del mapa (caracteres):
@@ -31,6 +53,14 @@ extern "C" {
  *  - Existe exactamente una 'P'; si no, lanza std::runtime_error.
  *  - _w y _h reflejan el tamaño en celdas (ancho x alto).
  *  - _tile contiene el tamaño de celda en píxeles (para dibujado).
+ *
+ * Modo por chunks (loadChunked, archivos .lvc):
+ *  - Para mapas enormes: las celdas se guardan en chunks de MAP_CHUNK_SIZE²
+ *    que se cargan del archivo con loadChunk() y se descargan con unloadChunk()
+ *    (lo decide StreamMapChunks según la posición del jugador).
+ *  - Las celdas de chunks no cargados se comportan como pared.
+ *  - chars(), cells(), enemyStarts() y spikesStarts() quedan vacíos: los spawns
+ *    se leen de cada chunk al cargarlo. playerStart(), llaves y mecanismos son globales.
  */
 class Map {
     public:
@@ -43,6 +73,88 @@ class Map {
          */
         bool loadFromFile(const std::string& path, int tileSize = 32);
 
+        /// Versión del formato binario de nivel (.lvl). Subirla al cambiar saveState().
+        static constexpr uint32_t BINARY_VERSION = 1;
+
+        /**
+         * Carga un nivel compilado con mapc (formato binario .lvl).
+         *  - Una sola lectura del archivo y copia directa de los arrays: sin parseo,
+         *    sin reclasificar celdas ni emparejar mecanismos.
+         *  - Contenido: cabecera (magic "MAPB", versión, tamaño) + saveState().
+         * @throws std::runtime_error si no se puede abrir, la cabecera o la versión
+         *         no coinciden o los datos están truncados.
+         */
+        bool loadFromBinary(const std::string& path, int tileSize = 32);
+
+        /**
+         * Escribe el mapa cargado en formato binario .lvl (lo usa la herramienta mapc).
+         * @throws std::runtime_error si no se puede escribir el archivo.
+         */
+        void saveBinary(const std::string& path) const;
+
+        /// Versión del formato por chunks (.lvc).
+        static constexpr uint32_t CHUNKED_VERSION = 1;
+
+        /**
+         * Abre un mapa por chunks (.lvc, generado con mapc) sin cargar ninguna celda.
+         *  - Solo lee la cabecera (tamaño, jugador, llaves y mecanismos) y el
+         *    directorio de chunks; el archivo queda proyectado para loadChunk().
+         *  - Memoria y tiempo de carga dependen de los chunks cargados, no del mapa.
+         * @throws std::runtime_error si no se puede abrir, la cabecera o la versión
+         *         no coinciden o el directorio apunta fuera del archivo.
+         */
+        bool loadChunked(const std::string& path, int tileSize = 32);
+
+        /**
+         * Escribe el mapa cargado en formato por chunks .lvc (lo usa mapc).
+         * Los chunks que son todo pared no ocupan espacio en el archivo.
+         * @throws std::runtime_error si no se puede escribir o el mapa ya es por chunks.
+         */
+        void saveChunked(const std::string& path) const;
+
+        /**
+         * Tamaño (celdas) de un mapa sin cargarlo: cabecera de un .lvl/.lvc o, si es
+         * texto, número de filas y largo de la primera. No valida el contenido.
+         * @return false si no se puede abrir o un compilado está truncado o es de otra versión.
+         */
+        static bool peekSize(const std::string& path, int& width, int& height);
+
+        /// true si el mapa se abrió con loadChunked().
+        bool isChunked() const { return _chunked; }
+
+        /// Chunks a lo ancho y a lo alto (0 si el mapa no es por chunks).
+        int chunksX() const { return _chunksX; }
+        int chunksY() const { return _chunksY; }
+
+        /// Chunk (índice fila a fila) que contiene la celda (x,y). No comprueba rango.
+        int chunkOf(int x, int y) const { return (y / MAP_CHUNK_SIZE) * _chunksX + x / MAP_CHUNK_SIZE; }
+
+        /// true si el chunk está cargado. En mapas normales todo está "cargado".
+        bool isChunkResident(int chunk) const { return !_chunked || _chunkSlot[chunk] >= 0; }
+
+        /// true si alguna celda del rectángulo (inclusive) está cargada.
+        bool isRegionResident(int x0, int y0, int x1, int y1) const;
+
+        /**
+         * Carga el chunk desde el archivo (o desde sus cambios guardados al descargarlo).
+         *  - Cambia navRevision() con celdas representativas de cada cluster de
+         *    NavHierarchy (NAV_CLUSTER_SIZE), para que solo se rehaga esa zona.
+         * @return true si no estaba cargado.
+         */
+        bool loadChunk(int chunk);
+
+        /// Descarga el chunk; si clearCell lo había modificado se guarda su copia.
+        void unloadChunk(int chunk);
+
+        /// Marca el chunk como usado ahora (orden LRU de chunkLastUse()).
+        void touchChunk(int chunk);
+
+        /// Momento del último uso del chunk (contador creciente; 0 si no está cargado).
+        uint64_t chunkLastUse(int chunk) const;
+
+        /// Chunks cargados, sin orden concreto.
+        const std::vector<int>& residentChunks() const { return _residentChunks; }
+
         /// Dimensiones del mapa en celdas (grid), no en píxeles.
         int width()  const { return _w; }
         int height() const { return _h; }
@@ -69,6 +181,79 @@ class Map {
          */
         bool isWalkableForEnemy(int x, int y) const;
 
+        /// true si (x,y) está dentro del mapa y es pared ('#'). Fuera de rango → false.
+        bool isWall(int x, int y) const {
+            if (!inBounds(x, y)) return false;
+            return _chunked ? _chunkBit(MASK_WALL, x, y, true) : _testBit(_wallMask, index(x, y));
+        }
+
+        /// true si (x,y) está dentro del mapa y es un target de mecanismo (mayúscula: puerta, trampa...).
+        bool isDoor(int x, int y) const {
+            if (!inBounds(x, y)) return false;
+            return _chunked ? _chunkBit(MASK_DOOR, x, y, false) : _testBit(_doorMask, index(x, y));
+        }
+
+        /**
+         * true si (x,y) está ocupada por el target de un mecanismo todavía activo.
+         * Lo mantiene el ECS: LevelSetupSystem lo marca y MechanismSystem lo limpia.
+         */
+        bool isMechanismBlocked(int x, int y) const {
+            if (!inBounds(x, y)) return false;
+            return _chunked ? _chunkBit(MASK_BLOCKED, x, y, false) : _testBit(_blockedMask, index(x, y));
+        }
+
+        /// Marca/desmarca (x,y) como bloqueada por un mecanismo. Cambia navRevision() si el valor cambia.
+        void setMechanismBlocked(int x, int y, bool blocked);
+
+        /**
+         * Tipo de celda precalculado en (x,y).
+         * Fuera de rango devuelve CellType::Wall (equivale a "no transitable").
+         */
+        CellType cellType(int x, int y) const {
+            if (!inBounds(x, y)) return CellType::Wall;
+            if (_chunked) {
+                const Chunk* chunk = _chunkAt(x, y);
+                return chunk ? static_cast<CellType>(chunk->cells[_chunkCell(x, y)]) : CellType::Wall;
+            }
+            return static_cast<CellType>(_cells[index(x, y)]);
+        }
+
+        /// true si (x,y) está dentro de los límites del mapa.
+        bool inBounds(int x, int y) const {
+            return static_cast<unsigned>(x) < static_cast<unsigned>(_w) &&
+                   static_cast<unsigned>(y) < static_cast<unsigned>(_h);
+        }
+
+        /// Índice lineal fila a fila (y * width + x). No comprueba rango.
+        int index(int x, int y) const { return y * _w + x; }
+
+        /// Array plano de tipos de celda (tamaño width*height, fila a fila; vacío por chunks).
+        const std::vector<uint8_t>& cells() const { return _cells; }
+
+        /**
+         * Revisión de navegación: se incrementa cada vez que cambia la transitabilidad
+         * (loadFromFile, clearCell o setMechanismBlocked).
+         * Las cachés derivadas (p.ej. FlowField) la comparan para saber si recalcular.
+         */
+        unsigned navRevision() const { return _navRevision; }
+
+        /// Marca la navegación como modificada sin tocar ninguna celda.
+        /// Sin celdas concretas, el historial de cambios deja de servir (ver navChangesSince()).
+        void markNavigationDirty() {
+            ++_navRevision;
+            _navLog.clear();
+            _navLogBase = _navRevision;
+        }
+
+        /**
+         * Celdas (índice lineal) cuya transitabilidad cambió después de 'revision'
+         * (clearCell, setMechanismBlocked), en orden y quizá repetidas.
+         * Permite a las cachés por zonas (p.ej. NavHierarchy) rehacer solo lo tocado.
+         * @return false si el historial no llega hasta 'revision' (recarga,
+         *         markNavigationDirty o demasiados cambios): hay que recalcular todo.
+         */
+        bool navChangesSince(unsigned revision, std::vector<int>& cells) const;
+
         /// Posición inicial del jugador (en celdas). Garantizado tras loadFromFile().
         IVec2 playerStart() const { return _player; }
 
@@ -86,8 +271,14 @@ class Map {
         /// Posiciones iniciales de enemigos (en celdas). Puede estar vacío.
         const std::vector<IVec2>& enemyStarts() const { return _enemies; }
 
-        /// Acceso de solo lectura al grid completo (útil para debug o validaciones).
-        const std::vector<std::string>& grid() const { return _grid; }
+        /**
+         * Acceso de solo lectura al grid completo como filas (útil para debug o validaciones).
+         * Se construye bajo demanda a partir de chars(): no usar en bucles calientes.
+         */
+        const std::vector<std::string>& grid() const;
+
+        /// Caracteres del mapa en un array contiguo fila a fila (tamaño width*height; vacío por chunks).
+        const std::vector<char>& chars() const { return _chars; }
 
         /// Posiciones iniciales de pinchos (en celdas). Puede estar vacío.
         const std::vector<IVec2>& spikesStarts() const { return _spikes; }
@@ -95,6 +286,22 @@ class Map {
         /// Posiciones iniciales de mecanismos (en celdas). Puede estar vacío.
         const std::vector<MechanismPair>& getMechanisms() const { return _mechanisms;}
         
+        /**
+         * Vuelca el estado lógico completo (rejilla, tipos, máscaras, spawns,
+         * llaves y mecanismos) como arrays POD. No incluye texturas ni la capa horneada.
+         * @throws std::runtime_error en mapas por chunks (no tienen el mapa entero en memoria).
+         */
+        void saveState(ByteWriter& out) const;
+
+        /**
+         * Restaura un estado de saveState() sin releer el archivo del mapa.
+         *  - Cambia navRevision() (las cachés de navegación se consideran obsoletas).
+         *  - Si el tamaño coincide, solo se repintan las celdas que difieren en la
+         *    capa horneada; si no, se vuelve a hornear en el siguiente prepareRender.
+         * @throws std::runtime_error si los datos están truncados o son incoherentes.
+         */
+        void restoreState(ByteReader& in);
+
         //Emparejamiento de mecanismos trigger-target
         void pairMechanisms(std::unordered_map<char, IVec2>& triggers,
             std::unordered_map<char, IVec2>& targets);
@@ -102,11 +309,31 @@ class Map {
         // Dibujar el mapa en pantalla usando offsets en píxeles (ox, oy).
         // Esta función encapsula el dibujo de celdas y puede ser llamada
         // desde estados como `MainGameState`.
-        void render(int ox, int oy) const;
+        // La capa estática (suelo, paredes, salida) se hornea una vez en un
+        // RenderTexture2D; render() solo emite dibujo (ver prepareRender).
+        void render(int ox, int oy);
+
+        // Igual que render(ox, oy) pero solo dibuja la parte del mapa dentro de
+        // 'visible' (rectángulo en píxeles de mundo, sin offset).
+        void render(int ox, int oy, const Rectangle& visible);
 
-        //Cargamos las texturas del mapa mediante el ResourceManager y selecionamos los rectangulos fuente
+        // Pone al día la capa horneada antes de dibujar: la vuelve a hornear si
+        // restoreState la descartó y repinta las celdas marcadas por clearCell.
+        // Cambia de render target: llamarla fuera de BeginScissorMode/BeginMode2D.
+        void prepareRender();
+
+        //Cargamos las texturas del mapa mediante el ResourceManager y selecionamos los rectangulos fuente.
+        //También hornea la capa estática (salvo por chunks o si ya estaba horneada).
         void loadTextures();
 
+        // Libera la capa estática horneada (si existe).
+        ~Map();
+
+        // El Map posee un recurso de GPU (RenderTexture2D): no se copia.
+        Map() = default;
+        Map(const Map&) = delete;
+        Map& operator=(const Map&) = delete;
+
     private:
         // Dimensiones en celdas
         int _w = 0, _h = 0;
@@ -114,8 +341,136 @@ class Map {
         // Tamaño del tile en píxeles (para render); no afecta a la lógica.
         int _tile = 32;
 
-        // Rejilla de caracteres: cada string es una fila; grid[y][x] es la celda.
-        std::vector<std::string> _grid;
+        // Caracteres del mapa en un único array fila a fila: _chars[y*_w + x].
+        std::vector<char> _chars;
+
+        // Copia por filas para grid(); se invalida al cambiar cualquier celda.
+        mutable std::vector<std::string> _gridRows;
+        mutable bool _gridRowsValid = false;
+
+        // Tipos de celda (CellType) en un array contiguo fila a fila: _cells[y*_w + x].
+        std::vector<uint8_t> _cells;
+
+        // Máscaras de bits empaquetadas (1 bit por celda, mismo índice que _cells).
+        std::vector<uint64_t> _walkMask;       // transitable para el jugador
+        std::vector<uint64_t> _enemyWalkMask;  // transitable para enemigos
+        std::vector<uint64_t> _wallMask;       // paredes '#'
+        std::vector<uint64_t> _doorMask;       // targets de mecanismo (mayúsculas)
+        std::vector<uint64_t> _blockedMask;    // targets de mecanismo activos (estado del ECS)
+
+        // Contador de cambios de transitabilidad (ver navRevision()).
+        unsigned _navRevision = 0;
+
+        // Historial de celdas cambiadas: _navLog[i] produjo la revisión _navLogBase + i + 1.
+        std::vector<int> _navLog;
+        unsigned _navLogBase = 0;
+
+        // Tope del historial; si se llena se vacía y los consumidores recalculan todo.
+        static constexpr size_t MAX_NAV_LOG = 4096;
+
+        // Incrementa navRevision() apuntando la celda idx en el historial.
+        void _recordNavChange(int idx);
+
+        // Tipo de celda del caracter 'c' (reglas en Map.cpp).
+        static CellType _classify(char c);
+
+        // Clasifica el caracter 'c' y actualiza _cells y las máscaras en la posición idx.
+        void _classifyCell(int idx, char c);
+
+        // ---- Modo por chunks ----
+        static_assert(MAP_CHUNK_SIZE == 64, "Cada fila de un chunk ocupa exactamente una palabra de máscara");
+        static_assert(MAP_CHUNK_SIZE % NAV_CLUSTER_SIZE == 0, "Los clusters de NavHierarchy no cruzan chunks");
+        static constexpr int CHUNK_CELLS = MAP_CHUNK_SIZE * MAP_CHUNK_SIZE;
+
+        // Máscaras de un chunk (mismo significado que las densas)
+        enum ChunkMask { MASK_WALK, MASK_ENEMY_WALK, MASK_WALL, MASK_DOOR, MASK_BLOCKED, MASK_COUNT };
+
+        struct Chunk {
+            std::array<char, CHUNK_CELLS> chars;      // fila a fila; '#' fuera del mapa
+            std::array<uint8_t, CHUNK_CELLS> cells;
+            uint64_t masks[MASK_COUNT][MAP_CHUNK_SIZE]; // una palabra por fila
+            uint64_t lastUse = 0;
+            bool edited = false;                        // clearCell lo ha tocado
+        };
+
+        bool _chunked = false;
+        int _chunksX = 0, _chunksY = 0;
+        MappedFile _chunkFile;
+        std::vector<uint64_t> _chunkOffsets;   // por chunk: posición en _chunkFile (0 = todo pared)
+        std::vector<int> _chunkSlot;           // por chunk: posición en _chunkPool (-1 = no cargado)
+        std::vector<Chunk> _chunkPool;
+        std::vector<int> _freeSlots;
+        std::vector<int> _residentChunks;
+        uint64_t _chunkClock = 0;
+
+        // Caracteres de los chunks modificados que se han descargado (se recuperan al volver).
+        std::unordered_map<int, std::vector<char>> _chunkEdits;
+
+        // Targets de mecanismo activos (índice lineal), también los de chunks sin cargar.
+        // Al cargar un chunk se copian a su MASK_BLOCKED.
+        std::unordered_set<int> _blockedCells;
+
+        const Chunk* _chunkAt(int x, int y) const {
+            const int slot = _chunkSlot[chunkOf(x, y)];
+            return slot >= 0 ? &_chunkPool[slot] : nullptr;
+        }
+        Chunk* _chunkAt(int x, int y) {
+            const int slot = _chunkSlot[chunkOf(x, y)];
+            return slot >= 0 ? &_chunkPool[slot] : nullptr;
+        }
+        static int _chunkCell(int x, int y) { return (y % MAP_CHUNK_SIZE) * MAP_CHUNK_SIZE + x % MAP_CHUNK_SIZE; }
+
+        // Bit de la máscara 'mask' en (x,y); 'unloaded' es el valor para chunks sin cargar.
+        bool _chunkBit(ChunkMask mask, int x, int y, bool unloaded) const {
+            const Chunk* chunk = _chunkAt(x, y);
+            if (!chunk) return unloaded;
+            return (chunk->masks[mask][y % MAP_CHUNK_SIZE] >> (x % MAP_CHUNK_SIZE)) & 1u;
+        }
+
+        // Caracter en (x,y) sin comprobar rango ('#' si el chunk no está cargado).
+        char _charAt(int x, int y) const {
+            if (!_chunked) return _chars[index(x, y)];
+            const Chunk* chunk = _chunkAt(x, y);
+            return chunk ? chunk->chars[_chunkCell(x, y)] : '#';
+        }
+
+        static void _classifyChunkCell(Chunk& chunk, int cell, char c);
+
+        // Apunta en el historial una celda por esquina de cada cluster de navegación del chunk.
+        void _recordChunkChange(int chunk);
+
+        // Vuelve al modo normal liberando chunks, archivo y cambios guardados.
+        void _resetChunks();
+
+        // Carga en una pasada: clasifica la fila y de 'row' (ya validada) y apunta
+        // spawns, llaves, pinchos y letras de mecanismo.
+        void _appendRow(const char* row, int y, std::unordered_map<char, IVec2>& triggers,
+                        std::unordered_map<char, IVec2>& targets);
+
+        // Celda especial (ni '.' ni '#') durante la carga: clasificación + listas.
+        void _scanSpecial(int x, int y, char c, std::unordered_map<char, IVec2>& triggers,
+                          std::unordered_map<char, IVec2>& targets);
+
+        // Garantiza espacio para 'rows' filas en _chars, _cells y máscaras (crece x2).
+        void _reserveRows(int rows);
+
+        // OR de hasta 32 bits (bit 0 = celda idx) en la máscara; pueden cruzar una palabra.
+        static void _orBits(std::vector<uint64_t>& mask, size_t idx, uint32_t bits) {
+            if (!bits) return;
+            const size_t word = idx >> 6;
+            const unsigned shift = static_cast<unsigned>(idx & 63);
+            mask[word] |= static_cast<uint64_t>(bits) << shift;
+            if (shift > 32) mask[word + 1] |= static_cast<uint64_t>(bits) >> (64 - shift);
+        }
+
+        static bool _testBit(const std::vector<uint64_t>& mask, int idx) {
+            return (mask[static_cast<size_t>(idx) >> 6] >> (idx & 63)) & 1u;
+        }
+        static void _setBit(std::vector<uint64_t>& mask, int idx, bool value) {
+            const uint64_t bit = uint64_t{1} << (idx & 63);
+            if (value) mask[static_cast<size_t>(idx) >> 6] |= bit;
+            else       mask[static_cast<size_t>(idx) >> 6] &= ~bit;
+        }
 
         // Spawns detectados al cargar:
         IVec2 _player{ -1, -1 };
@@ -137,5 +492,27 @@ class Map {
         Rectangle _wallSrc;
         Rectangle _exitSrc;
         Rectangle _keySrc;
+
+        // Capa estática horneada (tamaño width*tile x height*tile píxeles).
+        RenderTexture2D _staticLayer{};
+        bool _staticLayerReady = false;
+        bool _staticLayerTried = false;   // solo se intenta hornear una vez por carga
+
+        // Celdas (índice lineal) modificadas por clearCell pendientes de repintar.
+        std::vector<int> _dirtyCells;
+
+        // Tamaño máximo de la capa horneada; por encima se dibuja tile a tile.
+        static constexpr int MAX_STATIC_LAYER_PX = 8192;
+
+        // Dibuja el suelo y la pared/salida de la celda (x,y) en (px,py).
+        void _drawCell(int x, int y, float px, float py) const;
+
+        // Crea el RenderTexture2D y dibuja en él todas las celdas.
+        void _bakeStaticLayer();
+
+        // Repinta en la capa horneada solo las celdas de _dirtyCells.
+        void _refreshDirtyCells();
+
+        void _unloadStaticLayer();
         
 };
@@ -0,0 +1,445 @@
+#include "NavHierarchy.hpp"
+#include "core/JobSystem.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <unordered_map>
+
+namespace {
+    // Mismo orden de vecinos que FlowField y EnemyAISystem: abajo, arriba, derecha, izquierda.
+    const int kDx[4] = {0, 0, 1, -1};
+    const int kDy[4] = {1, -1, 0, 0};
+
+    // Claves del A* abstracto: (cluster << 16) | nodo; el objetivo tiene clave propia.
+    const long long kNoParent = -1;
+    const long long kGoalKey = -2;
+
+    bool Passable(const Map& map, int x, int y) {
+        return map.isWalkableForEnemy(x, y) && !map.isMechanismBlocked(x, y);
+    }
+
+    struct Record {
+        uint32_t g = UINT32_MAX;
+        long long parent = kNoParent;
+        bool closed = false;
+    };
+
+    struct OpenEntry {
+        uint32_t f;
+        long long key;
+        bool operator>(const OpenEntry& o) const { return f > o.f; }
+    };
+
+    // Memoria de trabajo por hilo: las consultas no reservan en régimen estable.
+    struct Scratch {
+        std::vector<int> queue;
+        std::vector<uint16_t> local;        // distancias BFS dentro de un cluster
+        std::vector<uint16_t> startCost;    // start → entradas de su cluster
+        std::vector<uint16_t> goalCost;     // entradas del cluster de goal → goal
+        std::unordered_map<long long, Record> records;
+        std::vector<OpenEntry> open;
+        std::vector<IVec2> route;
+    };
+
+    Scratch& GetScratch() {
+        thread_local Scratch scratch;
+        return scratch;
+    }
+
+    // BFS 4-vecinos limitado a [x0,x1]x[y0,y1]; 'source' siempre cuenta como transitable.
+    // dist queda indexado en coordenadas locales: (y - y0) * ancho + (x - x0).
+    void ClusterBfs(const Map& map, int x0, int y0, int x1, int y1, IVec2 source,
+                    std::vector<uint16_t>& dist, std::vector<int>& queue) {
+        const int w = x1 - x0 + 1;
+        const int h = y1 - y0 + 1;
+        dist.assign(static_cast<size_t>(w) * static_cast<size_t>(h), NavHierarchy::UNREACHABLE);
+        queue.clear();
+
+        const int start = (source.y - y0) * w + (source.x - x0);
+        dist[start] = 0;
+        queue.push_back(start);
+
+        for (size_t head = 0; head < queue.size(); ++head) {
+            const int idx = queue[head];
+            const int lx = idx % w;
+            const int ly = idx / w;
+            const uint16_t next = static_cast<uint16_t>(dist[idx] + 1);
+
+            for (int i = 0; i < 4; ++i) {
+                const int nx = lx + kDx[i];
+                const int ny = ly + kDy[i];
+                if (nx < 0 || ny < 0 || nx >= w || ny >= h) continue;
+                const int nidx = ny * w + nx;
+                if (dist[nidx] != NavHierarchy::UNREACHABLE) continue;
+                if (!Passable(map, x0 + nx, y0 + ny)) continue;
+                dist[nidx] = next;
+                queue.push_back(nidx);
+            }
+        }
+    }
+
+    uint32_t Manhattan(int ax, int ay, IVec2 b) {
+        return static_cast<uint32_t>(std::abs(ax - b.x) + std::abs(ay - b.y));
+    }
+}
+
+bool NavHierarchy::isStale(const Map& map, int clusterSize) const {
+    return !_valid ||
+           map.width() != _w || map.height() != _h ||
+           std::max(1, clusterSize) != _size ||
+           map.navRevision() != _revision;
+}
+
+size_t NavHierarchy::nodeCount() const {
+    size_t total = 0;
+    for (const auto& c : _clusters) total += c.nodes.size();
+    return total;
+}
+
+/**
+ * update
+ *  - Primera vez, cambio de tamaño o historial insuficiente: reconstrucción completa.
+ *  - Si no, cada celda cambiada ensucia su cluster y, si está en el borde, el
+ *    cluster vecino (las entradas de esa frontera dependen de ambos lados).
+ */
+bool NavHierarchy::update(const Map& map, int clusterSize) {
+    if (!isStale(map, clusterSize)) return false;
+
+    clusterSize = std::max(1, clusterSize);
+    const bool reshaped = !_valid || map.width() != _w || map.height() != _h || clusterSize != _size;
+
+    if (reshaped || !map.navChangesSince(_revision, _changed)) {
+        _w = map.width();
+        _h = map.height();
+        _size = clusterSize;
+        _buildAll(map);
+    } else {
+        std::vector<int> dirty;
+        for (int idx : _changed) {
+            const int x = idx % _w;
+            const int y = idx / _w;
+            const Cluster& c = _clusters[_clusterOf(x, y)];
+            dirty.push_back(_clusterOf(x, y));
+            if (x == c.x0 && x > 0)      dirty.push_back(_clusterOf(x - 1, y));
+            if (x == c.x1 && x + 1 < _w) dirty.push_back(_clusterOf(x + 1, y));
+            if (y == c.y0 && y > 0)      dirty.push_back(_clusterOf(x, y - 1));
+            if (y == c.y1 && y + 1 < _h) dirty.push_back(_clusterOf(x, y + 1));
+        }
+        std::sort(dirty.begin(), dirty.end());
+        dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+
+        for (int k : dirty) _buildCluster(map, k);
+        _lastRebuilt = dirty.size();
+    }
+
+    _revision = map.navRevision();
+    _valid = true;
+    return true;
+}
+
+void NavHierarchy::_buildAll(const Map& map) {
+    _cw = (_w + _size - 1) / _size;
+    _ch = (_h + _size - 1) / _size;
+    _clusters.assign(static_cast<size_t>(_cw) * static_cast<size_t>(_ch), Cluster{});
+
+    for (int cy = 0; cy < _ch; ++cy) {
+        for (int cx = 0; cx < _cw; ++cx) {
+            Cluster& c = _clusters[static_cast<size_t>(cy) * _cw + cx];
+            c.x0 = cx * _size;
+            c.y0 = cy * _size;
+            c.x1 = std::min(_w, c.x0 + _size) - 1;
+            c.y1 = std::min(_h, c.y0 + _size) - 1;
+        }
+    }
+
+    // Cada cluster solo escribe en sí mismo y lee el mapa: se reparten entre hilos
+    JobSystem::Get().parallelFor(_clusters.size(), NAV_CLUSTERS_PER_JOB, [this, &map](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) _buildCluster(map, static_cast<int>(k));
+    });
+    _lastRebuilt = _clusters.size();
+}
+
+/**
+ * _borderEntrances
+ *  - Recorre la frontera entre 'cluster' y su vecino en dirección (dx,dy) y busca
+ *    tramos donde ambos lados son transitables.
+ *  - Tramos cortos → una entrada en el centro; largos (>= NAV_ENTRANCE_SPLIT) →
+ *    una en cada extremo. Calculado igual desde ambos lados, así que las
+ *    entradas de los dos clusters quedan emparejadas celda a celda.
+ */
+void NavHierarchy::_borderEntrances(const Map& map, int cluster, int dx, int dy, std::vector<int>& out) const {
+    const Cluster& c = _clusters[cluster];
+    const bool vertical = (dx != 0);                 // frontera vertical (vecino a izquierda/derecha)
+    const int fixed = vertical ? (dx > 0 ? c.x1 : c.x0) : (dy > 0 ? c.y1 : c.y0);
+    const int other = fixed + (vertical ? dx : dy);
+    if (other < 0 || other >= (vertical ? _w : _h)) return;
+
+    const int from = vertical ? c.y0 : c.x0;
+    const int to   = vertical ? c.y1 : c.x1;
+
+    auto cellAt = [&](int along) { return vertical ? map.index(fixed, along) : map.index(along, fixed); };
+    auto open = [&](int along) {
+        return vertical ? (Passable(map, fixed, along) && Passable(map, other, along))
+                        : (Passable(map, along, fixed) && Passable(map, along, other));
+    };
+
+    int runStart = -1;
+    for (int a = from; a <= to + 1; ++a) {
+        const bool isOpen = (a <= to) && open(a);
+        if (isOpen && runStart < 0) runStart = a;
+        if (isOpen || runStart < 0) continue;
+
+        const int runEnd = a - 1;
+        if (runEnd - runStart + 1 >= NAV_ENTRANCE_SPLIT) {
+            out.push_back(cellAt(runStart));
+            out.push_back(cellAt(runEnd));
+        } else {
+            out.push_back(cellAt((runStart + runEnd) / 2));
+        }
+        runStart = -1;
+    }
+}
+
+void NavHierarchy::_buildCluster(const Map& map, int cluster) {
+    Cluster& c = _clusters[cluster];
+
+    // Mapa por chunks: un cluster sin cargar es todo pared, sin entradas
+    if (!map.isRegionResident(c.x0, c.y0, c.x1, c.y1)) {
+        c.nodes.clear();
+        c.dist.clear();
+        return;
+    }
+
+    Scratch& s = GetScratch();
+
+    s.queue.clear();
+    for (int i = 0; i < 4; ++i) _borderEntrances(map, cluster, kDx[i], kDy[i], s.queue);
+
+    // Una celda de esquina puede ser entrada de dos fronteras
+    c.nodes.clear();
+    for (int cell : s.queue) {
+        if (std::find(c.nodes.begin(), c.nodes.end(), cell) == c.nodes.end()) c.nodes.push_back(cell);
+    }
+
+    const size_t n = c.nodes.size();
+    const int localW = c.x1 - c.x0 + 1;
+    c.dist.assign(n * n, UNREACHABLE);
+
+    for (size_t i = 0; i < n; ++i) {
+        const IVec2 source{ c.nodes[i] % _w, c.nodes[i] / _w };
+        ClusterBfs(map, c.x0, c.y0, c.x1, c.y1, source, s.local, s.queue);
+        for (size_t j = 0; j < n; ++j) {
+            const int jx = c.nodes[j] % _w - c.x0;
+            const int jy = c.nodes[j] / _w - c.y0;
+            c.dist[i * n + j] = s.local[static_cast<size_t>(jy) * localW + jx];
+        }
+    }
+}
+
+int NavHierarchy::_nodeIndex(int cluster, int cell) const {
+    const auto& nodes = _clusters[cluster].nodes;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (nodes[i] == cell) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+/**
+ * findRoute
+ *  1) Mismo cluster y camino local: la ruta es directamente goal.
+ *  2) BFS locales para enlazar start y goal con las entradas de sus clusters.
+ *  3) A* sobre entradas: aristas internas (tabla del cluster) y cruces de
+ *     frontera (coste 1), con heurística Manhattan.
+ *  4) Si se agota el tope de expansiones, ruta parcial hasta la entrada cerrada
+ *     más cercana a goal: el enemigo avanza y vuelve a planificar desde allí.
+ */
+bool NavHierarchy::findRoute(const Map& map, IVec2 start, IVec2 goal, std::vector<IVec2>& waypoints,
+                             size_t maxExpansions) const {
+    waypoints.clear();
+    if (!_valid || !map.inBounds(start.x, start.y) || !map.inBounds(goal.x, goal.y)) return false;
+    if (start.x == goal.x && start.y == goal.y) {
+        waypoints.push_back(goal);
+        return true;
+    }
+
+    Scratch& s = GetScratch();
+    const int sc = _clusterOf(start.x, start.y);
+    const int gc = _clusterOf(goal.x, goal.y);
+    const Cluster& startCluster = _clusters[sc];
+    const Cluster& goalCluster = _clusters[gc];
+
+    auto localIndex = [](const Cluster& c, int x, int y) {
+        return static_cast<size_t>(y - c.y0) * (c.x1 - c.x0 + 1) + (x - c.x0);
+    };
+
+    // 1) y 2): costes desde start a las entradas de su cluster
+    ClusterBfs(map, startCluster.x0, startCluster.y0, startCluster.x1, startCluster.y1, start, s.local, s.queue);
+    if (sc == gc && s.local[localIndex(startCluster, goal.x, goal.y)] != UNREACHABLE) {
+        waypoints.push_back(goal);
+        return true;
+    }
+    s.startCost.resize(startCluster.nodes.size());
+    for (size_t i = 0; i < startCluster.nodes.size(); ++i) {
+        const int cell = startCluster.nodes[i];
+        s.startCost[i] = s.local[localIndex(startCluster, cell % _w, cell / _w)];
+    }
+
+    ClusterBfs(map, goalCluster.x0, goalCluster.y0, goalCluster.x1, goalCluster.y1, goal, s.local, s.queue);
+    s.goalCost.resize(goalCluster.nodes.size());
+    for (size_t i = 0; i < goalCluster.nodes.size(); ++i) {
+        const int cell = goalCluster.nodes[i];
+        s.goalCost[i] = s.local[localIndex(goalCluster, cell % _w, cell / _w)];
+    }
+
+    // Bolsas cerradas dentro de un cluster: sin entradas alcanzables no hay nada que buscar
+    const auto reachable = [](const std::vector<uint16_t>& costs) {
+        return std::any_of(costs.begin(), costs.end(), [](uint16_t d) { return d != UNREACHABLE; });
+    };
+    if (!reachable(s.startCost) || !reachable(s.goalCost)) return false;
+
+    // 3) A* abstracto
+    s.records.clear();
+    s.open.clear();
+    uint32_t goalG = UINT32_MAX;
+    long long goalParent = kNoParent;
+
+    auto push = [&](uint32_t f, long long key) {
+        s.open.push_back({ f, key });
+        std::push_heap(s.open.begin(), s.open.end(), std::greater<OpenEntry>());
+    };
+    auto relax = [&](int cluster, int node, uint32_t g, long long parent) {
+        const long long key = (static_cast<long long>(cluster) << 16) | node;
+        Record& r = s.records[key];
+        if (r.closed || g >= r.g) return;
+        r.g = g;
+        r.parent = parent;
+        const int cell = _clusters[cluster].nodes[node];
+        push(g + Manhattan(cell % _w, cell / _w, goal), key);
+    };
+
+    for (size_t i = 0; i < startCluster.nodes.size(); ++i) {
+        if (s.startCost[i] != UNREACHABLE) relax(sc, static_cast<int>(i), s.startCost[i], kNoParent);
+    }
+
+    bool found = false;
+    bool capped = false;
+    size_t expanded = 0;
+    long long bestKey = kNoParent;
+    uint32_t bestH = UINT32_MAX;
+    while (!s.open.empty()) {
+        std::pop_heap(s.open.begin(), s.open.end(), std::greater<OpenEntry>());
+        const OpenEntry top = s.open.back();
+        s.open.pop_back();
+
+        if (top.key == kGoalKey) {
+            found = true;
+            break;
+        }
+
+        Record& r = s.records[top.key];
+        if (r.closed) continue;
+        r.closed = true;
+
+        // Tope de expansiones: una consulta no debe recorrer todo el mapa
+        if (++expanded > maxExpansions) {
+            capped = true;
+            break;
+        }
+        const uint32_t g = r.g;
+
+        const int k = static_cast<int>(top.key >> 16);
+        const int i = static_cast<int>(top.key & 0xFFFF);
+        const Cluster& c = _clusters[k];
+        const size_t n = c.nodes.size();
+        const int cell = c.nodes[i];
+        const int cx = cell % _w;
+        const int cy = cell / _w;
+
+        const uint32_t h = Manhattan(cx, cy, goal);
+        if (h < bestH) {
+            bestH = h;
+            bestKey = top.key;
+        }
+
+        // Enlace con goal desde su cluster
+        if (k == gc && s.goalCost[i] != UNREACHABLE && g + s.goalCost[i] < goalG) {
+            goalG = g + s.goalCost[i];
+            goalParent = top.key;
+            push(goalG, kGoalKey);
+        }
+
+        // Aristas internas del cluster
+        for (size_t j = 0; j < n; ++j) {
+            const uint16_t d = c.dist[static_cast<size_t>(i) * n + j];
+            if (j != static_cast<size_t>(i) && d != UNREACHABLE) relax(k, static_cast<int>(j), g + d, top.key);
+        }
+
+        // Cruces de frontera hacia la entrada emparejada del vecino
+        for (int dir = 0; dir < 4; ++dir) {
+            const int nx = cx + kDx[dir];
+            const int ny = cy + kDy[dir];
+            if (!map.inBounds(nx, ny)) continue;
+            const int k2 = _clusterOf(nx, ny);
+            if (k2 == k) continue;
+            const int j = _nodeIndex(k2, map.index(nx, ny));
+            if (j >= 0) relax(k2, j, g + 1, top.key);
+        }
+    }
+    // Sin camino (se vació la lista abierta) o tope sin haber cerrado ninguna entrada
+    if (!found && (!capped || bestKey == kNoParent)) return false;
+
+    // Reconstrucción: de goal (o de la mejor entrada) hacia atrás por los padres
+    if (found) waypoints.push_back(goal);
+    for (long long key = found ? goalParent : bestKey; key != kNoParent; key = s.records[key].parent) {
+        const int cell = _clusters[key >> 16].nodes[key & 0xFFFF];
+        waypoints.push_back({ cell % _w, cell / _w });
+    }
+    std::reverse(waypoints.begin(), waypoints.end());
+
+    // start puede ser él mismo una entrada
+    if (waypoints.front().x == start.x && waypoints.front().y == start.y) waypoints.erase(waypoints.begin());
+    return !waypoints.empty();
+}
+
+bool NavHierarchy::stepToward(const Map& map, IVec2 from, IVec2 goal, IVec2& next) const {
+    Scratch& s = GetScratch();
+    if (from.x == goal.x && from.y == goal.y) return false;
+    if (!findRoute(map, from, goal, s.route)) return false;
+    return stepToWaypoint(map, from, s.route.front(), next);
+}
+
+bool NavHierarchy::stepToWaypoint(const Map& map, IVec2 from, IVec2 target, IVec2& next) const {
+    // Al otro lado de la frontera (o ya vecino): un paso directo
+    if (std::abs(target.x - from.x) + std::abs(target.y - from.y) == 1) {
+        next = target;
+        return true;
+    }
+
+    // Si no, el waypoint tiene que estar en el cluster de from
+    const Cluster& c = _clusters[_clusterOf(from.x, from.y)];
+    if (target.x < c.x0 || target.y < c.y0 || target.x > c.x1 || target.y > c.y1) return false;
+
+    // Bajar el gradiente de un BFS local desde el waypoint
+    Scratch& s = GetScratch();
+    const int localW = c.x1 - c.x0 + 1;
+    ClusterBfs(map, c.x0, c.y0, c.x1, c.y1, target, s.local, s.queue);
+
+    auto localDist = [&](int x, int y) {
+        if (x < c.x0 || y < c.y0 || x > c.x1 || y > c.y1) return UNREACHABLE;
+        return s.local[static_cast<size_t>(y - c.y0) * localW + (x - c.x0)];
+    };
+
+    uint16_t best = localDist(from.x, from.y);
+    bool found = false;
+    for (int i = 0; i < 4; ++i) {
+        const int nx = from.x + kDx[i];
+        const int ny = from.y + kDy[i];
+        const uint16_t d = localDist(nx, ny);
+        if (d < best) {
+            best = d;
+            next = { nx, ny };
+            found = true;
+        }
+    }
+    return found;
+}
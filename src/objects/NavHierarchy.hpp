@@ -0,0 +1,109 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "core/Config.hpp"
+#include "Map.hpp"
+
+/**
+ * Clase NavHierarchy (HPA*)
+ *  - Navegación jerárquica para mapas enormes: el mapa se parte en clusters de
+ *    NAV_CLUSTER_SIZE x NAV_CLUSTER_SIZE celdas. En cada frontera entre clusters
+ *    vecinos se crean entradas (pares de celdas transitables a ambos lados) y,
+ *    dentro de cada cluster, se precalcula la distancia entre sus entradas.
+ *  - Transitable = Map::isWalkableForEnemy y no bloqueada por mecanismo (como FlowField).
+ *  - Las consultas buscan con A* sobre el grafo abstracto (entradas), así que su
+ *    coste depende de la complejidad del camino y no del área del mapa.
+ *  - update() solo rehace los clusters tocados por clearCell/setMechanismBlocked
+ *    (y el vecino con el que comparten frontera), usando Map::navChangesSince().
+ *  - Las consultas son const y usan memoria de trabajo por hilo: pueden lanzarse
+ *    desde los trozos de JobSystem mientras nadie llame a update().
+ *  - EnemyAISystem la usa solo para perseguir (ruta guardada en EnemyPathComponent).
+ *    La patrulla sigue siendo un paseo local aleatorio: no hay rutas de patrulla
+ *    de largo alcance.
+ */
+class NavHierarchy {
+    public:
+        /// Distancia marcada para pares sin camino dentro de un cluster.
+        static constexpr uint16_t UNREACHABLE = 0xFFFF;
+
+        /**
+         * Construye o actualiza la jerarquía según la revisión de navegación del mapa.
+         * @return true si se ha reconstruido algún cluster.
+         */
+        bool update(const Map& map, int clusterSize = NAV_CLUSTER_SIZE);
+
+        /// Fuerza la reconstrucción completa en la siguiente llamada a update().
+        void invalidate() { _valid = false; }
+
+        /// true si el tamaño o la revisión del mapa no coinciden con la jerarquía.
+        bool isStale(const Map& map, int clusterSize = NAV_CLUSTER_SIZE) const;
+
+        /// Igual que DistanceOracle::adopt(): la navegación del mapa es la misma con la que se construyó.
+        void adopt(const Map& map) { if (_valid && map.width() == _w && map.height() == _h) _revision = map.navRevision(); }
+
+        size_t clusterCount() const { return _clusters.size(); }
+        /// Número total de entradas (nodos del grafo abstracto).
+        size_t nodeCount() const;
+        /// Clusters reconstruidos en la última llamada a update() (diagnóstico y tests).
+        size_t lastRebuildCount() const { return _lastRebuilt; }
+
+        /**
+         * Ruta abstracta de start a goal: celdas de entrada a atravesar, terminando en goal.
+         *  - goal puede no ser transitable para enemigos (jugador sobre la salida).
+         *  - Entre dos waypoints consecutivos hay camino dentro de un mismo cluster
+         *    o son celdas vecinas a ambos lados de una frontera.
+         *  - Si la búsqueda supera maxExpansions nodos la ruta es parcial: acaba en la
+         *    entrada explorada más cercana a goal (no en goal) y hay que replanificar al llegar.
+         * @return false si no hay camino.
+         */
+        bool findRoute(const Map& map, IVec2 start, IVec2 goal, std::vector<IVec2>& waypoints,
+                       size_t maxExpansions = NAV_MAX_EXPANSIONS) const;
+
+        /**
+         * Siguiente celda (vecina de from) por la ruta jerárquica hacia goal.
+         *  - Planifica la ruta entera en cada llamada: quien avance paso a paso
+         *    debe guardar la de findRoute y usar stepToWaypoint.
+         * @return false si ya está en goal o no hay camino.
+         */
+        bool stepToward(const Map& map, IVec2 from, IVec2 goal, IVec2& next) const;
+
+        /**
+         * Siguiente celda (vecina de from) hacia 'target', un waypoint de findRoute
+         * vecino de from o dentro de su mismo cluster. Solo hace un BFS del cluster.
+         * @return false si target no cumple eso o no se alcanza sin salir del cluster
+         *         (la ruta ya no vale: hay que volver a planificar).
+         */
+        bool stepToWaypoint(const Map& map, IVec2 from, IVec2 target, IVec2& next) const;
+
+        /// Cluster que contiene la celda (x,y); solo válido tras update().
+        int clusterOf(int x, int y) const { return _clusterOf(x, y); }
+
+    private:
+        struct Cluster {
+            int x0 = 0, y0 = 0, x1 = 0, y1 = 0;     // límites en celdas (inclusive)
+            std::vector<int> nodes;                  // celdas de entrada (índice lineal)
+            std::vector<uint16_t> dist;              // nodes.size()² distancias internas
+        };
+
+        int _w = 0, _h = 0;
+        int _size = 0;                  // lado del cluster en celdas
+        int _cw = 0, _ch = 0;           // clusters a lo ancho y a lo alto
+        unsigned _revision = 0;
+        bool _valid = false;
+        size_t _lastRebuilt = 0;
+
+        std::vector<Cluster> _clusters;
+
+        // Cambios de celdas leídos del mapa (reutilizado entre updates).
+        std::vector<int> _changed;
+
+        void _buildAll(const Map& map);
+        void _buildCluster(const Map& map, int cluster);
+        // Celdas de entrada de 'cluster' en la frontera con su vecino (dx,dy).
+        void _borderEntrances(const Map& map, int cluster, int dx, int dy, std::vector<int>& out) const;
+
+        int _clusterOf(int x, int y) const { return (y / _size) * _cw + (x / _size); }
+        // Posición de la celda 'cell' en los nodos de 'cluster'; -1 si no es entrada.
+        int _nodeIndex(int cluster, int cell) const;
+};
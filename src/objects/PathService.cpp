@@ -0,0 +1,190 @@
+#include "PathService.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+
+namespace {
+    struct OpenEntry {
+        uint32_t f;
+        int cell;
+        bool operator>(const OpenEntry& o) const { return f > o.f; }
+    };
+
+    /**
+     * Buffers de nodos de un hilo. Se dimensionan al tamaño del mapa una vez y
+     * se "vacían" subiendo la generación: una celda solo cuenta como visitada
+     * en esta consulta si su stamp coincide con la generación actual.
+     */
+    struct Workspace {
+        int w = 0, h = 0;
+        uint32_t generation = 0;
+        std::vector<uint32_t> stamp;
+        std::vector<uint32_t> g;
+        std::vector<int> parent;
+        std::vector<uint8_t> closed;
+        std::vector<OpenEntry> open;
+        std::vector<int> chain;
+
+        void begin(int width, int height) {
+            if (width != w || height != h) {
+                w = width;
+                h = height;
+                const size_t cells = static_cast<size_t>(w) * static_cast<size_t>(h);
+                stamp.assign(cells, 0);
+                g.resize(cells);
+                parent.resize(cells);
+                closed.resize(cells);
+                generation = 0;
+            }
+            if (++generation == 0) {
+                std::fill(stamp.begin(), stamp.end(), 0);
+                generation = 1;
+            }
+            open.clear();
+            chain.clear();
+        }
+    };
+
+    Workspace& GetWorkspace() {
+        thread_local Workspace workspace;
+        return workspace;
+    }
+
+    // Consulta sobre un mapa y un objetivo fijos (el objetivo siempre es transitable).
+    struct Grid {
+        const Map& map;
+        IVec2 goal;
+
+        bool open(int x, int y) const {
+            if (x == goal.x && y == goal.y) return true;
+            return map.isWalkableForEnemy(x, y) && !map.isMechanismBlocked(x, y);
+        }
+
+        // Salto horizontal: se para en goal o en una celda con vecino vertical forzado.
+        int jumpH(int x, int y, int dx) const {
+            while (true) {
+                x += dx;
+                if (!open(x, y)) return -1;
+                if (x == goal.x && y == goal.y) return map.index(x, y);
+                if ((open(x, y - 1) && !open(x - dx, y - 1)) ||
+                    (open(x, y + 1) && !open(x - dx, y + 1))) {
+                    return map.index(x, y);
+                }
+            }
+        }
+
+        // Salto vertical: se para en goal o donde un salto horizontal encuentra algo.
+        int jumpV(int x, int y, int dy) const {
+            while (true) {
+                y += dy;
+                if (!open(x, y)) return -1;
+                if (x == goal.x && y == goal.y) return map.index(x, y);
+                if (jumpH(x, y, 1) >= 0 || jumpH(x, y, -1) >= 0) return map.index(x, y);
+            }
+        }
+    };
+
+    int Sign(int v) { return (v > 0) - (v < 0); }
+}
+
+PathService& PathService::Get() {
+    // static garantiza que solo se crea una vez
+    static PathService instance;
+    return instance;
+}
+
+/**
+ * findPath
+ *  - A* sobre puntos de salto con heurística Manhattan (coste = distancia en celdas).
+ *  - Sucesores según cómo se llegó al nodo:
+ *      inicio      → las 4 direcciones;
+ *      horizontal  → seguir recto + giros verticales forzados;
+ *      vertical    → seguir recto + ambas horizontales.
+ */
+bool PathService::findPath(const Map& map, IVec2 start, IVec2 goal, std::vector<IVec2>& waypoints,
+                           size_t maxExpansions) const {
+    waypoints.clear();
+    if (!map.inBounds(start.x, start.y) || !map.inBounds(goal.x, goal.y)) return false;
+    if (start.x == goal.x && start.y == goal.y) {
+        waypoints.push_back(goal);
+        return true;
+    }
+
+    Workspace& ws = GetWorkspace();
+    ws.begin(map.width(), map.height());
+    const Grid grid{ map, goal };
+    const int w = map.width();
+    const int startIdx = map.index(start.x, start.y);
+    const int goalIdx = map.index(goal.x, goal.y);
+
+    auto heuristic = [&](int cell) {
+        return static_cast<uint32_t>(std::abs(cell % w - goal.x) + std::abs(cell / w - goal.y));
+    };
+    auto relax = [&](int cell, uint32_t g, int parent) {
+        if (ws.stamp[cell] == ws.generation) {
+            if (ws.closed[cell] || g >= ws.g[cell]) return;
+        } else {
+            ws.stamp[cell] = ws.generation;
+            ws.closed[cell] = 0;
+        }
+        ws.g[cell] = g;
+        ws.parent[cell] = parent;
+        ws.open.push_back({ g + heuristic(cell), cell });
+        std::push_heap(ws.open.begin(), ws.open.end(), std::greater<OpenEntry>());
+    };
+
+    relax(startIdx, 0, -1);
+
+    bool found = false;
+    size_t expanded = 0;
+    while (!ws.open.empty()) {
+        std::pop_heap(ws.open.begin(), ws.open.end(), std::greater<OpenEntry>());
+        const int cell = ws.open.back().cell;
+        ws.open.pop_back();
+
+        if (ws.closed[cell]) continue;
+        ws.closed[cell] = 1;
+        if (cell == goalIdx) {
+            found = true;
+            break;
+        }
+        if (++expanded > maxExpansions) break;
+
+        const int x = cell % w;
+        const int y = cell / w;
+        const int parent = ws.parent[cell];
+        const int dx = parent < 0 ? 0 : Sign(x - parent % w);
+        const int dy = parent < 0 ? 0 : Sign(y - parent / w);
+
+        auto tryJump = [&](int jump) {
+            if (jump < 0) return;
+            const uint32_t cost = static_cast<uint32_t>(std::abs(jump % w - x) + std::abs(jump / w - y));
+            relax(jump, ws.g[cell] + cost, cell);
+        };
+
+        if (parent < 0) {
+            tryJump(grid.jumpH(x, y, 1));
+            tryJump(grid.jumpH(x, y, -1));
+            tryJump(grid.jumpV(x, y, 1));
+            tryJump(grid.jumpV(x, y, -1));
+        } else if (dx != 0) {
+            tryJump(grid.jumpH(x, y, dx));
+            for (int side = -1; side <= 1; side += 2) {
+                if (grid.open(x, y + side) && !grid.open(x - dx, y + side)) tryJump(grid.jumpV(x, y, side));
+            }
+        } else {
+            tryJump(grid.jumpV(x, y, dy));
+            tryJump(grid.jumpH(x, y, 1));
+            tryJump(grid.jumpH(x, y, -1));
+        }
+    }
+    if (!found) return false;
+
+    // Puntos de salto de goal hacia atrás (sin la celda de partida)
+    for (int cell = goalIdx; cell != startIdx; cell = ws.parent[cell]) ws.chain.push_back(cell);
+    for (auto it = ws.chain.rbegin(); it != ws.chain.rend(); ++it) {
+        waypoints.push_back({ *it % w, *it / w });
+    }
+    return true;
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "core/Config.hpp"
+#include "Map.hpp"
+
+/**
+ * Clase PathService
+ *  - Búsqueda de caminos A* con poda Jump Point Search para rejillas de 4 vecinos
+ *    sobre Map::isWalkableForEnemy y el bloqueo de mecanismos (como FlowField).
+ *  - Orden canónico: los movimientos verticales pueden girar en cualquier celda;
+ *    los horizontales solo giran en vecinos forzados (esquinas de obstáculos).
+ *    Así solo se abren nodos en los puntos de giro y el camino sigue siendo óptimo.
+ *  - El resultado son waypoints comprimidos: cada uno está en la misma fila o
+ *    columna que el anterior (o que la celda de partida).
+ *  - Los buffers de nodos son por hilo y se reutilizan entre consultas: en
+ *    régimen estable una consulta no reserva memoria. Se puede llamar desde los
+ *    trozos de JobSystem.
+ */
+class PathService {
+    public:
+        // patron singleton: el servicio no tiene estado compartido entre hilos
+        static PathService& Get();
+
+        /**
+         * Camino más corto de start a goal (goal puede no ser transitable para
+         * enemigos, p.ej. el jugador sobre la salida).
+         * @param waypoints Se vacía y recibe los puntos de giro, terminando en goal.
+         * @return false si no hay camino o se superan maxExpansions nodos abiertos.
+         */
+        bool findPath(const Map& map, IVec2 start, IVec2 goal, std::vector<IVec2>& waypoints,
+                      size_t maxExpansions = PATH_MAX_EXPANSIONS) const;
+
+    private:
+        PathService() = default;
+};
@@ -0,0 +1,112 @@
+#include "VisibilityGrid.hpp"
+#include <algorithm>
+
+namespace {
+    // Transformaciones de los 8 octantes (xx, xy, yx, yy) para _castLight.
+    const int kOctants[8][4] = {
+        { 1,  0,  0,  1}, { 0,  1,  1,  0}, { 0, -1,  1,  0}, {-1,  0,  0,  1},
+        {-1,  0,  0, -1}, { 0, -1, -1,  0}, { 0,  1, -1,  0}, { 1,  0,  0, -1},
+    };
+
+    // Fuera del mapa cuenta como pared: la vista no se escapa por los bordes.
+    bool BlocksSight(const Map& map, int x, int y) {
+        return !map.inBounds(x, y) || map.isWall(x, y);
+    }
+}
+
+bool VisibilityGrid::isStale(const Map& map, IVec2 origin) const {
+    return !_valid ||
+           origin.x != _origin.x || origin.y != _origin.y ||
+           map.width() != _w || map.height() != _h ||
+           map.navRevision() != _revision;
+}
+
+bool VisibilityGrid::update(const Map& map, IVec2 origin) {
+    if (!isStale(map, origin)) return false;
+
+    _origin = origin;
+    _revision = map.navRevision();
+    _build(map);
+    _valid = true;
+    return true;
+}
+
+void VisibilityGrid::_light(int x, int y) {
+    const int idx = y * _w + x;
+    uint64_t& word = _bits[idx >> 6];
+    const uint64_t bit = uint64_t(1) << (idx & 63);
+    if (word & bit) return;
+    word |= bit;
+    _lit.push_back(idx);
+}
+
+/**
+ * _build
+ *  - Apaga solo las celdas encendidas la vez anterior (si el tamaño no cambia).
+ *  - Enciende el origen y lanza un barrido de sombras por cada octante.
+ */
+void VisibilityGrid::_build(const Map& map) {
+    const size_t words = (static_cast<size_t>(map.width()) * static_cast<size_t>(map.height()) + 63) / 64;
+    if (map.width() != _w || map.height() != _h || _bits.size() != words) {
+        _w = map.width();
+        _h = map.height();
+        _bits.assign(words, 0);
+    } else {
+        for (int idx : _lit) _bits[idx >> 6] &= ~(uint64_t(1) << (idx & 63));
+    }
+    _lit.clear();
+
+    if (!map.inBounds(_origin.x, _origin.y)) return;
+    _light(_origin.x, _origin.y);
+
+    const int radius = std::max(_w, _h);
+    for (const auto& o : kOctants) {
+        _castLight(map, 1, 1.0f, 0.0f, o[0], o[1], o[2], o[3], radius);
+    }
+}
+
+/**
+ * _castLight (shadowcasting recursivo)
+ *  - Recorre el octante fila a fila desde 'row', entre las pendientes start y end.
+ *  - Al encontrar una pared abre una sombra: la parte no tapada de la fila
+ *    siguiente se procesa recursivamente y el barrido continúa tras la pared.
+ */
+void VisibilityGrid::_castLight(const Map& map, int row, float start, float end,
+                                int xx, int xy, int yx, int yy, int radius) {
+    if (start < end) return;
+
+    const int radius2 = radius * radius;
+    float newStart = 0.0f;
+    bool blocked = false;
+
+    for (int j = row; j <= radius && !blocked; ++j) {
+        const int dy = -j;
+        for (int dx = -j; dx <= 0; ++dx) {
+            const int x = _origin.x + dx * xx + dy * xy;
+            const int y = _origin.y + dx * yx + dy * yy;
+            const float leftSlope  = (dx - 0.5f) / (dy + 0.5f);
+            const float rightSlope = (dx + 0.5f) / (dy - 0.5f);
+
+            if (start < rightSlope) continue;
+            if (end > leftSlope) break;
+
+            if (dx * dx + dy * dy <= radius2 && map.inBounds(x, y)) {
+                _light(x, y);
+            }
+
+            const bool wall = BlocksSight(map, x, y);
+            if (blocked) {
+                if (wall) {
+                    newStart = rightSlope;
+                    continue;
+                }
+                blocked = false;
+                start = newStart;
+            } else if (wall && j < radius) {
+                blocked = true;
+                _castLight(map, j + 1, start, leftSlope, xx, xy, yx, yy, radius);
+                newStart = rightSlope;
+            }
+        }
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "core/Config.hpp"
+#include "Map.hpp"
+
+/**
+ * Clase VisibilityGrid
+ *  - Celdas visibles desde una celda origen (el jugador), calculadas con
+ *    shadowcasting recursivo en 8 octantes. Las paredes bloquean la vista
+ *    (y ellas mismas se ven); fuera del mapa cuenta como pared.
+ *  - Se comparte entre todos los enemigos: se recalcula solo cuando cambia la
+ *    celda origen o la revisión del mapa (clearCell, mecanismos).
+ *  - La línea de visión enemigo-jugador pasa a ser una consulta O(1) a un bit.
+ */
+class VisibilityGrid {
+    public:
+        /**
+         * Recalcula la visibilidad si el origen o la revisión del mapa han cambiado.
+         * @return true si se ha reconstruido.
+         */
+        bool update(const Map& map, IVec2 origin);
+
+        /// Fuerza la reconstrucción en la siguiente llamada a update().
+        void invalidate() { _valid = false; }
+
+        /// true si el origen o la revisión del mapa no coinciden con el último cálculo.
+        bool isStale(const Map& map, IVec2 origin) const;
+
+        /// true si la celda (x,y) se ve desde el origen; false fuera de rango.
+        bool isVisible(int x, int y) const {
+            if ((unsigned)x >= (unsigned)_w || (unsigned)y >= (unsigned)_h) return false;
+            const int idx = y * _w + x;
+            return (_bits[idx >> 6] >> (idx & 63)) & 1u;
+        }
+
+        IVec2 origin() const { return _origin; }
+
+    private:
+        int _w = 0, _h = 0;
+        IVec2 _origin{ -1, -1 };
+        unsigned _revision = 0;
+        bool _valid = false;
+
+        // Un bit por celda (fila a fila, mismo índice que Map::cells()).
+        std::vector<uint64_t> _bits;
+        // Celdas encendidas en el último cálculo: limpiar cuesta O(celdas visibles).
+        std::vector<int> _lit;
+
+        void _build(const Map& map);
+        void _light(int x, int y);
+        void _castLight(const Map& map, int row, float start, float end,
+                        int xx, int xy, int yx, int yy, int radius);
+};
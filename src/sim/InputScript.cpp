@@ -0,0 +1,75 @@
+#include "InputScript.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+extern "C" {
+    #include <raylib.h>
+}
+
+static int KeyFromName(const std::string& name) {
+    static const std::unordered_map<std::string, int> KEYS = {
+        {"UP", KEY_UP}, {"DOWN", KEY_DOWN}, {"LEFT", KEY_LEFT}, {"RIGHT", KEY_RIGHT},
+        {"W", KEY_W}, {"A", KEY_A}, {"S", KEY_S}, {"D", KEY_D},
+        {"SPACE", KEY_SPACE}, {"ENTER", KEY_ENTER},
+    };
+    auto it = KEYS.find(name);
+    if (it == KEYS.end()) throw std::runtime_error("Unknown key in input script: " + name);
+    return it->second;
+}
+
+void InputScript::loadFromFile(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("Cannot open input script: " + path);
+
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    loadFromString(buffer.str());
+}
+
+void InputScript::loadFromString(const std::string& text) {
+    _steps.clear();
+    _totalFrames = 0;
+
+    std::istringstream lines(text);
+    std::string line;
+    while (std::getline(lines, line)) {
+        std::istringstream tokens(line);
+        std::string framesTok;
+        if (!(tokens >> framesTok) || framesTok[0] == '#') continue;
+
+        int count = 0;
+        try {
+            count = std::stoi(framesTok);
+        } catch (const std::exception&) {
+            throw std::runtime_error("Invalid frame count in input script: " + framesTok);
+        }
+        if (count <= 0) throw std::runtime_error("Invalid frame count in input script: " + framesTok);
+
+        std::string keysTok = "NONE";
+        tokens >> keysTok;
+
+        Step step{_totalFrames + count, {}};
+        if (keysTok != "NONE") {
+            std::istringstream names(keysTok);
+            std::string name;
+            while (std::getline(names, name, '+')) {
+                step.keys.push_back(KeyFromName(name));
+            }
+        }
+
+        _totalFrames = step.endFrame;
+        _steps.push_back(std::move(step));
+    }
+}
+
+const std::vector<int>& InputScript::keysAt(int frame) const {
+    static const std::vector<int> NONE;
+
+    // Búsqueda binaria por el final de cada paso (el guion puede ser largo)
+    auto it = std::upper_bound(_steps.begin(), _steps.end(), frame,
+                               [](int f, const Step& s) { return f < s.endFrame; });
+    return it != _steps.end() ? it->keys : NONE;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <string>
+#include <vector>
+
+/**
+ * Guion de entrada para el simulador headless.
+ *
+ * Formato de texto, una instrucción por línea (lo mismo que saldría de grabar
+ * una partida frame a frame comprimiendo las repeticiones):
+ *
+ *   <frames> <TECLA>[+TECLA...]
+ *
+ *   30 RIGHT        -> 30 frames con la flecha derecha pulsada
+ *   12 NONE         -> 12 frames sin tocar nada
+ *   1  UP+SPACE     -> varias teclas a la vez
+ *
+ * Teclas: UP, DOWN, LEFT, RIGHT, W, A, S, D, SPACE, ENTER, NONE.
+ * Las líneas vacías y las que empiezan por '#' se ignoran.
+ *
+ * Errores de formato (tecla desconocida, frames <= 0) → throw runtime_error,
+ * igual que Map::loadFromFile.
+ */
+class InputScript {
+public:
+    void loadFromFile(const std::string& path);
+    void loadFromString(const std::string& text);
+
+    // Teclas pulsadas en el frame indicado; vacío una vez acabado el guion
+    const std::vector<int>& keysAt(int frame) const;
+
+    // Número total de frames que cubre el guion
+    int frames() const { return _totalFrames; }
+
+private:
+    struct Step {
+        int endFrame;           // primer frame que ya no pertenece al paso
+        std::vector<int> keys;
+    };
+
+    std::vector<Step> _steps;
+    int _totalFrames = 0;
+};
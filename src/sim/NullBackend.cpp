@@ -0,0 +1,201 @@
+#include "NullBackend.hpp"
+#include "core/Config.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_set>
+
+extern "C" {
+    #include <raylib.h>
+}
+
+namespace {
+    std::unordered_set<int> g_keysDown;
+    std::unordered_set<int> g_keysPrev;
+
+    // Píxel de relleno para las imágenes "decodificadas" (nunca se lee)
+    unsigned char g_pixel[4] = {255, 255, 255, 255};
+    unsigned int g_nextTextureId = 1;
+
+    // Textura 1x1 con id distinto de 0: para el núcleo cuenta como cargada
+    Texture2D MakeTexture() {
+        Texture2D tex{};
+        tex.id = g_nextTextureId++;
+        tex.width = 1;
+        tex.height = 1;
+        tex.mipmaps = 1;
+        tex.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+        return tex;
+    }
+}
+
+void NullBackend_SetKeysDown(const std::vector<int>& keys) {
+    g_keysPrev = std::move(g_keysDown);
+    g_keysDown.clear();
+    g_keysDown.insert(keys.begin(), keys.end());
+}
+
+/* --- Entrada --- */
+
+extern "C" bool IsKeyDown(int key) {
+    return g_keysDown.count(key) > 0;
+}
+
+extern "C" bool IsKeyPressed(int key) {
+    return g_keysDown.count(key) > 0 && g_keysPrev.count(key) == 0;
+}
+
+extern "C" int GetCharPressed(void) { return 0; }
+extern "C" Vector2 GetMousePosition(void) { return Vector2{-1.0f, -1.0f}; }
+extern "C" bool IsMouseButtonPressed(int button) { (void)button; return false; }
+
+/* --- Ventana --- */
+
+extern "C" int GetScreenWidth(void) { return WINDOW_WIDTH; }
+extern "C" int GetScreenHeight(void) { return WINDOW_HEIGHT; }
+
+/* --- Colisiones: mismas reglas que rshapes.c, la lógica del juego depende de ellas --- */
+
+extern "C" bool CheckCollisionRecs(Rectangle rec1, Rectangle rec2) {
+    return (rec1.x < (rec2.x + rec2.width) && (rec1.x + rec1.width) > rec2.x) &&
+           (rec1.y < (rec2.y + rec2.height) && (rec1.y + rec1.height) > rec2.y);
+}
+
+extern "C" bool CheckCollisionPointRec(Vector2 point, Rectangle rec) {
+    return (point.x >= rec.x) && (point.x < (rec.x + rec.width)) &&
+           (point.y >= rec.y) && (point.y < (rec.y + rec.height));
+}
+
+extern "C" bool CheckCollisionCircleRec(Vector2 center, float radius, Rectangle rec) {
+    float halfW = rec.width / 2.0f;
+    float halfH = rec.height / 2.0f;
+    float dx = std::fabs(center.x - (rec.x + halfW));
+    float dy = std::fabs(center.y - (rec.y + halfH));
+
+    if (dx > (halfW + radius)) return false;
+    if (dy > (halfH + radius)) return false;
+    if (dx <= halfW) return true;
+    if (dy <= halfH) return true;
+
+    float cornerDistanceSq = (dx - halfW) * (dx - halfW) + (dy - halfH) * (dy - halfH);
+    return cornerDistanceSq <= (radius * radius);
+}
+
+/* --- Texturas e imágenes: sin GPU ni disco --- */
+
+extern "C" Image LoadImage(const char* fileName) {
+    (void)fileName;
+    Image image{};
+    image.data = g_pixel;
+    image.width = 1;
+    image.height = 1;
+    image.mipmaps = 1;
+    image.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    return image;
+}
+
+extern "C" Image LoadImageFromMemory(const char* fileType, const unsigned char* fileData, int dataSize) {
+    (void)fileData;
+    (void)dataSize;
+    return LoadImage(fileType);
+}
+
+extern "C" void UnloadImage(Image image) { (void)image; }
+
+/* --- Compresión (paquete de assets): sin DEFLATE, las entradas se guardan tal cual --- */
+
+extern "C" unsigned char* CompressData(const unsigned char* data, int dataSize, int* compDataSize) {
+    (void)data;
+    (void)dataSize;
+    *compDataSize = 0;
+    return nullptr;
+}
+
+extern "C" unsigned char* DecompressData(const unsigned char* compData, int compDataSize, int* dataSize) {
+    (void)compData;
+    (void)compDataSize;
+    *dataSize = 0;
+    return nullptr;
+}
+
+extern "C" void MemFree(void* ptr) { (void)ptr; }
+
+extern "C" Texture2D LoadTexture(const char* fileName) {
+    (void)fileName;
+    return MakeTexture();
+}
+
+extern "C" Texture2D LoadTextureFromImage(Image image) {
+    (void)image;
+    return MakeTexture();
+}
+
+extern "C" void UnloadTexture(Texture2D texture) { (void)texture; }
+
+// Sin framebuffer: id 0 hace que el mapa use su camino de dibujo por tiles
+extern "C" RenderTexture2D LoadRenderTexture(int width, int height) {
+    (void)width;
+    (void)height;
+    return RenderTexture2D{};
+}
+
+extern "C" void UnloadRenderTexture(RenderTexture2D target) { (void)target; }
+
+/* --- Dibujo: no hace nada --- */
+
+extern "C" void ClearBackground(Color color) { (void)color; }
+extern "C" void BeginMode2D(Camera2D camera) { (void)camera; }
+extern "C" void EndMode2D(void) {}
+extern "C" void BeginScissorMode(int x, int y, int width, int height) { (void)x; (void)y; (void)width; (void)height; }
+extern "C" void EndScissorMode(void) {}
+extern "C" void BeginTextureMode(RenderTexture2D target) { (void)target; }
+extern "C" void EndTextureMode(void) {}
+extern "C" void BeginBlendMode(int mode) { (void)mode; }
+extern "C" void EndBlendMode(void) {}
+extern "C" void rlSetBlendFactors(int glSrcFactor, int glDstFactor, int glEquation) {
+    (void)glSrcFactor; (void)glDstFactor; (void)glEquation;
+}
+
+extern "C" void DrawCircleV(Vector2 center, float radius, Color color) { (void)center; (void)radius; (void)color; }
+extern "C" void DrawLine(int startPosX, int startPosY, int endPosX, int endPosY, Color color) {
+    (void)startPosX; (void)startPosY; (void)endPosX; (void)endPosY; (void)color;
+}
+extern "C" void DrawRectangle(int posX, int posY, int width, int height, Color color) {
+    (void)posX; (void)posY; (void)width; (void)height; (void)color;
+}
+extern "C" void DrawRectangleGradientV(int posX, int posY, int width, int height, Color top, Color bottom) {
+    (void)posX; (void)posY; (void)width; (void)height; (void)top; (void)bottom;
+}
+extern "C" void DrawRectangleLines(int posX, int posY, int width, int height, Color color) {
+    (void)posX; (void)posY; (void)width; (void)height; (void)color;
+}
+extern "C" void DrawRectangleLinesEx(Rectangle rec, float lineThick, Color color) { (void)rec; (void)lineThick; (void)color; }
+extern "C" void DrawRectangleRec(Rectangle rec, Color color) { (void)rec; (void)color; }
+extern "C" void DrawRectangleRounded(Rectangle rec, float roundness, int segments, Color color) {
+    (void)rec; (void)roundness; (void)segments; (void)color;
+}
+extern "C" void DrawRectangleRoundedLinesEx(Rectangle rec, float roundness, int segments, float lineThick, Color color) {
+    (void)rec; (void)roundness; (void)segments; (void)lineThick; (void)color;
+}
+extern "C" void DrawText(const char* text, int posX, int posY, int fontSize, Color color) {
+    (void)text; (void)posX; (void)posY; (void)fontSize; (void)color;
+}
+extern "C" void DrawTextureEx(Texture2D texture, Vector2 position, float rotation, float scale, Color tint) {
+    (void)texture; (void)position; (void)rotation; (void)scale; (void)tint;
+}
+extern "C" void DrawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint) {
+    (void)texture; (void)source; (void)dest; (void)origin; (void)rotation; (void)tint;
+}
+
+/* --- Utilidades de color/texto usadas al maquetar --- */
+
+extern "C" Color Fade(Color color, float alpha) {
+    alpha = std::clamp(alpha, 0.0f, 1.0f);
+    return Color{color.r, color.g, color.b, (unsigned char)(255.0f * alpha)};
+}
+
+// Aproximación de la fuente por defecto: solo se usa para centrar textos
+extern "C" int MeasureText(const char* text, int fontSize) {
+    if (!text) return 0;
+    return (int)std::strlen(text) * std::max(fontSize, 10) / 2;
+}
@@ -0,0 +1,16 @@
+#pragma once
+#include <vector>
+
+/*
+ * Backend nulo de raylib para el simulador headless (game_sim).
+ *
+ * NullBackend.cpp define todas las funciones de raylib que usa game_core: dibujo,
+ * texturas y ventana no hacen nada, las colisiones son las de raylib (afectan a la
+ * lógica) y el teclado lo alimenta el simulador frame a frame. Como el ejecutable
+ * las define todas, el enlazador no saca nada de libraylib y no hace falta display.
+ * Si el núcleo empieza a usar otra función de raylib hay que añadirla aquí.
+ */
+
+// Teclas pulsadas durante el frame que va a simularse (códigos KEY_* de raylib).
+// Lo pulsado el frame anterior se guarda para resolver IsKeyPressed.
+void NullBackend_SetKeysDown(const std::vector<int>& keys);
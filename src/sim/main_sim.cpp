@@ -0,0 +1,157 @@
+#include "core/GameOverState.hpp"
+#include "core/Localization.hpp"
+#include "core/MainGameState.hpp"
+#include "core/StateMachine.hpp"
+#include "InputScript.hpp"
+#include "NullBackend.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+/*
+ * Simulador headless: juega un nivel con el backend nulo (sin ventana ni GPU),
+ * alimentando InputSystem con un guion de teclas y avanzando MainGameState::update
+ * con un dt fijo, sin limitar frames. Pensado para CI (balanceo y regresiones).
+ *
+ *   game_sim --level 2 --script partida.txt --runs 1000 --seed 7
+ *
+ * Imprime una línea por partida y un resumen final.
+ */
+
+struct SimOptions {
+    int level = 1;
+    int runs = 1;
+    unsigned int seed = 0;
+    float dt = SIM_TICK_DT;   // mismo tick fijo que el juego
+    int maxFrames = 1000000;
+    bool verbose = false;
+    std::string scriptPath;
+};
+
+struct SimResult {
+    const char* outcome = "limit"; // exit | victory | dead | timeout | limit
+    int frames = 0;
+    float timeLeft = 0.0f;
+};
+
+static void PrintUsage() {
+    std::cerr << "Uso: game_sim [--level N] [--script fichero] [--runs N] [--seed S]\n"
+                 "                [--dt segundos] [--max-frames N] [--verbose]\n";
+}
+
+static bool ParseArgs(int argc, char** argv, SimOptions& opt) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--verbose") {
+            opt.verbose = true;
+            continue;
+        }
+        if (i + 1 >= argc) return false;
+        std::string value = argv[++i];
+
+        if (arg == "--level") opt.level = std::atoi(value.c_str());
+        else if (arg == "--script") opt.scriptPath = value;
+        else if (arg == "--runs") opt.runs = std::atoi(value.c_str());
+        else if (arg == "--seed") opt.seed = (unsigned int)std::strtoul(value.c_str(), nullptr, 10);
+        else if (arg == "--dt") opt.dt = std::strtof(value.c_str(), nullptr);
+        else if (arg == "--max-frames") opt.maxFrames = std::atoi(value.c_str());
+        else return false;
+    }
+    return opt.level > 0 && opt.runs > 0 && opt.dt > 0.0f && opt.maxFrames > 0;
+}
+
+// Juega una partida hasta que MainGameState cede el paso a GameOverState
+static SimResult SimulateLevel(const SimOptions& opt, const InputScript& script, unsigned int seed) {
+    SimResult result;
+
+    // Dos frames vacíos: no arrastrar teclas "pulsadas" de la partida anterior
+    NullBackend_SetKeysDown({});
+    NullBackend_SetKeysDown({});
+
+    StateMachine stateMachine;
+    float changeDt = opt.dt;
+    auto game = std::make_unique<MainGameState>(opt.level);
+    game->setSeed(seed);
+    stateMachine.add_state(std::move(game), false);
+    stateMachine.handle_state_changes(changeDt);
+
+    for (int frame = 0; frame < opt.maxFrames; ++frame) {
+        NullBackend_SetKeysDown(script.keysAt(frame));
+
+        auto& state = stateMachine.getCurrentState();
+        state->handleInput();
+        state->update(opt.dt);
+
+        changeDt = opt.dt;
+        stateMachine.handle_state_changes(changeDt);
+
+        auto* over = dynamic_cast<GameOverState*>(stateMachine.getCurrentState().get());
+        if (!over) continue;
+
+        result.frames = frame + 1;
+        result.timeLeft = over->remainingTime();
+        if (over->isVictory()) result.outcome = "victory";
+        else if (!over->isDead()) result.outcome = "exit";
+        else if (over->remainingTime() <= 0.0f) result.outcome = "timeout";
+        else result.outcome = "dead";
+        return result;
+    }
+
+    result.frames = opt.maxFrames;
+    return result;
+}
+
+int main(int argc, char** argv) {
+    SimOptions opt;
+    if (!ParseArgs(argc, argv, opt)) {
+        PrintUsage();
+        return 1;
+    }
+
+    InputScript script;
+    try {
+        if (!opt.scriptPath.empty()) script.loadFromFile(opt.scriptPath);
+    } catch (const std::exception& e) {
+        std::cerr << "[ERROR] " << e.what() << std::endl;
+        return 2;
+    }
+
+    InitLocalization("es");
+
+    // El núcleo escribe trazas por std::cout: se silencian salvo con --verbose
+    std::ostream report(std::cout.rdbuf());
+    if (!opt.verbose) std::cout.rdbuf(nullptr);
+
+    int exits = 0, deaths = 0, timeouts = 0, limits = 0;
+    const auto start = std::chrono::steady_clock::now();
+
+    for (int run = 0; run < opt.runs; ++run) {
+        const unsigned int seed = opt.seed + (unsigned int)run;
+
+        SimResult r;
+        try {
+            r = SimulateLevel(opt, script, seed);
+        } catch (const std::exception& e) {
+            std::cerr << "[ERROR] " << e.what() << std::endl;
+            return 2;
+        }
+
+        std::string outcome = r.outcome;
+        if (outcome == "exit" || outcome == "victory") ++exits;
+        else if (outcome == "dead") ++deaths;
+        else if (outcome == "timeout") ++timeouts;
+        else ++limits;
+
+        report << "run=" << run << " seed=" << seed << " level=" << opt.level
+               << " result=" << outcome << " frames=" << r.frames
+               << " time_left=" << r.timeLeft << '\n';
+    }
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    report << "runs=" << opt.runs << " exit=" << exits << " dead=" << deaths
+           << " timeout=" << timeouts << " limit=" << limits
+           << " elapsed_ms=" << (long long)elapsed.count() << std::endl;
+    return 0;
+}
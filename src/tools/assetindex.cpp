@@ -0,0 +1,33 @@
+#include "core/AssetIndex.hpp"
+#include <exception>
+#include <iostream>
+#include <string>
+
+/*
+ * assetindex: genera el manifiesto de una carpeta de assets (nombre lógico,
+ * tamaño y dimensiones de cada archivo) para que ResourceManager lo lea de una
+ * vez en vez de recorrer el directorio al arrancar.
+ *
+ *   assetindex assets                  (escribe assets/assets.manifest)
+ *   assetindex assets otro.manifest
+ *
+ * Se genera al instalar; en desarrollo sin manifiesto el juego recorre la carpeta.
+ */
+
+int main(int argc, char** argv) {
+    if (argc != 2 && argc != 3) {
+        std::cerr << "Uso: assetindex <carpeta de assets> [salida]\n";
+        return 1;
+    }
+
+    const std::string root = argv[1];
+    const std::string output = (argc == 3) ? argv[2] : root + "/" + AssetIndex::MANIFEST_NAME;
+    try {
+        const size_t count = AssetIndex::WriteManifest(root, output);
+        std::cout << "[ASSETINDEX] " << root << " -> " << output << " (" << count << " assets)\n";
+    } catch (const std::exception& e) {
+        std::cerr << "[ERROR] " << root << ": " << e.what() << std::endl;
+        return 2;
+    }
+    return 0;
+}
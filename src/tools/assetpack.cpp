@@ -0,0 +1,39 @@
+#include "core/AssetPack.hpp"
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+extern "C" {
+    #include <raylib.h>
+}
+
+/*
+ * assetpack: empaqueta una carpeta de assets en un único archivo (AssetPack)
+ * que ResourceManager proyecta en memoria y decodifica sin abrir un archivo
+ * por textura.
+ *
+ *   assetpack assets bin/assets.pak sprites
+ *   assetpack assets todo.pak                (sin carpetas: todos los archivos)
+ *
+ * Los mapas se dejan fuera del paquete: Map los abre por ruta.
+ */
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Uso: assetpack <carpeta de assets> <salida.pak> [carpeta...]\n";
+        return 1;
+    }
+
+    const std::string root = argv[1];
+    const std::string output = argv[2];
+    const std::vector<std::string> dirs(argv + 3, argv + argc);
+    SetTraceLogLevel(LOG_WARNING); // Sin una línea de raylib por cada entrada comprimida
+    try {
+        const size_t count = AssetPack::Write(root, dirs, output);
+        std::cout << "[ASSETPACK] " << root << " -> " << output << " (" << count << " assets)\n";
+    } catch (const std::exception& e) {
+        std::cerr << "[ERROR] " << root << ": " << e.what() << std::endl;
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,39 @@
+#include "objects/Map.hpp"
+#include <exception>
+#include <iostream>
+#include <string>
+
+/*
+ * mapc: compila mapas de texto (formato fuente) al formato binario .lvl que
+ * carga el juego sin parsear (Map::loadFromBinary), o al formato por chunks
+ * .lvc (Map::loadChunked) si la salida termina en .lvc.
+ *
+ *   mapc assets/maps/map_1.txt bin/maps/map_1.lvl
+ *   mapc mundo.txt mundo.lvc
+ *
+ * El mapa se valida con Map::loadFromFile, así que un .txt inválido falla aquí
+ * con el mismo mensaje que fallaría en el juego.
+ */
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "Uso: mapc <mapa.txt> <salida.lvl|salida.lvc>\n";
+        return 1;
+    }
+
+    const std::string input = argv[1];
+    const std::string output = argv[2];
+    try {
+        Map map;
+        map.loadFromFile(input, TILE_SIZE);
+        const bool chunked = output.size() >= 4 && output.compare(output.size() - 4, 4, ".lvc") == 0;
+        if (chunked) map.saveChunked(output);
+        else map.saveBinary(output);
+        std::cout << "[MAPC] " << input << " -> " << output
+                  << " (" << map.width() << "x" << map.height() << ")\n";
+    } catch (const std::exception& e) {
+        std::cerr << "[ERROR] " << input << ": " << e.what() << std::endl;
+        return 2;
+    }
+    return 0;
+}
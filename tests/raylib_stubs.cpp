@@ -8,6 +8,7 @@ extern "C" {
 namespace {
     int g_load_calls = 0;
     int g_unload_calls = 0;
+    int g_upload_calls = 0;
 }
 
 int RaylibStub_GetLoadTextureCalls() {
@@ -18,9 +19,14 @@ int RaylibStub_GetUnloadTextureCalls() {
     return g_unload_calls;
 }
 
+int RaylibStub_GetUploadTextureCalls() {
+    return g_upload_calls;
+}
+
 void RaylibStub_ResetCounters() {
     g_load_calls = 0;
     g_unload_calls = 0;
+    g_upload_calls = 0;
 }
 
 /* --- Stubs de raylib ---
@@ -40,6 +46,19 @@ extern "C" Texture2D LoadTexture(const char* fileName) {
     return tex;
 }
 
+// La decodificación (LoadImage) es CPU pura y se deja real; solo se evita la subida.
+extern "C" Texture2D LoadTextureFromImage(Image image) {
+    ++g_upload_calls;
+
+    Texture2D tex{};
+    tex.id = 2;
+    tex.width = image.width;
+    tex.height = image.height;
+    tex.mipmaps = 1;
+    tex.format = image.format;
+    return tex;
+}
+
 extern "C" void UnloadTexture(Texture2D texture) {
     (void)texture;
     ++g_unload_calls;
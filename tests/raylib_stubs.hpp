@@ -3,4 +3,5 @@
 // API de soporte para tests: contador de llamadas a funciones stub.
 int RaylibStub_GetLoadTextureCalls();
 int RaylibStub_GetUnloadTextureCalls();
+int RaylibStub_GetUploadTextureCalls();
 void RaylibStub_ResetCounters();
@@ -0,0 +1,94 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <unordered_map>
+#include "core/JobSystem.hpp"
+#include "ecs/Ecs.hpp"
+
+namespace {
+    std::string FixturePath(const std::string& filename) {
+        return std::string(TESTS_DIR) + "/fixtures/" + filename;
+    }
+
+    constexpr float kDt = 1.0f / 120.0f;
+} // namespace
+
+// ai_crowd.txt: 90 enemigos separados del jugador por una pared (nunca se ven)
+
+TEST_CASE("EnemyAIScheduler: los lejanos se actualizan cada N ticks con el tiempo acumulado", "[ai][scheduler]") {
+    Map map;
+    REQUIRE(map.loadFromFile(FixturePath("ai_crowd.txt"), 16));
+    entt::registry registry;
+    LevelSetupSystem(registry, map, 3);
+
+    auto& schedule = registry.ctx().emplace<EnemyAIScheduler>();
+    schedule.nearRadius = 0;
+    schedule.midRadius = 1000;
+    schedule.midInterval = 4;
+
+    auto view = registry.view<const EnemyAIScheduleComponent>();
+    REQUIRE(view.size() == 90);
+
+    // Cada enemigo se actualiza exactamente una vez cada 4 ticks
+    std::unordered_map<entt::entity, int> updates;
+    for (int tick = 0; tick < 16; ++tick) {
+        EnemyAISystem(registry, map, kDt);
+        for (auto entity : view) {
+            const auto& slot = view.get<const EnemyAIScheduleComponent>(entity);
+            if (slot.pendingDt == 0.0f) {
+                ++updates[entity];
+            } else {
+                // Entre actualizaciones el tiempo se acumula tick a tick
+                REQUIRE(slot.pendingDt > 0.0f);
+                REQUIRE(slot.pendingDt < 4.0f * kDt + 1e-5f);
+            }
+        }
+    }
+    for (auto entity : view) REQUIRE(updates[entity] == 4);
+    REQUIRE(schedule.backlog.empty());
+}
+
+TEST_CASE("EnemyAIScheduler: el presupuesto deja trabajo para el siguiente tick", "[ai][scheduler]") {
+    Map map;
+    REQUIRE(map.loadFromFile(FixturePath("ai_crowd.txt"), 16));
+    entt::registry registry;
+    LevelSetupSystem(registry, map, 3);
+
+    auto& schedule = registry.ctx().emplace<EnemyAIScheduler>();
+    schedule.nearRadius = 0;
+    schedule.midRadius = 1000;
+    schedule.midInterval = 1;         // todos diferidos y debidos en cada tick
+    schedule.budgetSeconds = 1e-9f;   // agotado tras el primer lote
+
+    auto view = registry.view<const EnemyAIScheduleComponent>();
+    EnemyAISystem(registry, map, kDt);
+
+    const size_t batch = (size_t)ENEMY_AI_CHUNK_SIZE * (JobSystem::Get().workerCount() + 1);
+    size_t queued = 0;
+    for (auto entity : view) {
+        if (view.get<const EnemyAIScheduleComponent>(entity).queued) ++queued;
+    }
+    REQUIRE(queued == (batch >= 90 ? 0 : 90 - batch));
+
+    // Los que esperan conservan su tiempo y se atienden en ticks posteriores
+    schedule.budgetSeconds = 0.0f;
+    EnemyAISystem(registry, map, kDt);
+    for (auto entity : view) {
+        const auto& slot = view.get<const EnemyAIScheduleComponent>(entity);
+        REQUIRE_FALSE(slot.queued);
+        REQUIRE(slot.pendingDt == 0.0f);
+    }
+}
+
+TEST_CASE("EnemyAIScheduler: cerca del jugador se actualiza cada tick", "[ai][scheduler]") {
+    Map map;
+    REQUIRE(map.loadFromFile(FixturePath("ai_crowd.txt"), 16));
+    entt::registry registry;
+    LevelSetupSystem(registry, map, 3);
+    registry.ctx().emplace<EnemyAIScheduler>().nearRadius = 1000;
+
+    auto view = registry.view<const EnemyAIScheduleComponent>();
+    for (int tick = 0; tick < 3; ++tick) {
+        EnemyAISystem(registry, map, kDt);
+        for (auto entity : view) REQUIRE(view.get<const EnemyAIScheduleComponent>(entity).pendingDt == 0.0f);
+    }
+}
@@ -0,0 +1,131 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "core/AssetIndex.hpp"
+#include "core/ResourceManager.hpp"
+
+namespace {
+    // Carpeta temporal que se borra al salir del test
+    struct TempDir {
+        std::filesystem::path path;
+
+        explicit TempDir(const std::string& name)
+            : path(std::filesystem::temp_directory_path() / name) {
+            std::filesystem::remove_all(path);
+            std::filesystem::create_directories(path);
+        }
+
+        ~TempDir() { std::filesystem::remove_all(path); }
+
+        std::string root() const { return path.string() + "/"; }
+
+        void write(const std::string& name, const std::string& content) const {
+            std::filesystem::create_directories((path / name).parent_path());
+            std::ofstream out(path / name, std::ios::binary | std::ios::trunc);
+            out << content;
+        }
+    };
+
+    const std::string REPO_ASSETS = std::string(TESTS_DIR) + "/../assets/";
+}
+
+TEST_CASE("AssetIndex: recorre la raíz y resuelve nombres lógicos", "[assets]") {
+    TempDir dir("dca_test_assets");
+    dir.write("maps/map_1.txt", "P.X\n");
+    dir.write("sprites/player/Knight/Idle.png", "no es un png");
+    dir.write("sprites/player/Knight/Walk.png", "");
+    dir.write("sprites/player/Rogue/Idle.png", "");
+
+    AssetIndex index;
+    REQUIRE(index.addRoot(dir.root()) == 4);
+    REQUIRE(index.size() == 4);
+
+    const AssetInfo* map = index.find("maps/map_1.txt");
+    REQUIRE(map != nullptr);
+    REQUIRE(map->path == dir.root() + "maps/map_1.txt");
+    REQUIRE(map->size == 4);
+    REQUIRE(index.find("maps/map_2.txt") == nullptr);
+    REQUIRE_FALSE(index.contains("maps"));
+
+    REQUIRE(index.subdirectories("sprites/player") == std::vector<std::string>{ "Knight", "Rogue" });
+    REQUIRE(index.subdirectories("sprites") == std::vector<std::string>{ "player" });
+    REQUIRE(index.subdirectories("nada").empty());
+
+    // Un archivo que no es PNG no tiene dimensiones
+    int w = 0, h = 0;
+    REQUIRE_FALSE(index.imageSize("sprites/player/Knight/Idle.png", w, h));
+
+    // Raíz inexistente: no añade nada
+    REQUIRE(index.addRoot(dir.root() + "no_existe/") == 0);
+}
+
+TEST_CASE("AssetIndex: la primera raíz manda", "[assets]") {
+    TempDir local("dca_test_assets_local");
+    TempDir installed("dca_test_assets_installed");
+    local.write("maps/map_1.txt", "local");
+    installed.write("maps/map_1.txt", "instalado");
+    installed.write("maps/map_2.txt", "instalado");
+
+    AssetIndex index;
+    REQUIRE(index.addRoot(local.root()) == 1);
+    REQUIRE(index.addRoot(installed.path.string()) == 1);
+    REQUIRE(index.find("maps/map_1.txt")->path == local.root() + "maps/map_1.txt");
+    REQUIRE(index.find("maps/map_2.txt")->path == installed.root() + "maps/map_2.txt");
+}
+
+TEST_CASE("AssetIndex: el manifiesto reproduce el recorrido con las dimensiones", "[assets]") {
+    AssetIndex scanned;
+    REQUIRE(scanned.addRoot(REPO_ASSETS) > 0);
+
+    // Las dimensiones de la cabecera coinciden con las de la imagen decodificada
+    int w = 0, h = 0;
+    REQUIRE(scanned.imageSize("sprites/spikes.png", w, h));
+    Image image = LoadImage((REPO_ASSETS + "sprites/spikes.png").c_str());
+    REQUIRE(w == image.width);
+    REQUIRE(h == image.height);
+    UnloadImage(image);
+
+    TempDir dir("dca_test_assets_manifest");
+    const std::string manifest = dir.root() + AssetIndex::MANIFEST_NAME;
+    REQUIRE(AssetIndex::WriteManifest(REPO_ASSETS, manifest) == scanned.size());
+
+    // Copia de la raíz con solo el manifiesto: no se recorre la carpeta
+    AssetIndex fromManifest;
+    REQUIRE(fromManifest.addRoot(dir.root()) == scanned.size());
+    const AssetInfo* map = fromManifest.find("maps/map_1.txt");
+    REQUIRE(map != nullptr);
+    REQUIRE(map->path == dir.root() + "maps/map_1.txt");
+    REQUIRE(map->size == scanned.find("maps/map_1.txt")->size);
+    const AssetInfo* spikes = fromManifest.find("sprites/spikes.png");
+    REQUIRE(spikes != nullptr);
+    REQUIRE(spikes->width == w);
+    REQUIRE(spikes->height == h);
+    REQUIRE(fromManifest.find(AssetIndex::MANIFEST_NAME) == nullptr);
+}
+
+TEST_CASE("AssetIndex: un manifiesto inválido lanza excepción", "[assets]") {
+    TempDir dir("dca_test_assets_bad");
+
+    SECTION("versión distinta") {
+        dir.write(AssetIndex::MANIFEST_NAME, "ASSETS 999\n4 0 0 maps/map_1.txt\n");
+    }
+    SECTION("línea sin nombre") {
+        dir.write(AssetIndex::MANIFEST_NAME, "ASSETS 1\n4 0 0\n");
+    }
+
+    AssetIndex index;
+    REQUIRE_THROWS_AS(index.addRoot(dir.root()), std::runtime_error);
+}
+
+TEST_CASE("ResourceManager: HasAsset y los sets de jugador salen del índice", "[assets][resources]") {
+    ResourceManager& rm = ResourceManager::Get();
+    rm.RescanAssets();
+
+    REQUIRE(rm.HasAsset("maps/map_1.txt"));
+    REQUIRE_FALSE(rm.HasAsset("no_such_asset_123.txt"));
+    REQUIRE(rm.GetAssetPath("maps/map_1.txt") == rm.Assets().find("maps/map_1.txt")->path);
+    REQUIRE_FALSE(rm.Assets().subdirectories("sprites/player").empty());
+}
@@ -0,0 +1,133 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "core/AssetPack.hpp"
+
+extern "C" {
+    #include <raylib.h>
+}
+
+namespace {
+    // Carpeta temporal que se borra al salir del test
+    struct TempDir {
+        std::filesystem::path path;
+
+        explicit TempDir(const std::string& name)
+            : path(std::filesystem::temp_directory_path() / name) {
+            std::filesystem::remove_all(path);
+            std::filesystem::create_directories(path);
+        }
+
+        ~TempDir() { std::filesystem::remove_all(path); }
+
+        std::string file(const std::string& name) const { return (path / name).string(); }
+
+        void write(const std::string& name, const std::string& content) const {
+            std::filesystem::create_directories((path / name).parent_path());
+            std::ofstream out(path / name, std::ios::binary | std::ios::trunc);
+            out << content;
+        }
+    };
+
+    std::vector<char> ReadAll(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    void WriteAll(const std::string& path, const std::vector<char>& data) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+
+    const std::string REPO_SPIKES = std::string(TESTS_DIR) + "/../assets/sprites/spikes.png";
+}
+
+TEST_CASE("AssetPack: empaqueta, indexa y lee sin copiar", "[assets][pack]") {
+    TempDir dir("dca_test_pack");
+    const std::string text(4096, 'a');
+    dir.write("assets/maps/map_1.txt", "P.X\n");
+    dir.write("assets/sprites/notes.txt", text);
+    dir.write("assets/sprites/empty.txt", "");
+    std::filesystem::copy_file(REPO_SPIKES, dir.file("assets/sprites/spikes.png"));
+
+    const std::string pakPath = dir.file("out.pak");
+    REQUIRE(AssetPack::Write(dir.file("assets"), { "sprites" }, pakPath) == 3);
+
+    AssetPack pack;
+    pack.open(pakPath);
+    REQUIRE(pack.isOpen());
+    REQUIRE(pack.count() == 3);
+    REQUIRE(pack.find("maps/map_1.txt") == nullptr);
+    REQUIRE(pack.name(0) == "sprites/empty.txt");
+
+    std::vector<unsigned char> scratch;
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+
+    // PNG: ya comprimido, se guarda tal cual y se lee directamente de la proyección
+    const AssetPackEntry* png = pack.find("sprites/spikes.png");
+    REQUIRE(png != nullptr);
+    REQUIRE_FALSE(png->flags & AssetPack::COMPRESSED);
+    REQUIRE(png->offset % AssetPack::ALIGNMENT == 0);
+    REQUIRE(pack.read(*png, scratch, data, size));
+    REQUIRE(scratch.empty());
+    REQUIRE(reinterpret_cast<uintptr_t>(data) % AssetPack::ALIGNMENT == 0);
+    const std::vector<char> original = ReadAll(REPO_SPIKES);
+    REQUIRE(size == original.size());
+    REQUIRE(std::equal(original.begin(), original.end(), reinterpret_cast<const char*>(data)));
+
+    Image image = LoadImageFromMemory(".png", data, (int)size);
+    REQUIRE(image.data != nullptr);
+    REQUIRE(image.width == png->width);
+    REQUIRE(image.height == png->height);
+    UnloadImage(image);
+
+    // Texto repetitivo: se comprime y se descomprime en el buffer del llamador
+    const AssetPackEntry* notes = pack.find("sprites/notes.txt");
+    REQUIRE(notes != nullptr);
+    REQUIRE(notes->flags & AssetPack::COMPRESSED);
+    REQUIRE(notes->storedSize < notes->size);
+    REQUIRE(pack.read(*notes, scratch, data, size));
+    REQUIRE(std::string(reinterpret_cast<const char*>(data), size) == text);
+
+    const AssetPackEntry* empty = pack.find("sprites/empty.txt");
+    REQUIRE(empty != nullptr);
+    REQUIRE(pack.read(*empty, scratch, data, size));
+    REQUIRE(size == 0);
+
+    pack.close();
+    REQUIRE_FALSE(pack.isOpen());
+    REQUIRE(pack.find("sprites/spikes.png") == nullptr);
+}
+
+TEST_CASE("AssetPack: open rechaza archivos inexistentes o corruptos", "[assets][pack]") {
+    TempDir dir("dca_test_pack_bad");
+    dir.write("assets/sprites/notes.txt", "hola");
+    const std::string pakPath = dir.file("out.pak");
+    REQUIRE(AssetPack::Write(dir.file("assets"), {}, pakPath) == 1);
+    const std::vector<char> good = ReadAll(pakPath);
+
+    AssetPack pack;
+    REQUIRE_THROWS_AS(pack.open(dir.file("no_existe.pak")), std::runtime_error);
+    REQUIRE_THROWS_AS(pack.open(dir.file("assets/sprites/notes.txt")), std::runtime_error);
+
+    SECTION("versión distinta") {
+        std::vector<char> data = good;
+        data[4] = static_cast<char>(AssetPack::VERSION + 1);
+        WriteAll(pakPath, data);
+        REQUIRE_THROWS_AS(pack.open(pakPath), std::runtime_error);
+    }
+
+    SECTION("truncado") {
+        std::vector<char> data(good.begin(), good.end() - 2);
+        WriteAll(pakPath, data);
+        REQUIRE_THROWS_AS(pack.open(pakPath), std::runtime_error);
+        REQUIRE_FALSE(pack.isOpen());
+    }
+}
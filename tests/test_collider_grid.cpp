@@ -0,0 +1,74 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "ecs/ColliderGrid.hpp"
+#include "ecs/Ecs.hpp"
+
+namespace {
+    // Helper para construir rutas de fixtures desde la macro TESTS_DIR.
+    std::string FixturePath(const std::string& filename) {
+        return std::string(TESTS_DIR) + "/fixtures/" + filename;
+    }
+
+    // Crea una entidad con collider centrada en la celda (x,y).
+    entt::entity SpawnCollider(entt::registry& registry, int x, int y, float tile) {
+        auto e = registry.create();
+        registry.emplace<TransformComponent>(e, Vector2{x * tile + tile / 2.0f, y * tile + tile / 2.0f}, Vector2{tile, tile});
+        registry.emplace<ColliderComponent>(e, Rectangle{-tile / 4, -tile / 4, tile / 2, tile / 2}, CollisionType::Spike);
+        return e;
+    }
+
+    bool Contains(const std::vector<entt::entity>& v, entt::entity e) {
+        return std::find(v.begin(), v.end(), e) != v.end();
+    }
+} // namespace
+
+TEST_CASE("ColliderGrid: la consulta solo devuelve el vecindario 3x3", "[ecs][collision]") {
+    Map map;
+    REQUIRE(map.loadFromFile(FixturePath("flow_concave.txt"), 16));
+    const float tile = (float)map.tile();
+
+    entt::registry registry;
+    auto nearE = SpawnCollider(registry, 2, 2, tile);
+    auto farE = SpawnCollider(registry, 7, 7, tile);
+
+    auto& grid = BuildColliderGrid(registry, map);
+    REQUIRE(registry.all_of<ColliderCellComponent>(nearE));
+
+    std::vector<entt::entity> out;
+    grid.queryNeighborhood(Vector2{1 * tile + tile / 2.0f, 1 * tile + tile / 2.0f}, out);
+
+    REQUIRE(Contains(out, nearE));
+    REQUIRE_FALSE(Contains(out, farE));
+}
+
+TEST_CASE("ColliderGrid: MovementSystem reubica al cruzar de tile", "[ecs][collision]") {
+    Map map;
+    REQUIRE(map.loadFromFile(FixturePath("flow_concave.txt"), 16));
+    const float tile = (float)map.tile();
+
+    entt::registry registry;
+    auto e = SpawnCollider(registry, 1, 1, tile);
+    auto& move = registry.emplace<MovementComponent>(e, 16.0f);
+
+    auto& grid = BuildColliderGrid(registry, map);
+    const int startCell = registry.get<ColliderCellComponent>(e).cell;
+
+    // Paso de un tile hacia la derecha
+    move.startPos = registry.get<TransformComponent>(e).position;
+    move.targetPos = { move.startPos.x + tile, move.startPos.y };
+    move.duration = 1.0f;
+    move.progress = 0.0f;
+    move.isMoving = true;
+
+    // A mitad de camino el centro aún no ha cruzado el borde
+    MovementSystem(registry, map, 0.25f);
+    REQUIRE(registry.get<ColliderCellComponent>(e).cell == startCell);
+
+    MovementSystem(registry, map, 1.0f);
+    const int endCell = registry.get<ColliderCellComponent>(e).cell;
+    REQUIRE(endCell == startCell + 1);
+    REQUIRE(Contains(grid.bucket(endCell), e));
+    REQUIRE_FALSE(Contains(grid.bucket(startCell), e));
+}
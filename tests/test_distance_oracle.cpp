@@ -0,0 +1,79 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include "objects/DistanceOracle.hpp"
+#include "objects/FlowField.hpp"
+
+namespace {
+    // Helper para construir rutas de fixtures desde la macro TESTS_DIR.
+    std::string FixturePath(const std::string& filename) {
+        return std::string(TESTS_DIR) + "/fixtures/" + filename;
+    }
+} // namespace
+
+TEST_CASE("DistanceOracle: mismas distancias que el FlowField", "[ai][distance_oracle]") {
+    Map map;
+    REQUIRE(map.loadFromFile(FixturePath("flow_concave.txt"), 16));
+
+    DistanceOracle oracle;
+    REQUIRE(oracle.update(map));
+    REQUIRE(oracle.ready());
+    REQUIRE_FALSE(oracle.update(map));
+
+    // Contra un BFS desde varios objetivos, incluida la celda del jugador
+    const IVec2 targets[] = { map.playerStart(), IVec2{ 4, 4 }, IVec2{ 1, 1 } };
+    for (const IVec2& target : targets) {
+        FlowField flow;
+        flow.update(map, target);
+        for (int y = 0; y < map.height(); ++y) {
+            for (int x = 0; x < map.width(); ++x) {
+                if (!map.isWalkableForEnemy(x, y)) continue;
+                REQUIRE(oracle.distance(x, y, target) == flow.distance(x, y));
+            }
+        }
+    }
+
+    // Los pasos coinciden con el gradiente del campo
+    FlowField flow;
+    const IVec2 player = map.playerStart();
+    flow.update(map, player);
+    IVec2 a{}, b{};
+    REQUIRE(oracle.stepToward(4, 4, player, a) == flow.stepToward(4, 4, b));
+    REQUIRE((a.x == b.x && a.y == b.y));
+    REQUIRE(oracle.stepAway(4, 6, player, a) == flow.stepAway(4, 6, b));
+    REQUIRE((a.x == b.x && a.y == b.y));
+
+    // Paredes y fuera de rango no tienen distancia
+    REQUIRE(oracle.distance(0, 0, player) == DistanceOracle::UNREACHABLE);
+    REQUIRE(oracle.distance(1, 1, IVec2{ -1, 0 }) == DistanceOracle::UNREACHABLE);
+}
+
+TEST_CASE("DistanceOracle: un mecanismo invalida la tabla", "[ai][distance_oracle]") {
+    Map map;
+    REQUIRE(map.loadFromFile(FixturePath("flow_concave.txt"), 16));
+
+    DistanceOracle oracle;
+    oracle.update(map);
+    const IVec2 player = map.playerStart();
+    REQUIRE(oracle.distance(4, 4, player) == 3);
+
+    // Cerrar la única entrada del hueco deja al enemigo sin camino
+    map.setMechanismBlocked(4, 6, true);
+    REQUIRE(oracle.isStale(map));
+    REQUIRE(oracle.update(map));
+    REQUIRE(oracle.distance(4, 4, player) == DistanceOracle::UNREACHABLE);
+
+    map.setMechanismBlocked(4, 6, false);
+    REQUIRE(oracle.update(map));
+    REQUIRE(oracle.distance(4, 4, player) == 3);
+}
+
+TEST_CASE("DistanceOracle: mapas grandes no reservan tabla", "[ai][distance_oracle]") {
+    Map map;
+    REQUIRE(map.loadFromFile(FixturePath("flow_concave.txt"), 16));
+
+    DistanceOracle oracle;
+    REQUIRE(oracle.update(map, 10));
+    REQUIRE_FALSE(oracle.ready());
+    REQUIRE(oracle.nodeCount() == 0);
+    REQUIRE(oracle.distance(4, 4, map.playerStart()) == DistanceOracle::UNREACHABLE);
+}
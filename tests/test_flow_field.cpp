@@ -0,0 +1,79 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+#include "objects/FlowField.hpp"
+
+namespace {
+    // Helper para construir rutas de fixtures desde la macro TESTS_DIR.
+    std::string FixturePath(const std::string& filename) {
+        return std::string(TESTS_DIR) + "/fixtures/" + filename;
+    }
+} // namespace
+
+TEST_CASE("FlowField: distancias BFS desde el jugador", "[ai][flow_field]") {
+    Map map;
+    REQUIRE(map.loadFromFile(FixturePath("flow_concave.txt"), 16));
+
+    FlowField flow;
+    const IVec2 player = map.playerStart();
+    REQUIRE(flow.update(map, player));
+
+    REQUIRE(flow.distance(player.x, player.y) == 0);
+    REQUIRE(flow.distance(4, 6) == 1);
+    REQUIRE(flow.distance(0, 0) == FlowField::UNREACHABLE);
+
+    // Sin cambios de objetivo ni de mapa no se reconstruye
+    REQUIRE_FALSE(flow.update(map, player));
+}
+
+TEST_CASE("FlowField: seguir el gradiente llega al jugador rodeando paredes", "[ai][flow_field]") {
+    Map map;
+    REQUIRE(map.loadFromFile(FixturePath("flow_concave.txt"), 16));
+
+    FlowField flow;
+    const IVec2 player = map.playerStart();
+    flow.update(map, player);
+
+    IVec2 pos = map.enemyStarts().front();
+    const int expectedSteps = flow.distance(pos.x, pos.y);
+    REQUIRE(expectedSteps != FlowField::UNREACHABLE);
+
+    int steps = 0;
+    IVec2 next;
+    while (flow.stepToward(pos.x, pos.y, next)) {
+        REQUIRE(map.isWalkableForEnemy(next.x, next.y));
+        pos = next;
+        ++steps;
+        REQUIRE(steps <= expectedSteps);
+    }
+
+    REQUIRE(pos.x == player.x);
+    REQUIRE(pos.y == player.y);
+    REQUIRE(steps == expectedSteps);
+}
+
+TEST_CASE("FlowField: celdas bloqueadas y revision del mapa", "[ai][flow_field]") {
+    Map map;
+    REQUIRE(map.loadFromFile(FixturePath("flow_concave.txt"), 16));
+
+    FlowField flow;
+    const IVec2 player = map.playerStart();
+    const IVec2 enemy = map.enemyStarts().front();
+
+    // Bloquear la única salida del bolsillo deja al enemigo sin camino
+    map.setMechanismBlocked(4, 6, true);
+    flow.update(map, player);
+    REQUIRE(flow.distance(enemy.x, enemy.y) == FlowField::UNREACHABLE);
+    REQUIRE(flow.distance(4, 6) == FlowField::UNREACHABLE);
+
+    // Desbloquear cambia la revisión del mapa e invalida el campo
+    map.setMechanismBlocked(4, 6, false);
+    REQUIRE(flow.isStale(map, player));
+    REQUIRE(flow.update(map, player));
+    REQUIRE(flow.distance(enemy.x, enemy.y) != FlowField::UNREACHABLE);
+
+    // Huir: el paso elegido siempre aumenta la distancia
+    IVec2 next;
+    REQUIRE(flow.stepAway(4, 6, next));
+    REQUIRE(flow.distance(next.x, next.y) > flow.distance(4, 6));
+}
@@ -0,0 +1,37 @@
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+#include "sim/InputScript.hpp"
+
+extern "C" {
+    #include <raylib.h>
+}
+
+TEST_CASE("InputScript: expande pasos por frames", "[sim][input]") {
+    InputScript script;
+    script.loadFromString(
+        "# comentario\n"
+        "3 RIGHT\n"
+        "\n"
+        "2 NONE\n"
+        "1 UP+SPACE\n");
+
+    REQUIRE(script.frames() == 6);
+
+    REQUIRE(script.keysAt(0) == std::vector<int>{KEY_RIGHT});
+    REQUIRE(script.keysAt(2) == std::vector<int>{KEY_RIGHT});
+    REQUIRE(script.keysAt(3).empty());
+    REQUIRE(script.keysAt(4).empty());
+    REQUIRE(script.keysAt(5) == std::vector<int>{KEY_UP, KEY_SPACE});
+
+    // Acabado el guion no se pulsa nada
+    REQUIRE(script.keysAt(6).empty());
+    REQUIRE(script.keysAt(1000).empty());
+}
+
+TEST_CASE("InputScript: errores de formato lanzan runtime_error", "[sim][input]") {
+    InputScript script;
+    REQUIRE_THROWS_AS(script.loadFromString("3 JUMP\n"), std::runtime_error);
+    REQUIRE_THROWS_AS(script.loadFromString("0 UP\n"), std::runtime_error);
+    REQUIRE_THROWS_AS(script.loadFromString("abc UP\n"), std::runtime_error);
+    REQUIRE_THROWS_AS(script.loadFromFile("no_such_script_123.txt"), std::runtime_error);
+}
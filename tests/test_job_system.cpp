@@ -0,0 +1,58 @@
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "core/JobSystem.hpp"
+
+TEST_CASE("JobSystem: parallelFor visita cada índice una sola vez", "[jobs]") {
+    JobSystem jobs(4);
+
+    std::vector<int> hits(10007, 0);
+    jobs.parallelFor(hits.size(), 64, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) ++hits[i];
+    });
+
+    for (int h : hits) REQUIRE(h == 1);
+}
+
+TEST_CASE("JobSystem: los trozos se reparten entre varios hilos", "[jobs]") {
+    JobSystem jobs(3);
+
+    std::atomic<int> chunks{0};
+    std::vector<std::thread::id> owner(64);
+    jobs.parallelFor(owner.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) owner[i] = std::this_thread::get_id();
+        // Trabajo suficiente para que los workers lleguen a robar
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        ++chunks;
+    });
+
+    REQUIRE(chunks.load() == 64);
+    bool otherThread = false;
+    for (auto id : owner) otherThread = otherThread || id != std::this_thread::get_id();
+    REQUIRE(otherThread);
+}
+
+TEST_CASE("JobSystem: sin workers o con un solo trozo se ejecuta en el hilo llamante", "[jobs]") {
+    JobSystem inlineJobs(0);
+    REQUIRE(inlineJobs.workerCount() == 0);
+
+    int calls = 0;
+    const auto caller = std::this_thread::get_id();
+    bool sameThread = true;
+    inlineJobs.parallelFor(100, 8, [&](size_t begin, size_t end) {
+        sameThread = sameThread && std::this_thread::get_id() == caller;
+        calls += (int)(end - begin);
+    });
+    REQUIRE(sameThread);
+    REQUIRE(calls == 100);
+
+    JobSystem jobs(2);
+    std::thread::id ran;
+    jobs.parallelFor(5, 32, [&](size_t, size_t) { ran = std::this_thread::get_id(); });
+    REQUIRE(ran == std::this_thread::get_id());
+
+    // Rango vacío: no se llama
+    jobs.parallelFor(0, 8, [&](size_t, size_t) { FAIL("no debe ejecutarse"); });
+}
@@ -0,0 +1,134 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+#include "core/Config.hpp"
+#include "core/LevelPrefetcher.hpp"
+#include "objects/Map.hpp"
+
+namespace {
+    std::string FixturePath(const std::string& filename) {
+        return std::string(TESTS_DIR) + "/fixtures/" + filename;
+    }
+
+    // Archivo temporal que se borra al salir del test
+    struct TempPath {
+        std::string path;
+
+        explicit TempPath(const std::string& name)
+            : path((std::filesystem::temp_directory_path() / name).string()) {}
+
+        ~TempPath() { std::remove(path.c_str()); }
+    };
+}
+
+TEST_CASE("LevelPrefetcher: el nivel preparado es el mismo que se carga al momento", "[prefetch]") {
+    auto& prefetcher = LevelPrefetcher::Get();
+    prefetcher.clear();
+
+    for (const char* fixture : { "valid_map.txt", "mechanisms_valid.txt", "nav_maze.txt" }) {
+        prefetcher.prefetchFile(2, FixturePath(fixture));
+        REQUIRE(prefetcher.isPending(2));
+        REQUIRE_FALSE(prefetcher.isPending(3));
+
+        Map expected;
+        LoadLevelMap(expected, FixturePath(fixture), TILE_SIZE);
+
+        Map adopted;
+        REQUIRE(prefetcher.adopt(2, adopted));
+        REQUIRE_FALSE(prefetcher.isPending(2));
+
+        REQUIRE(adopted.width() == expected.width());
+        REQUIRE(adopted.height() == expected.height());
+        REQUIRE(adopted.tile() == TILE_SIZE);
+        REQUIRE(adopted.grid() == expected.grid());
+        REQUIRE(adopted.cells() == expected.cells());
+        REQUIRE(adopted.playerStart().x == expected.playerStart().x);
+        REQUIRE(adopted.playerStart().y == expected.playerStart().y);
+        REQUIRE(adopted.getTotalKeys() == expected.getTotalKeys());
+        REQUIRE(adopted.getMechanisms().size() == expected.getMechanisms().size());
+    }
+}
+
+TEST_CASE("LevelPrefetcher: adopt solo sirve para el nivel preparado y lo consume", "[prefetch]") {
+    auto& prefetcher = LevelPrefetcher::Get();
+    prefetcher.clear();
+
+    Map map;
+    REQUIRE_FALSE(prefetcher.adopt(2, map));
+
+    // Pedir otro nivel no espera al hilo ni descarta lo preparado
+    prefetcher.prefetchFile(4, FixturePath("valid_map.txt"));
+    REQUIRE_FALSE(prefetcher.adopt(3, map));
+    REQUIRE(prefetcher.isPending(4));
+    REQUIRE(prefetcher.adopt(4, map));
+    REQUIRE_FALSE(prefetcher.isPending(4));
+    REQUIRE_FALSE(prefetcher.adopt(4, map));
+
+    // Volver a pedir el mismo nivel no relanza el hilo; otro nivel sustituye al anterior
+    prefetcher.prefetchFile(4, FixturePath("valid_map.txt"));
+    prefetcher.prefetchFile(4, FixturePath("no_existe.txt"));
+    prefetcher.prefetchFile(5, FixturePath("nav_maze.txt"));
+    REQUIRE_FALSE(prefetcher.isPending(4));
+    REQUIRE(prefetcher.isPending(5));
+    REQUIRE(prefetcher.adopt(5, map));
+}
+
+TEST_CASE("LevelPrefetcher: un mapa inválido o por chunks se deja para la carga normal", "[prefetch]") {
+    auto& prefetcher = LevelPrefetcher::Get();
+    prefetcher.clear();
+    Map map;
+
+    for (const char* fixture : { "no_player_map.txt", "non_rect_map.txt", "no_existe.txt" }) {
+        prefetcher.prefetchFile(2, FixturePath(fixture));
+        REQUIRE_FALSE(prefetcher.adopt(2, map));
+        REQUIRE_THROWS_AS(LoadLevelMap(map, FixturePath(fixture), TILE_SIZE), std::runtime_error);
+    }
+
+    // Con un .lvc al lado del texto el nivel es por chunks: no se empaqueta
+    TempPath txt("dca_test_prefetch.txt");
+    TempPath lvc("dca_test_prefetch.lvc");
+    std::filesystem::copy_file(FixturePath("valid_map.txt"), txt.path,
+                               std::filesystem::copy_options::overwrite_existing);
+    Map dense;
+    REQUIRE(dense.loadFromFile(txt.path, TILE_SIZE));
+    dense.saveChunked(lvc.path);
+
+    prefetcher.prefetchFile(2, txt.path);
+    REQUIRE_FALSE(prefetcher.adopt(2, map));
+    LoadLevelMap(map, txt.path, TILE_SIZE);
+    REQUIRE(map.isChunked());
+}
+
+TEST_CASE("LoadLevelMap: un compilado ilegible se descarta y se carga el texto", "[prefetch]") {
+    TempPath txt("dca_test_fallback.txt");
+    TempPath lvl("dca_test_fallback.lvl");
+    TempPath lvc("dca_test_fallback.lvc");
+    std::filesystem::copy_file(FixturePath("valid_map.txt"), txt.path,
+                               std::filesystem::copy_options::overwrite_existing);
+    Map expected;
+    REQUIRE(expected.loadFromFile(txt.path, TILE_SIZE));
+
+    // Más nuevos que el texto (se eligen por fecha) pero corruptos
+    for (const std::string& path : { lvl.path, lvc.path }) {
+        std::FILE* f = std::fopen(path.c_str(), "wb");
+        REQUIRE(f != nullptr);
+        std::fputs("no es un mapa", f);
+        std::fclose(f);
+    }
+
+    Map map;
+    LoadLevelMap(map, txt.path, TILE_SIZE);
+    REQUIRE_FALSE(map.isChunked());
+    REQUIRE(map.width() == expected.width());
+    REQUIRE(map.height() == expected.height());
+    REQUIRE(map.chars() == expected.chars());
+
+    // Si solo falla el .lvc se usa el .lvl
+    expected.saveBinary(lvl.path);
+    LoadLevelMap(map, txt.path, TILE_SIZE);
+    REQUIRE_FALSE(map.isChunked());
+    REQUIRE(map.chars() == expected.chars());
+}
@@ -0,0 +1,192 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include <vector>
+#include "ecs/Ecs.hpp"
+#include "ecs/ColliderGrid.hpp"
+#include "ecs/LevelSnapshot.hpp"
+#include "ecs/MechanismIndex.hpp"
+
+namespace {
+    std::string FixturePath(const std::string& filename) {
+        return std::string(TESTS_DIR) + "/fixtures/" + filename;
+    }
+
+    constexpr float kDt = 1.0f / 120.0f;
+
+    // Posiciones de todas las entidades con transform, en orden del pool
+    std::vector<std::pair<entt::entity, Vector2>> Positions(const entt::registry& registry) {
+        std::vector<std::pair<entt::entity, Vector2>> out;
+        auto view = registry.view<const TransformComponent>();
+        for (auto entity : view) out.push_back({ entity, view.get<const TransformComponent>(entity).position });
+        return out;
+    }
+
+    void RunTicks(entt::registry& registry, const Map& map, int ticks) {
+        for (int i = 0; i < ticks; ++i) {
+            EnemyAISystem(registry, map, kDt);
+            MovementSystem(registry, map, kDt);
+        }
+    }
+} // namespace
+
+TEST_CASE("LevelSnapshot: restaurar en un registry y un mapa nuevos reproduce el nivel", "[snapshot]") {
+    Map map;
+    REQUIRE(map.loadFromFile(FixturePath("valid_map.txt"), 16));
+    entt::registry registry;
+    LevelSetupSystem(registry, map, 7);
+
+    LevelSnapshot snapshot;
+    REQUIRE(snapshot.empty());
+    snapshot.capture(registry, map);
+    REQUIRE_FALSE(snapshot.empty());
+    REQUIRE(snapshot.byteSize() > 0);
+
+    Map copy;
+    entt::registry restored;
+    snapshot.restore(restored, copy);
+
+    REQUIRE(copy.width() == map.width());
+    REQUIRE(copy.height() == map.height());
+    REQUIRE(copy.tile() == map.tile());
+    REQUIRE(copy.grid() == map.grid());
+    REQUIRE(copy.cells() == map.cells());
+    REQUIRE(copy.getTotalKeys() == map.getTotalKeys());
+    REQUIRE(copy.playerStart().x == map.playerStart().x);
+    REQUIRE(copy.playerStart().y == map.playerStart().y);
+    REQUIRE(copy.enemyStarts().size() == map.enemyStarts().size());
+
+    // Mismos ids, mismo orden de pools y mismos valores
+    const auto before = Positions(registry);
+    const auto after = Positions(restored);
+    REQUIRE(after.size() == before.size());
+    for (size_t i = 0; i < before.size(); ++i) {
+        REQUIRE(after[i].first == before[i].first);
+        REQUIRE(after[i].second.x == before[i].second.x);
+        REQUIRE(after[i].second.y == before[i].second.y);
+    }
+    REQUIRE(restored.view<PlayerInputComponent>().size() == 1);
+    REQUIRE(restored.view<ItemComponent>().size() == registry.view<ItemComponent>().size());
+
+    // Índices derivados reconstruidos y la tabla de distancias copiada sigue valiendo
+    REQUIRE(restored.ctx().find<ColliderGrid>() != nullptr);
+    REQUIRE(restored.ctx().find<MechanismIndex>() != nullptr);
+    const auto* oracle = restored.ctx().find<DistanceOracle>();
+    REQUIRE(oracle != nullptr);
+    REQUIRE_FALSE(oracle->isStale(copy));
+    REQUIRE(oracle->ready());
+
+    // Las entidades nuevas no pisan ids existentes
+    const auto fresh = restored.create();
+    REQUIRE(fresh == registry.create());
+}
+
+TEST_CASE("LevelSnapshot: un checkpoint deshace los cambios del mapa y del registry", "[snapshot]") {
+    Map map;
+    REQUIRE(map.loadFromFile(FixturePath("mechanisms_valid.txt"), 16));
+    entt::registry registry;
+    LevelSetupSystem(registry, map, 1);
+
+    LevelSnapshot checkpoint;
+    checkpoint.capture(registry, map);
+    const auto grid = map.grid();
+    const size_t entities = registry.view<TransformComponent>().size();
+
+    // Abrir la puerta y borrar una entidad después del checkpoint
+    const auto& door = map.getMechanisms().front();
+    REQUIRE(map.isMechanismBlocked(door.target.x, door.target.y));
+    map.setMechanismBlocked(door.target.x, door.target.y, false);
+    map.clearCell(door.trigger.x, door.trigger.y);
+    registry.destroy(*registry.view<TransformComponent>().begin());
+    const unsigned revision = map.navRevision();
+
+    checkpoint.restore(registry, map);
+
+    REQUIRE(map.grid() == grid);
+    REQUIRE(map.isMechanismBlocked(door.target.x, door.target.y));
+    REQUIRE(registry.view<TransformComponent>().size() == entities);
+    // La navegación vuelve atrás: las cachés tienen que verlo como un cambio
+    REQUIRE(map.navRevision() != revision);
+}
+
+TEST_CASE("LevelSnapshot: la simulación restaurada sigue igual que la original", "[snapshot][determinism]") {
+    Map map;
+    REQUIRE(map.loadFromFile(FixturePath("enemies_open.txt"), 16));
+    entt::registry registry;
+    LevelSetupSystem(registry, map, 42);
+    RunTicks(registry, map, 60);
+
+    // Checkpoint a mitad de partida (con rutas y planificador ya en marcha)
+    LevelSnapshot checkpoint;
+    checkpoint.capture(registry, map);
+
+    RunTicks(registry, map, 240);
+    const auto expected = Positions(registry);
+
+    checkpoint.restore(registry, map);
+    RunTicks(registry, map, 240);
+    const auto replayed = Positions(registry);
+
+    REQUIRE(replayed.size() == expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        REQUIRE(replayed[i].first == expected[i].first);
+        REQUIRE(replayed[i].second.x == expected[i].second.x);
+        REQUIRE(replayed[i].second.y == expected[i].second.y);
+    }
+}
+
+TEST_CASE("LevelSnapshot: cambiar la semilla tras restaurar equivale a montar con esa semilla", "[snapshot]") {
+    Map map;
+    REQUIRE(map.loadFromFile(FixturePath("enemies_open.txt"), 16));
+    entt::registry registry;
+    LevelSetupSystem(registry, map, 5);
+
+    LevelSnapshot snapshot;
+    snapshot.capture(registry, map);
+
+    Map fresh;
+    REQUIRE(fresh.loadFromFile(FixturePath("enemies_open.txt"), 16));
+    entt::registry expected;
+    LevelSetupSystem(expected, fresh, 99);
+
+    Map copy;
+    entt::registry restored;
+    snapshot.restore(restored, copy);
+    ReseedRandomStreams(restored, 99);
+
+    auto view = expected.view<const RandomStreamComponent>();
+    REQUIRE(view.size() == 4);
+    for (auto entity : view) {
+        const auto& want = view.get<const RandomStreamComponent>(entity).rng;
+        const auto& got = restored.get<RandomStreamComponent>(entity).rng;
+        REQUIRE(got.key == want.key);
+        REQUIRE(got.counter == want.counter);
+    }
+}
+
+TEST_CASE("LevelSnapshot: restaurar sin captura lanza excepción", "[snapshot]") {
+    Map map;
+    entt::registry registry;
+    LevelSnapshot snapshot;
+    REQUIRE_THROWS_AS(snapshot.restore(registry, map), std::runtime_error);
+}
+
+TEST_CASE("LevelSnapshot: un componente fuera de GameComponents no se pierde en silencio", "[snapshot]") {
+    struct UnlistedComponent { int value; };
+
+    Map map;
+    REQUIRE(map.loadFromFile(FixturePath("valid_map.txt"), 16));
+    entt::registry registry;
+    LevelSetupSystem(registry, map, 7);
+
+    LevelSnapshot snapshot;
+    snapshot.capture(registry, map);
+
+    const auto entity = registry.view<const PlayerInputComponent>().front();
+    registry.emplace<UnlistedComponent>(entity, 3);
+    REQUIRE_THROWS_AS(snapshot.capture(registry, map), std::logic_error);
+
+    // Un pool vacío no cuenta: no hay nada que perder
+    registry.remove<UnlistedComponent>(entity);
+    snapshot.capture(registry, map);
+    REQUIRE_FALSE(snapshot.empty());
+}
@@ -0,0 +1,128 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "objects/Map.hpp"
+
+namespace {
+    std::string FixturePath(const std::string& filename) {
+        return std::string(TESTS_DIR) + "/fixtures/" + filename;
+    }
+
+    // Archivo temporal que se borra al salir del test
+    struct TempPath {
+        std::string path;
+
+        explicit TempPath(const std::string& name)
+            : path((std::filesystem::temp_directory_path() / name).string()) {}
+
+        ~TempPath() { std::remove(path.c_str()); }
+    };
+
+    std::vector<char> ReadAll(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    void WriteAll(const std::string& path, const std::vector<char>& data) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+}
+
+TEST_CASE("Map: el binario compilado carga el mismo mapa que el texto", "[map][binary]") {
+    for (const char* fixture : { "valid_map.txt", "mechanisms_valid.txt", "nav_maze.txt" }) {
+        Map text;
+        REQUIRE(text.loadFromFile(FixturePath(fixture), 16));
+
+        TempPath lvl("dca_test_map.lvl");
+        text.saveBinary(lvl.path);
+
+        Map binary;
+        REQUIRE(binary.loadFromBinary(lvl.path, 24));
+
+        REQUIRE(binary.width() == text.width());
+        REQUIRE(binary.height() == text.height());
+        REQUIRE(binary.tile() == 24);
+        REQUIRE(binary.grid() == text.grid());
+        REQUIRE(binary.cells() == text.cells());
+        REQUIRE(binary.playerStart().x == text.playerStart().x);
+        REQUIRE(binary.playerStart().y == text.playerStart().y);
+        REQUIRE(binary.enemyStarts().size() == text.enemyStarts().size());
+        REQUIRE(binary.keyPositions().size() == text.keyPositions().size());
+        REQUIRE(binary.spikesStarts().size() == text.spikesStarts().size());
+        REQUIRE(binary.getMechanisms().size() == text.getMechanisms().size());
+        for (size_t i = 0; i < text.getMechanisms().size(); ++i) {
+            REQUIRE(binary.getMechanisms()[i].type == text.getMechanisms()[i].type);
+            REQUIRE(binary.getMechanisms()[i].trigger.x == text.getMechanisms()[i].trigger.x);
+            REQUIRE(binary.getMechanisms()[i].target.y == text.getMechanisms()[i].target.y);
+        }
+        for (int y = 0; y < text.height(); ++y) {
+            for (int x = 0; x < text.width(); ++x) {
+                REQUIRE(binary.isWalkable(x, y) == text.isWalkable(x, y));
+                REQUIRE(binary.isWalkableForEnemy(x, y) == text.isWalkableForEnemy(x, y));
+                REQUIRE(binary.isDoor(x, y) == text.isDoor(x, y));
+            }
+        }
+    }
+}
+
+TEST_CASE("Map: loadFromBinary rechaza archivos inexistentes o corruptos", "[map][binary]") {
+    Map map;
+    REQUIRE_THROWS_AS(map.loadFromBinary(FixturePath("no_existe.lvl"), 16), std::runtime_error);
+
+    // Un mapa de texto no es un binario
+    REQUIRE_THROWS_AS(map.loadFromBinary(FixturePath("valid_map.txt"), 16), std::runtime_error);
+
+    Map source;
+    REQUIRE(source.loadFromFile(FixturePath("valid_map.txt"), 16));
+    TempPath lvl("dca_test_map_bad.lvl");
+    source.saveBinary(lvl.path);
+    const std::vector<char> good = ReadAll(lvl.path);
+
+    SECTION("versión distinta") {
+        std::vector<char> data = good;
+        data[4] = static_cast<char>(Map::BINARY_VERSION + 1);
+        WriteAll(lvl.path, data);
+        REQUIRE_THROWS_AS(map.loadFromBinary(lvl.path, 16), std::runtime_error);
+    }
+
+    SECTION("truncado") {
+        std::vector<char> data(good.begin(), good.end() - 5);
+        WriteAll(lvl.path, data);
+        REQUIRE_THROWS_AS(map.loadFromBinary(lvl.path, 16), std::runtime_error);
+    }
+}
+
+TEST_CASE("Map: peekSize lee el tamaño sin cargar el mapa", "[map][binary]") {
+    for (const char* fixture : { "valid_map.txt", "nav_maze.txt" }) {
+        Map text;
+        REQUIRE(text.loadFromFile(FixturePath(fixture), 16));
+
+        int w = 0, h = 0;
+        REQUIRE(Map::peekSize(FixturePath(fixture), w, h));
+        REQUIRE(w == text.width());
+        REQUIRE(h == text.height());
+
+        TempPath lvl("dca_test_peek.lvl");
+        text.saveBinary(lvl.path);
+        w = h = 0;
+        REQUIRE(Map::peekSize(lvl.path, w, h));
+        REQUIRE(w == text.width());
+        REQUIRE(h == text.height());
+
+        TempPath lvc("dca_test_peek.lvc");
+        text.saveChunked(lvc.path);
+        w = h = 0;
+        REQUIRE(Map::peekSize(lvc.path, w, h));
+        REQUIRE(w == text.width());
+        REQUIRE(h == text.height());
+    }
+
+    int w = 0, h = 0;
+    REQUIRE_FALSE(Map::peekSize(FixturePath("no_existe.lvl"), w, h));
+}
@@ -0,0 +1,89 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include "objects/Map.hpp"
+
+namespace {
+    // Helper para construir rutas de fixtures desde la macro TESTS_DIR.
+    std::string FixturePath(const std::string& filename) {
+        return std::string(TESTS_DIR) + "/fixtures/" + filename;
+    }
+} // namespace
+
+TEST_CASE("Map: el array plano clasifica cada celda", "[map][cells]") {
+    Map map;
+    REQUIRE(map.loadFromFile(FixturePath("valid_map.txt"), 16));
+
+    REQUIRE(map.cells().size() == static_cast<size_t>(map.width() * map.height()));
+    REQUIRE(map.cellType(0, 0) == CellType::Wall);
+    REQUIRE(map.cellType(1, 1) == CellType::Floor); // 'P'
+    REQUIRE(map.cellType(3, 2) == CellType::Key);
+    REQUIRE(map.cellType(3, 3) == CellType::Exit);
+
+    // Fuera de rango se comporta como pared
+    REQUIRE(map.cellType(-1, 0) == CellType::Wall);
+    REQUIRE(map.cellType(map.width(), 0) == CellType::Wall);
+}
+
+TEST_CASE("Map: mascaras de walkable coinciden con las reglas del grid", "[map][cells]") {
+    Map map;
+    REQUIRE(map.loadFromFile(FixturePath("mechanisms_valid.txt"), 16));
+
+    // Recorremos el grid de texto y comparamos con las máscaras precalculadas
+    for (int y = 0; y < map.height(); ++y) {
+        for (int x = 0; x < map.width(); ++x) {
+            const char c = map.at(x, y);
+            const bool upperMech = c >= 'A' && c <= 'Z' && c != 'P' && c != 'E' && c != 'K' && c != 'X';
+            REQUIRE(map.isWall(x, y) == (c == '#'));
+            REQUIRE(map.isWalkable(x, y) == (c != '#'));
+            REQUIRE(map.isDoor(x, y) == upperMech);
+            REQUIRE(map.isWalkableForEnemy(x, y) == (c != '#' && c != 'X' && !upperMech));
+        }
+    }
+
+    REQUIRE_FALSE(map.isWalkable(-1, 0));
+    REQUIRE_FALSE(map.isWalkableForEnemy(0, map.height()));
+}
+
+TEST_CASE("Map: clearCell mantiene sincronizadas las mascaras", "[map][cells]") {
+    Map map;
+    REQUIRE(map.loadFromFile(FixturePath("mechanisms_valid.txt"), 16));
+
+    // 'D' en (3,2): puerta → el enemigo no pasa
+    REQUIRE(map.isDoor(3, 2));
+    REQUIRE_FALSE(map.isWalkableForEnemy(3, 2));
+
+    REQUIRE(map.clearCell(3, 2));
+    REQUIRE(map.grid()[2][3] == '.');
+    REQUIRE(map.cellType(3, 2) == CellType::Floor);
+    REQUIRE_FALSE(map.isDoor(3, 2));
+    REQUIRE(map.isWalkableForEnemy(3, 2));
+
+    // Convertir suelo en pared también actualiza las máscaras
+    REQUIRE(map.clearCell(2, 1, '#'));
+    REQUIRE(map.isWall(2, 1));
+    REQUIRE_FALSE(map.isWalkable(2, 1));
+}
+
+TEST_CASE("Map: bitmap de celdas bloqueadas por mecanismos", "[map][cells]") {
+    Map map;
+    REQUIRE(map.loadFromFile(FixturePath("mechanisms_valid.txt"), 16));
+
+    REQUIRE_FALSE(map.isMechanismBlocked(3, 2));
+
+    const unsigned rev = map.navRevision();
+    map.setMechanismBlocked(3, 2, true);
+    REQUIRE(map.isMechanismBlocked(3, 2));
+    REQUIRE(map.navRevision() != rev);
+
+    // Repetir el mismo estado no cambia la revisión
+    const unsigned rev2 = map.navRevision();
+    map.setMechanismBlocked(3, 2, true);
+    REQUIRE(map.navRevision() == rev2);
+
+    map.setMechanismBlocked(3, 2, false);
+    REQUIRE_FALSE(map.isMechanismBlocked(3, 2));
+
+    // Fuera de rango se ignora
+    map.setMechanismBlocked(-1, 0, true);
+    REQUIRE_FALSE(map.isMechanismBlocked(-1, 0));
+}
@@ -0,0 +1,349 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "ecs/Ecs.hpp"
+#include "ecs/ColliderGrid.hpp"
+#include "objects/NavHierarchy.hpp"
+
+namespace {
+    // Archivo temporal que se borra al salir del test
+    struct TempPath {
+        std::string path;
+
+        explicit TempPath(const std::string& name)
+            : path((std::filesystem::temp_directory_path() / name).string()) {}
+
+        ~TempPath() { std::remove(path.c_str()); }
+    };
+
+    /**
+     * Mundo de chunksX x chunksY chunks (el último de cada eje a medias si 'ragged'):
+     *  - borde de pared, pasillos de pared cada 7 celdas con huecos, un enemigo
+     *    por chunk y el jugador en (5,5).
+     *  - El chunk de arriba a la derecha es todo pared (no ocupa espacio en el .lvc).
+     *  - Una llave, unos pinchos y un mecanismo 'a'/'A' repartidos entre chunks.
+     */
+    void WriteWorld(const std::string& path, int chunksX, int chunksY, bool ragged) {
+        const int w = chunksX * MAP_CHUNK_SIZE - (ragged ? 42 : 0);
+        const int h = chunksY * MAP_CHUNK_SIZE - (ragged ? 20 : 0);
+        std::vector<std::string> rows(h, std::string(w, '.'));
+        for (int y = 0; y < h; ++y) {
+            for (int x = 0; x < w; ++x) {
+                const bool border = x == 0 || y == 0 || x == w - 1 || y == h - 1;
+                const bool corridor = (x % 7 == 3) && (y % 11 != 5);
+                const bool emptyChunk = x >= (chunksX - 1) * MAP_CHUNK_SIZE && y < MAP_CHUNK_SIZE;
+                if (border || corridor || emptyChunk) rows[y][x] = '#';
+            }
+        }
+        for (int cy = 0; cy < chunksY; ++cy) {
+            for (int cx = 0; cx < chunksX; ++cx) {
+                if (cx == chunksX - 1 && cy == 0) continue;
+                const int x = cx * MAP_CHUNK_SIZE + 30;
+                const int y = cy * MAP_CHUNK_SIZE + 16;
+                if (x < w - 1 && y < h - 1) rows[y][x] = 'E';
+            }
+        }
+        rows[5][5] = 'P';
+        rows[5][8] = 'K';
+        rows[16][70] = '^';
+        rows[27][9] = 'a';
+        rows[MAP_CHUNK_SIZE + 27][9] = 'A';
+
+        std::ofstream out(path, std::ios::trunc);
+        for (const auto& row : rows) out << row << '\n';
+    }
+
+    void LoadAllChunks(Map& map) {
+        for (int chunk = 0; chunk < map.chunksX() * map.chunksY(); ++chunk) map.loadChunk(chunk);
+    }
+
+    size_t ChunkEntities(const entt::registry& registry) {
+        return registry.view<const ChunkMemberComponent>().size();
+    }
+} // namespace
+
+TEST_CASE("Map: el formato por chunks reproduce el mapa al cargar todos los chunks", "[map][chunked]") {
+    TempPath txt("dca_test_world.txt");
+    TempPath lvc("dca_test_world.lvc");
+    WriteWorld(txt.path, 3, 3, true);
+
+    Map dense;
+    REQUIRE(dense.loadFromFile(txt.path, 16));
+    dense.saveChunked(lvc.path);
+
+    Map chunked;
+    REQUIRE(chunked.loadChunked(lvc.path, 16));
+    REQUIRE(chunked.isChunked());
+    REQUIRE(chunked.width() == dense.width());
+    REQUIRE(chunked.height() == dense.height());
+    REQUIRE(chunked.chunksX() == 3);
+    REQUIRE(chunked.chunksY() == 3);
+    REQUIRE(chunked.chars().empty());
+    REQUIRE(chunked.playerStart().x == dense.playerStart().x);
+    REQUIRE(chunked.playerStart().y == dense.playerStart().y);
+    REQUIRE(chunked.getTotalKeys() == dense.getTotalKeys());
+    REQUIRE(chunked.getMechanisms().size() == dense.getMechanisms().size());
+
+    // Nada cargado todavía: todo se comporta como pared
+    REQUIRE(chunked.residentChunks().empty());
+    REQUIRE_FALSE(chunked.isWalkable(5, 5));
+    REQUIRE(chunked.isWall(5, 5));
+    REQUIRE(chunked.at(5, 5) == '#');
+    REQUIRE(chunked.cellType(5, 5) == CellType::Wall);
+
+    // El chunk todo pared no se guarda en el archivo
+    REQUIRE(std::filesystem::file_size(lvc.path) < 8u * MAP_CHUNK_SIZE * MAP_CHUNK_SIZE + 1024u);
+
+    LoadAllChunks(chunked);
+    REQUIRE(chunked.residentChunks().size() == 9);
+    REQUIRE(chunked.grid() == dense.grid());
+    for (int y = 0; y < dense.height(); ++y) {
+        for (int x = 0; x < dense.width(); ++x) {
+            REQUIRE(chunked.isWalkable(x, y) == dense.isWalkable(x, y));
+            REQUIRE(chunked.isWalkableForEnemy(x, y) == dense.isWalkableForEnemy(x, y));
+            REQUIRE(chunked.isWall(x, y) == dense.isWall(x, y));
+            REQUIRE(chunked.isDoor(x, y) == dense.isDoor(x, y));
+            REQUIRE(chunked.cellType(x, y) == dense.cellType(x, y));
+        }
+    }
+
+    // Un mapa por chunks no se puede volcar con saveState
+    std::vector<uint8_t> bytes;
+    ByteWriter writer(bytes);
+    REQUIRE_THROWS_AS(chunked.saveState(writer), std::runtime_error);
+}
+
+TEST_CASE("Map: loadChunked rechaza archivos que no son mapas por chunks", "[map][chunked]") {
+    TempPath txt("dca_test_world_bad.txt");
+    TempPath lvl("dca_test_world_bad.lvl");
+    WriteWorld(txt.path, 2, 2, false);
+
+    Map dense;
+    REQUIRE(dense.loadFromFile(txt.path, 16));
+    dense.saveBinary(lvl.path);
+
+    Map map;
+    REQUIRE_THROWS_AS(map.loadChunked(txt.path, 16), std::runtime_error);
+    REQUIRE_THROWS_AS(map.loadChunked(lvl.path, 16), std::runtime_error);
+    REQUIRE_THROWS_AS(map.loadChunked("no_existe.lvc", 16), std::runtime_error);
+}
+
+TEST_CASE("Map: descargar un chunk conserva sus cambios y los mecanismos", "[map][chunked]") {
+    TempPath txt("dca_test_world_edit.txt");
+    TempPath lvc("dca_test_world_edit.lvc");
+    WriteWorld(txt.path, 2, 2, false);
+    {
+        Map dense;
+        REQUIRE(dense.loadFromFile(txt.path, 16));
+        dense.saveChunked(lvc.path);
+    }
+
+    Map map;
+    REQUIRE(map.loadChunked(lvc.path, 16));
+    const int first = map.chunkOf(5, 5);
+    const int second = map.chunkOf(9, MAP_CHUNK_SIZE + 27);
+    REQUIRE(first != second);
+
+    // Sin cargar no hay nada que retirar
+    REQUIRE_FALSE(map.clearCell(8, 5));
+
+    unsigned revision = map.navRevision();
+    REQUIRE(map.loadChunk(first));
+    REQUIRE_FALSE(map.loadChunk(first));
+    std::vector<int> changed;
+    REQUIRE(map.navChangesSince(revision, changed));
+    REQUIRE_FALSE(changed.empty());
+
+    // Recoger la llave y descargar: al volver sigue recogida
+    REQUIRE(map.at(8, 5) == 'K');
+    REQUIRE(map.clearCell(8, 5));
+    REQUIRE(map.getTotalKeys() == 0);
+    map.unloadChunk(first);
+    REQUIRE_FALSE(map.isChunkResident(first));
+    REQUIRE_FALSE(map.isWalkable(8, 5));
+    REQUIRE(map.loadChunk(first));
+    REQUIRE(map.at(8, 5) == '.');
+    REQUIRE(map.isWalkable(8, 5));
+
+    // Un target bloqueado con su chunk descargado sigue bloqueado al cargarlo
+    const auto& mech = map.getMechanisms().front();
+    map.setMechanismBlocked(mech.target.x, mech.target.y, true);
+    REQUIRE_FALSE(map.isMechanismBlocked(mech.target.x, mech.target.y));
+    REQUIRE(map.loadChunk(second));
+    REQUIRE(map.isMechanismBlocked(mech.target.x, mech.target.y));
+    map.setMechanismBlocked(mech.target.x, mech.target.y, false);
+    map.unloadChunk(second);
+    REQUIRE(map.loadChunk(second));
+    REQUIRE_FALSE(map.isMechanismBlocked(mech.target.x, mech.target.y));
+
+    // LRU: touchChunk adelanta el uso
+    map.touchChunk(first);
+    REQUIRE(map.chunkLastUse(first) > map.chunkLastUse(second));
+    REQUIRE(map.chunkLastUse(map.chunkOf(MAP_CHUNK_SIZE + 5, 5)) == 0);
+
+    // Volver a un mapa normal sale del modo por chunks
+    REQUIRE(map.loadFromFile(txt.path, 16));
+    REQUIRE_FALSE(map.isChunked());
+    REQUIRE(map.at(8, 5) == 'K');
+}
+
+TEST_CASE("NavHierarchy: cargar un chunk rehace solo su zona", "[map][chunked][nav_hierarchy]") {
+    TempPath txt("dca_test_world_nav.txt");
+    TempPath lvc("dca_test_world_nav.lvc");
+    WriteWorld(txt.path, 4, 4, false);
+    {
+        Map dense;
+        REQUIRE(dense.loadFromFile(txt.path, 16));
+        dense.saveChunked(lvc.path);
+    }
+
+    Map map;
+    REQUIRE(map.loadChunked(lvc.path, 16));
+    map.loadChunk(0);
+
+    NavHierarchy nav;
+    REQUIRE(nav.update(map));
+    const size_t before = nav.nodeCount();
+
+    REQUIRE(map.loadChunk(1));
+    REQUIRE(nav.update(map));
+    REQUIRE(nav.lastRebuildCount() < nav.clusterCount());
+    REQUIRE(nav.nodeCount() > before);
+
+    // Igual que construirla de cero con los mismos chunks cargados
+    NavHierarchy fresh;
+    REQUIRE(fresh.update(map));
+    REQUIRE(fresh.nodeCount() == nav.nodeCount());
+
+    map.unloadChunk(1);
+    REQUIRE(nav.update(map));
+    REQUIRE(nav.nodeCount() == before);
+}
+
+TEST_CASE("StreamMapChunks: crea y destruye las entidades de cada chunk (LRU)", "[ecs][chunked]") {
+    TempPath txt("dca_test_world_stream.txt");
+    TempPath lvc("dca_test_world_stream.lvc");
+    WriteWorld(txt.path, 8, 8, false);
+    {
+        Map dense;
+        REQUIRE(dense.loadFromFile(txt.path, 16));
+        dense.saveChunked(lvc.path);
+    }
+
+    Map map;
+    REQUIRE(map.loadChunked(lvc.path, 16));
+    entt::registry registry;
+    LevelSetupSystem(registry, map, 3);
+
+    // Solo los chunks a un chunk o menos del jugador (en la esquina: 2x2)
+    REQUIRE(map.residentChunks().size() == 4);
+    REQUIRE(registry.view<PlayerInputComponent>().size() == 1);
+    REQUIRE(registry.view<EnemyAIComponent>().size() == 4);
+    REQUIRE(ChunkEntities(registry) == 4 + 2);   // + la llave y los pinchos
+
+    // Paseo por el mundo: nunca más de MAP_CHUNK_MAX_RESIDENT chunks cargados
+    const IVec2 route[] = { { 250, 40 }, { 480, 40 }, { 480, 250 }, { 480, 480 }, { 250, 480 }, { 40, 480 } };
+    for (const IVec2 center : route) {
+        StreamMapChunks(registry, map, center, 3);
+        REQUIRE(map.residentChunks().size() <= MAP_CHUNK_MAX_RESIDENT);
+        REQUIRE(map.isChunkResident(map.chunkOf(center.x, center.y)));
+
+        // Cada entidad pertenece a un chunk cargado y está en el broadphase
+        const auto& grid = registry.ctx().get<ColliderGrid>();
+        auto view = registry.view<const ChunkMemberComponent, const ColliderCellComponent>();
+        for (auto entity : view) {
+            REQUIRE(map.isChunkResident(view.get<const ChunkMemberComponent>(entity).chunk));
+            const auto& bucket = grid.bucket(view.get<const ColliderCellComponent>(entity).cell);
+            REQUIRE(std::find(bucket.begin(), bucket.end(), entity) != bucket.end());
+        }
+    }
+
+    // El chunk inicial fue el menos usado: ya se ha descargado con sus entidades
+    REQUIRE_FALSE(map.isChunkResident(0));
+    for (auto entity : registry.view<const ChunkMemberComponent>()) {
+        REQUIRE(registry.get<ChunkMemberComponent>(entity).chunk != 0);
+    }
+
+    // Volver: el chunk reaparece con su enemigo y su llave (no se había recogido)
+    StreamMapChunks(registry, map, IVec2{ 5, 5 }, 3);
+    REQUIRE(map.isChunkResident(0));
+    size_t inFirst = 0;
+    for (auto entity : registry.view<const ChunkMemberComponent>()) {
+        if (registry.get<ChunkMemberComponent>(entity).chunk == 0) ++inFirst;
+    }
+    REQUIRE(inFirst == 2);
+}
+
+TEST_CASE("Streaming por chunks: una entidad que cruza de chunk no se duplica ni se pierde", "[map][chunked]") {
+    TempPath txt("dca_test_world_cross.txt");
+    TempPath lvc("dca_test_world_cross.lvc");
+    WriteWorld(txt.path, 4, 4, false);
+    {
+        Map dense;
+        REQUIRE(dense.loadFromFile(txt.path, 16));
+        dense.saveChunked(lvc.path);
+    }
+
+    Map map;
+    REQUIRE(map.loadChunked(lvc.path, 16));
+    entt::registry registry;
+    LevelSetupSystem(registry, map, 3);
+    REQUIRE(map.isChunkResident(1));
+    auto enemies = [&]() { return registry.view<const EnemyAIComponent>().size(); };
+    const size_t total = enemies();
+
+    // El enemigo del chunk 0 da un paso hasta la primera columna del chunk 1
+    entt::entity chaser = entt::null;
+    for (auto entity : registry.view<const EnemyAIComponent, const ChunkMemberComponent>()) {
+        if (registry.get<ChunkMemberComponent>(entity).chunk == 0) chaser = entity;
+    }
+    REQUIRE(registry.valid(chaser));
+    const int origin = registry.get<ChunkMemberComponent>(chaser).originCell;
+    REQUIRE(map.chunkOf(origin % map.width(), origin / map.width()) == 0);
+
+    const float tile = (float)map.tile();
+    const float y = 16 * tile + tile / 2;
+    auto& transform = registry.get<TransformComponent>(chaser);
+    auto& move = registry.get<MovementComponent>(chaser);
+    transform.position = { (MAP_CHUNK_SIZE - 1) * tile + tile / 2, y };
+    move.startPos = transform.position;
+    move.targetPos = { MAP_CHUNK_SIZE * tile + tile / 2, y };
+    move.isMoving = true;
+    move.progress = 0.0f;
+    MovementSystem(registry, map, move.duration);
+
+    REQUIRE(registry.get<ChunkMemberComponent>(chaser).chunk == 1);
+    REQUIRE(registry.get<ChunkMemberComponent>(chaser).originCell == origin);
+
+    // Descargar y recargar su chunk de origen: sigue vivo y no aparece otro
+    DespawnChunkEntities(registry, 0);
+    map.unloadChunk(0);
+    REQUIRE(registry.valid(chaser));
+    REQUIRE(map.loadChunk(0));
+    SpawnChunkEntities(registry, map, 0, 3);
+    REQUIRE(registry.valid(chaser));
+    REQUIRE(enemies() == total);
+
+    // Descargar el chunk en el que está: se destruye y vuelve a nacer en su origen
+    DespawnChunkEntities(registry, 1);
+    map.unloadChunk(1);
+    REQUIRE_FALSE(registry.valid(chaser));
+    SpawnChunkEntities(registry, map, 0, 3);
+    size_t fromOrigin = 0;
+    for (auto entity : registry.view<const EnemyAIComponent, const ChunkMemberComponent>()) {
+        const auto& member = registry.get<ChunkMemberComponent>(entity);
+        if (member.originCell == origin && member.chunk == 0) ++fromOrigin;
+    }
+    REQUIRE(fromOrigin == 1);
+
+    // Con el chunk 1 de vuelta (y su propio enemigo) el total es el de partida
+    REQUIRE(map.loadChunk(1));
+    SpawnChunkEntities(registry, map, 1, 3);
+    REQUIRE(enemies() == total);
+}
@@ -4,6 +4,7 @@
 #include <filesystem>
 #include <fstream>
 #include <string>
+#include <vector>
 
 #include "objects/Map.hpp"
 
@@ -96,3 +97,86 @@ TEST_CASE("Map: soporta CRLF sin contaminar caracteres", "[map][io]") {
     REQUIRE(map.at(1, 1) == 'P');
     REQUIRE(map.at(3, 2) == 'X');
 }
+
+TEST_CASE("Map: ultima fila sin salto de linea y linea vacia final", "[map][io]") {
+    Map map;
+    {
+        TempFile tmp("#####\n#P.X#\n#####");
+        REQUIRE(map.loadFromFile(tmp.path, 16));
+        REQUIRE(map.height() == 3);
+        REQUIRE(map.at(4, 2) == '#');
+    }
+    {
+        // Una línea vacía cuenta como fila (de ancho 0): no es rectangular
+        TempFile tmp("#####\n#P.X#\n#####\n\n");
+        REQUIRE_THROWS_AS(map.loadFromFile(tmp.path, 16), std::runtime_error);
+    }
+}
+
+/* Mapa generado con anchos que no son múltiplo del bloque vectorial (16) y
+ * todo tipo de caracteres: cada celda debe clasificarse igual que celda a celda
+ * y los spawns deben salir en orden de lectura (fila a fila). */
+TEST_CASE("Map: la carga en una pasada clasifica igual que el escaneo celda a celda", "[map][io]") {
+    const std::string alphabet = "....######..EK^X.#aAbB";
+    for (int w : { 7, 16, 33, 70 }) {
+        std::string lf, crlf;
+        std::vector<std::string> rows;
+        unsigned state = 12345u + static_cast<unsigned>(w);
+        for (int y = 0; y < 9; ++y) {
+            std::string row(static_cast<size_t>(w), '.');
+            for (int x = 0; x < w; ++x) {
+                state = state * 1103515245u + 12345u;
+                row[x] = alphabet[(state >> 16) % alphabet.size()];
+            }
+            rows.push_back(row);
+        }
+        rows[4][w / 2] = 'P';
+        // Cada letra de mecanismo necesita su pareja
+        rows[8][0] = 'a'; rows[8][1] = 'A'; rows[8][2] = 'b'; rows[8][3] = 'B';
+        for (const auto& row : rows) {
+            lf += row + "\n";
+            crlf += row + "\r\n";
+        }
+
+        Map a, b;
+        {
+            TempFile tmp(lf);
+            REQUIRE(a.loadFromFile(tmp.path, 16));
+        }
+        {
+            TempFile tmp(crlf);
+            REQUIRE(b.loadFromFile(tmp.path, 16));
+        }
+
+        REQUIRE(a.width() == w);
+        REQUIRE(a.height() == 9);
+        REQUIRE(a.grid() == rows);
+        REQUIRE(b.grid() == rows);
+        REQUIRE(a.cells() == b.cells());
+
+        std::vector<IVec2> enemies, keys;
+        for (int y = 0; y < 9; ++y) {
+            for (int x = 0; x < w; ++x) {
+                const char c = rows[y][x];
+                if (c == 'E') enemies.push_back({ x, y });
+                if (c == 'K') keys.push_back({ x, y });
+
+                const bool wall = c == '#';
+                const bool door = c == 'A' || c == 'B';
+                REQUIRE(a.isWall(x, y) == wall);
+                REQUIRE(a.isDoor(x, y) == door);
+                REQUIRE(a.isWalkable(x, y) == !wall);
+                REQUIRE(a.isWalkableForEnemy(x, y) == (!wall && !door && c != 'X'));
+                REQUIRE(b.isWalkableForEnemy(x, y) == a.isWalkableForEnemy(x, y));
+            }
+        }
+        REQUIRE(a.enemyStarts().size() == enemies.size());
+        for (size_t i = 0; i < enemies.size(); ++i) {
+            REQUIRE(a.enemyStarts()[i].x == enemies[i].x);
+            REQUIRE(a.enemyStarts()[i].y == enemies[i].y);
+        }
+        REQUIRE(a.keyPositions().size() == keys.size());
+        REQUIRE(a.playerStart().x == w / 2);
+        REQUIRE(a.playerStart().y == 4);
+    }
+}
@@ -0,0 +1,63 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include "ecs/Ecs.hpp"
+#include "ecs/CellEvents.hpp"
+#include "ecs/MechanismIndex.hpp"
+
+namespace {
+    // Helper para construir rutas de fixtures desde la macro TESTS_DIR.
+    std::string FixturePath(const std::string& filename) {
+        return std::string(TESTS_DIR) + "/fixtures/" + filename;
+    }
+
+    // Lanza un paso completo del jugador hacia la celda (x,y) y ejecuta los sistemas implicados.
+    void StepPlayerTo(entt::registry& registry, Map& map, entt::entity player, int x, int y) {
+        const float tile = (float)map.tile();
+        auto& tr = registry.get<TransformComponent>(player);
+        auto& move = registry.get<MovementComponent>(player);
+
+        move.startPos = tr.position;
+        move.targetPos = { x * tile + tile / 2.0f, y * tile + tile / 2.0f };
+        move.duration = 0.1f;
+        move.progress = 0.0f;
+        move.isMoving = true;
+
+        MovementSystem(registry, map, 1.0f);
+        MechanismSystem(registry, map);
+    }
+} // namespace
+
+TEST_CASE("MechanismSystem: el trigger se activa al entrar en su celda", "[ecs][mechanisms]") {
+    Map map;
+    REQUIRE(map.loadFromFile(FixturePath("mechanisms_valid.txt"), 16));
+
+    entt::registry registry;
+    LevelSetupSystem(registry, map);
+
+    auto playerView = registry.view<PlayerInputComponent>();
+    REQUIRE_FALSE(playerView.empty());
+    auto player = *playerView.begin();
+
+    // 'd' en (4,1) abre la puerta 'D' en (3,2)
+    auto& index = registry.ctx().get<MechanismIndex>();
+    const MechanismId doorId = index.triggerAt(4, 1);
+    REQUIRE(doorId != MechanismIndex::NONE);
+    REQUIRE(map.isMechanismBlocked(3, 2));
+
+    // Sin cambios de celda no se procesa nada
+    MechanismSystem(registry, map);
+    REQUIRE(map.isMechanismBlocked(3, 2));
+
+    StepPlayerTo(registry, map, player, 2, 1);
+    StepPlayerTo(registry, map, player, 3, 1);
+    REQUIRE(map.isMechanismBlocked(3, 2));
+
+    StepPlayerTo(registry, map, player, 4, 1);
+    REQUIRE_FALSE(map.isMechanismBlocked(3, 2));
+    REQUIRE(index.triggerAt(4, 1) == MechanismIndex::NONE);
+    REQUIRE(registry.ctx().get<CellEventQueue>().entered.empty());
+
+    for (auto e : index.entities(doorId)) {
+        REQUIRE_FALSE(registry.get<MechanismComponent>(e).active);
+    }
+}
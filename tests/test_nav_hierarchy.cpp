@@ -0,0 +1,176 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "objects/FlowField.hpp"
+#include "objects/NavHierarchy.hpp"
+
+namespace {
+    // Helper para construir rutas de fixtures desde la macro TESTS_DIR.
+    std::string FixturePath(const std::string& filename) {
+        return std::string(TESTS_DIR) + "/fixtures/" + filename;
+    }
+
+    // Sigue stepToward hasta llegar a goal; devuelve los pasos o -1 si se atasca.
+    int WalkRoute(const NavHierarchy& nav, const Map& map, IVec2 from, IVec2 goal, int maxSteps) {
+        int steps = 0;
+        while (from.x != goal.x || from.y != goal.y) {
+            IVec2 next;
+            if (steps >= maxSteps || !nav.stepToward(map, from, goal, next)) return -1;
+            if (std::abs(next.x - from.x) + std::abs(next.y - from.y) != 1) return -1;
+            from = next;
+            ++steps;
+        }
+        return steps;
+    }
+
+    // Como EnemyAISystem: una sola findRoute y después stepToWaypoint por la ruta guardada.
+    int WalkCachedRoute(const NavHierarchy& nav, const Map& map, IVec2 from, IVec2 goal, int maxSteps) {
+        std::vector<IVec2> route;
+        if (!nav.findRoute(map, from, goal, route)) return -1;
+
+        size_t waypoint = 0;
+        int steps = 0;
+        while (from.x != goal.x || from.y != goal.y) {
+            while (waypoint < route.size() && route[waypoint].x == from.x && route[waypoint].y == from.y) ++waypoint;
+            IVec2 next;
+            if (steps >= maxSteps || waypoint >= route.size() ||
+                !nav.stepToWaypoint(map, from, route[waypoint], next)) return -1;
+            if (std::abs(next.x - from.x) + std::abs(next.y - from.y) != 1) return -1;
+            from = next;
+            ++steps;
+        }
+        return steps;
+    }
+} // namespace
+
+TEST_CASE("NavHierarchy: las rutas llegan a cualquier celda alcanzable", "[ai][nav_hierarchy]") {
+    Map map;
+    REQUIRE(map.loadFromFile(FixturePath("nav_maze.txt"), 16));
+
+    NavHierarchy nav;
+    REQUIRE(nav.update(map, 4));
+    REQUIRE(nav.clusterCount() == 6 * 3);
+    REQUIRE(nav.nodeCount() > 0);
+    REQUIRE_FALSE(nav.update(map, 4));
+
+    // Contra BFS: misma alcanzabilidad y rutas de longitud razonable
+    const IVec2 goal = map.playerStart();
+    FlowField flow;
+    flow.update(map, goal);
+
+    for (int y = 0; y < map.height(); ++y) {
+        for (int x = 0; x < map.width(); ++x) {
+            if (!map.isWalkableForEnemy(x, y)) continue;
+            const uint16_t best = flow.distance(x, y);
+            const int steps = WalkRoute(nav, map, { x, y }, goal, 4 * map.width() * map.height());
+            if (best == FlowField::UNREACHABLE) {
+                REQUIRE(steps == -1);
+            } else {
+                REQUIRE(steps >= best);
+                REQUIRE(steps <= 2 * best + 8);
+            }
+        }
+    }
+}
+
+TEST_CASE("NavHierarchy: un mecanismo solo rehace los clusters tocados", "[ai][nav_hierarchy]") {
+    Map map;
+    REQUIRE(map.loadFromFile(FixturePath("nav_maze.txt"), 16));
+
+    NavHierarchy nav;
+    nav.update(map, 4);
+    REQUIRE(nav.lastRebuildCount() == nav.clusterCount());
+
+    // Celda interior de un cluster (5,5): solo su cluster
+    map.setMechanismBlocked(5, 5, true);
+    REQUIRE(nav.isStale(map, 4));
+    REQUIRE(nav.update(map, 4));
+    REQUIRE(nav.lastRebuildCount() == 1);
+
+    // Celda en una frontera vertical (15,9): el cluster de cada lado
+    map.setMechanismBlocked(15, 9, true);
+    REQUIRE(nav.update(map, 4));
+    REQUIRE(nav.lastRebuildCount() == 2);
+
+    // Esquina de cluster (4,8), único acceso a la zona del jugador: tres clusters
+    map.setMechanismBlocked(4, 8, true);
+    REQUIRE(nav.update(map, 4));
+    REQUIRE(nav.lastRebuildCount() == 3);
+
+    std::vector<IVec2> route;
+    REQUIRE_FALSE(nav.findRoute(map, { 22, 1 }, map.playerStart(), route));
+
+    map.setMechanismBlocked(4, 8, false);
+    REQUIRE(nav.update(map, 4));
+    REQUIRE(nav.findRoute(map, { 22, 1 }, map.playerStart(), route));
+    REQUIRE(route.back().x == map.playerStart().x);
+    REQUIRE(route.back().y == map.playerStart().y);
+
+    // Sin historial (recarga o markNavigationDirty) se reconstruye todo
+    map.markNavigationDirty();
+    REQUIRE(nav.update(map, 4));
+    REQUIRE(nav.lastRebuildCount() == nav.clusterCount());
+}
+
+TEST_CASE("NavHierarchy: una ruta guardada se sigue sin volver a planificar", "[ai][nav_hierarchy]") {
+    Map map;
+    REQUIRE(map.loadFromFile(FixturePath("nav_maze.txt"), 16));
+
+    NavHierarchy nav;
+    nav.update(map, 4);
+
+    const IVec2 goal = map.playerStart();
+    FlowField flow;
+    flow.update(map, goal);
+
+    for (int y = 0; y < map.height(); ++y) {
+        for (int x = 0; x < map.width(); ++x) {
+            if (!map.isWalkableForEnemy(x, y) || (x == goal.x && y == goal.y)) continue;
+            const uint16_t best = flow.distance(x, y);
+            const int steps = WalkCachedRoute(nav, map, { x, y }, goal, 4 * map.width() * map.height());
+            if (best == FlowField::UNREACHABLE) {
+                REQUIRE(steps == -1);
+            } else {
+                REQUIRE(steps >= best);
+                REQUIRE(steps <= 2 * best + 8);
+            }
+        }
+    }
+
+    // Un waypoint que no es vecino ni está en el cluster de from invalida la ruta
+    IVec2 next;
+    REQUIRE(nav.clusterOf(1, 1) != nav.clusterOf(22, 1));
+    REQUIRE_FALSE(nav.stepToWaypoint(map, { 1, 1 }, { 22, 1 }, next));
+}
+
+TEST_CASE("NavHierarchy: al agotar las expansiones devuelve una ruta parcial hacia el objetivo", "[ai][nav_hierarchy]") {
+    Map map;
+    REQUIRE(map.loadFromFile(FixturePath("nav_maze.txt"), 16));
+
+    NavHierarchy nav;
+    nav.update(map, 4);
+
+    const IVec2 start{ 22, 1 };
+    const IVec2 goal = map.playerStart();
+    std::vector<IVec2> full;
+    REQUIRE(nav.findRoute(map, start, goal, full));
+
+    // Con un tope mínimo la ruta no llega a goal, pero se puede seguir hasta su final
+    std::vector<IVec2> partial;
+    REQUIRE(nav.findRoute(map, start, goal, partial, 2));
+    REQUIRE_FALSE(partial.empty());
+    REQUIRE(partial.size() < full.size());
+    const IVec2 end = partial.back();
+    REQUIRE_FALSE((end.x == goal.x && end.y == goal.y));
+
+    IVec2 from = start;
+    size_t waypoint = 0;
+    for (int steps = 0; from.x != end.x || from.y != end.y; ++steps) {
+        while (partial[waypoint].x == from.x && partial[waypoint].y == from.y) ++waypoint;
+        IVec2 next;
+        REQUIRE(steps < 200);
+        REQUIRE(nav.stepToWaypoint(map, from, partial[waypoint], next));
+        from = next;
+    }
+}
@@ -0,0 +1,127 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "ecs/Ecs.hpp"
+#include "objects/FlowField.hpp"
+#include "objects/PathService.hpp"
+
+namespace {
+    // Helper para construir rutas de fixtures desde la macro TESTS_DIR.
+    std::string FixturePath(const std::string& filename) {
+        return std::string(TESTS_DIR) + "/fixtures/" + filename;
+    }
+
+    // Longitud de un camino de waypoints; -1 si dos seguidos no comparten fila/columna
+    // o el tramo atraviesa una celda no transitable.
+    int PathLength(const Map& map, IVec2 from, const std::vector<IVec2>& waypoints, IVec2 goal) {
+        int length = 0;
+        for (const IVec2& wp : waypoints) {
+            if (wp.x != from.x && wp.y != from.y) return -1;
+            while (from.x != wp.x || from.y != wp.y) {
+                from.x += (wp.x > from.x) - (wp.x < from.x);
+                from.y += (wp.y > from.y) - (wp.y < from.y);
+                const bool isGoal = (from.x == goal.x && from.y == goal.y);
+                if (!isGoal && (!map.isWalkableForEnemy(from.x, from.y) || map.isMechanismBlocked(from.x, from.y))) {
+                    return -1;
+                }
+                ++length;
+            }
+        }
+        return length;
+    }
+
+    // Compara todos los orígenes transitables contra un BFS hacia goal.
+    void RequireOptimalPaths(const Map& map, IVec2 goal) {
+        FlowField flow;
+        flow.update(map, goal);
+        std::vector<IVec2> waypoints;
+
+        for (int y = 0; y < map.height(); ++y) {
+            for (int x = 0; x < map.width(); ++x) {
+                if (!map.isWalkableForEnemy(x, y) || (x == goal.x && y == goal.y)) continue;
+                const bool found = PathService::Get().findPath(map, { x, y }, goal, waypoints);
+                const uint16_t best = flow.distance(x, y);
+                REQUIRE(found == (best != FlowField::UNREACHABLE));
+                if (!found) continue;
+
+                REQUIRE(waypoints.back().x == goal.x);
+                REQUIRE(waypoints.back().y == goal.y);
+                REQUIRE(PathLength(map, { x, y }, waypoints, goal) == best);
+            }
+        }
+    }
+} // namespace
+
+TEST_CASE("PathService: JPS da caminos óptimos y comprimidos", "[ai][path_service]") {
+    Map maze;
+    REQUIRE(maze.loadFromFile(FixturePath("nav_maze.txt"), 16));
+    RequireOptimalPaths(maze, maze.playerStart());
+    RequireOptimalPaths(maze, IVec2{ 22, 1 });
+
+    Map concave;
+    REQUIRE(concave.loadFromFile(FixturePath("flow_concave.txt"), 16));
+    RequireOptimalPaths(concave, concave.playerStart());
+
+    // En línea recta por un pasillo basta un waypoint
+    std::vector<IVec2> waypoints;
+    REQUIRE(PathService::Get().findPath(maze, { 1, 1 }, { 1, 7 }, waypoints));
+    REQUIRE(waypoints.size() == 1);
+}
+
+TEST_CASE("PathService: mecanismos, tope de expansiones y buffers reutilizados", "[ai][path_service]") {
+    Map map;
+    REQUIRE(map.loadFromFile(FixturePath("nav_maze.txt"), 16));
+    std::vector<IVec2> waypoints;
+
+    // (4,8) es el único acceso a la zona del jugador
+    map.setMechanismBlocked(4, 8, true);
+    REQUIRE_FALSE(PathService::Get().findPath(map, { 22, 1 }, map.playerStart(), waypoints));
+    REQUIRE(waypoints.empty());
+    map.setMechanismBlocked(4, 8, false);
+
+    REQUIRE_FALSE(PathService::Get().findPath(map, { 22, 1 }, map.playerStart(), waypoints, 2));
+    REQUIRE(PathService::Get().findPath(map, { 22, 1 }, map.playerStart(), waypoints));
+
+    // Repetir la consulta no necesita más memoria en el vector de salida
+    const size_t capacity = waypoints.capacity();
+    REQUIRE(PathService::Get().findPath(map, { 22, 1 }, map.playerStart(), waypoints));
+    REQUIRE(waypoints.capacity() == capacity);
+}
+
+TEST_CASE("EnemyAISystem: sin tabla de distancias persigue con ruta cacheada", "[ai][path_service]") {
+    // 40x30 supera DISTANCE_ORACLE_MAX_CELLS: la persecución usa PathService
+    Map map;
+    REQUIRE(map.loadFromFile(FixturePath("chase_hall.txt"), 16));
+    REQUIRE(static_cast<size_t>(map.width() * map.height()) > DISTANCE_ORACLE_MAX_CELLS);
+
+    entt::registry registry;
+    LevelSetupSystem(registry, map, 1);
+
+    auto enemies = registry.view<const TransformComponent, const EnemyAIComponent, const EnemyPathComponent>();
+    REQUIRE(enemies.size_hint() == 1);
+    const auto enemy = *enemies.begin();
+    const float tile = static_cast<float>(map.tile());
+    const IVec2 player = map.playerStart();
+
+    auto cellDistance = [&]() {
+        const Vector2 pos = registry.get<TransformComponent>(enemy).position;
+        const int x = static_cast<int>(std::round((pos.x - tile / 2.0f) / tile));
+        const int y = static_cast<int>(std::round((pos.y - tile / 2.0f) / tile));
+        return std::abs(x - player.x) + std::abs(y - player.y);
+    };
+    const int before = cellDistance();
+
+    for (int i = 0; i < 240; ++i) {
+        EnemyAISystem(registry, map, 1.0f / 120.0f);
+        MovementSystem(registry, map, 1.0f / 120.0f);
+    }
+
+    const auto& path = registry.get<EnemyPathComponent>(enemy);
+    REQUIRE(registry.get<EnemyAIComponent>(enemy).state == EnemyAIState::Chase);
+    REQUIRE(path.goal.x == player.x);
+    REQUIRE(path.goal.y == player.y);
+    REQUIRE(path.revision == map.navRevision());
+    REQUIRE(cellDistance() < before);
+}
@@ -0,0 +1,78 @@
+#include <catch2/catch_test_macros.hpp>
+#include "ecs/RenderQueue.hpp"
+#include "ecs/systems/RenderSystems.hpp"
+#include "ecs/systems/WorldSystems.hpp"
+
+namespace {
+    Texture2D FakeTexture(unsigned int id) {
+        Texture2D tex{};
+        tex.id = id;
+        return tex;
+    }
+} // namespace
+
+TEST_CASE("RenderQueue: ordena por capa, y y textura", "[render]") {
+    RenderQueue queue;
+    const Rectangle r{0, 0, 16, 16};
+
+    queue.push(FakeTexture(2), r, r, {0, 0}, RenderLayer::Actors, 10.0f); // 0
+    queue.push(FakeTexture(1), r, r, {0, 0}, RenderLayer::Props, 50.0f);  // 1
+    queue.push(FakeTexture(3), r, r, {0, 0}, RenderLayer::Actors, 5.0f);  // 2
+    queue.push(FakeTexture(1), r, r, {0, 0}, RenderLayer::Actors, 10.0f); // 3
+
+    queue.sort();
+    const auto& cmds = queue.commands();
+    REQUIRE(cmds.size() == 4);
+
+    // Props siempre antes que Actors aunque su y sea mayor
+    REQUIRE(cmds[0].order == 1);
+    // Dentro de la capa, de arriba a abajo
+    REQUIRE(cmds[1].order == 2);
+    // Misma y: se agrupan por textura
+    REQUIRE(cmds[2].texture.id == 1);
+    REQUIRE(cmds[3].texture.id == 2);
+}
+
+TEST_CASE("RenderQueue: clear reutiliza el buffer", "[render]") {
+    RenderQueue queue;
+    const Rectangle r{0, 0, 16, 16};
+
+    queue.push(FakeTexture(1), r, r, {0, 0}, RenderLayer::Props, 0.0f);
+    queue.clear();
+    REQUIRE(queue.commands().empty());
+
+    queue.push(FakeTexture(1), r, r, {0, 0}, RenderLayer::Props, 0.0f);
+    REQUIRE(queue.commands().front().order == 0);
+}
+
+TEST_CASE("SnapshotTransformSystem: el render interpola entre el tick anterior y el actual", "[render][tick]") {
+    entt::registry registry;
+
+    auto mover = registry.create();
+    registry.emplace<TransformComponent>(mover, Vector2{16.0f, 16.0f}, Vector2{32.0f, 32.0f});
+    registry.emplace<MovementComponent>(mover);
+
+    // Sin movimiento ni snapshot no hay nada que interpolar
+    auto still = registry.create();
+    registry.emplace<TransformComponent>(still, Vector2{48.0f, 16.0f}, Vector2{32.0f, 32.0f});
+
+    SnapshotTransformSystem(registry);
+    REQUIRE(registry.all_of<PreviousTransformComponent>(mover));
+    REQUIRE_FALSE(registry.all_of<PreviousTransformComponent>(still));
+
+    // El tick mueve la entidad: a mitad de tick se dibuja a medio camino
+    auto &transform = registry.get<TransformComponent>(mover);
+    transform.position.x = 24.0f;
+
+    Vector2 half = InterpolatedPosition(registry, mover, transform, 0.5f);
+    REQUIRE(half.x == 20.0f);
+    REQUIRE(half.y == 16.0f);
+    REQUIRE(InterpolatedPosition(registry, mover, transform, 1.0f).x == 24.0f);
+
+    // Siguiente tick: el snapshot alcanza la posición actual
+    SnapshotTransformSystem(registry);
+    REQUIRE(InterpolatedPosition(registry, mover, transform, 0.0f).x == 24.0f);
+
+    const auto &stillTransform = registry.get<TransformComponent>(still);
+    REQUIRE(InterpolatedPosition(registry, still, stillTransform, 0.5f).x == 48.0f);
+}
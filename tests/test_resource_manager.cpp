@@ -1,6 +1,8 @@
 #include <catch2/catch_test_macros.hpp>
 #include <filesystem>
+#include <fstream>
 #include <string>
+#include "core/AssetPack.hpp"
 #include "core/ResourceManager.hpp"
 #include "raylib_stubs.hpp"
 
@@ -39,3 +41,116 @@ TEST_CASE("ResourceManager: GetTexture usa cache y evita cargas duplicadas", "[r
     REQUIRE(&t1 == &t2);
     REQUIRE(RaylibStub_GetLoadTextureCalls() == 1);
 }
+
+TEST_CASE("ResourceManager: RequestTexture decodifica en segundo plano y sube por presupuesto", "[resources][async]") {
+    ResourceManager& rm = ResourceManager::Get();
+
+    rm.UnloadAll();
+    RaylibStub_ResetCounters();
+
+    const std::string idlePath = "sprites/player/Knight/Idle.png";
+    const std::string walkPath = "sprites/player/Knight/Walk.png";
+
+    // Hasta la subida la entrada es un placeholder que no se dibuja
+    const Texture2D& idle = rm.RequestTexture(idlePath);
+    rm.RequestTexture(walkPath);
+    REQUIRE(idle.id == 0);
+    REQUIRE_FALSE(rm.IsTextureReady(idlePath));
+
+    // Pedirla otra vez no lanza otra decodificación: misma entrada
+    REQUIRE(&rm.RequestTexture(idlePath) == &idle);
+
+    // Presupuesto cero: como mucho una subida por llamada
+    size_t left = 2;
+    while (left > 0) {
+        size_t before = left;
+        left = rm.ProcessPendingUploads(0.0f);
+        REQUIRE(before - left <= 1);
+    }
+
+    // La referencia devuelta se rellena en el sitio con la textura real
+    REQUIRE(rm.IsTextureReady(idlePath));
+    REQUIRE(idle.id != 0);
+    REQUIRE(idle.width > 0);
+    REQUIRE(&rm.GetTexture(idlePath) == &idle);
+    REQUIRE(RaylibStub_GetUploadTextureCalls() == 2);
+    REQUIRE(RaylibStub_GetLoadTextureCalls() == 0);
+}
+
+TEST_CASE("ResourceManager: GetTexture espera una petición pendiente sin recargar", "[resources][async]") {
+    ResourceManager& rm = ResourceManager::Get();
+
+    rm.UnloadAll();
+    RaylibStub_ResetCounters();
+
+    const std::string texturePath = "sprites/player/Knight/Idle.png";
+    const Texture2D& requested = rm.RequestTexture(texturePath);
+    const Texture2D& t = rm.GetTexture(texturePath);
+
+    REQUIRE(&t == &requested);
+    REQUIRE(rm.IsTextureReady(texturePath));
+    REQUIRE(rm.ProcessPendingUploads(0.0f) == 0);
+    REQUIRE(RaylibStub_GetUploadTextureCalls() == 1);
+    REQUIRE(RaylibStub_GetLoadTextureCalls() == 0);
+}
+
+TEST_CASE("ResourceManager: un asset solo empaquetado no tiene ruta suelta", "[resources][pack]") {
+    ResourceManager& rm = ResourceManager::Get();
+    rm.UnloadAll();
+    RaylibStub_ResetCounters();
+
+    // Árbol instalado mínimo: el sprite solo existe dentro de assets.pak
+    namespace fs = std::filesystem;
+    const fs::path previous = fs::current_path();
+    const fs::path dir = fs::temp_directory_path() / "dca_test_rm_pack";
+    fs::remove_all(dir);
+    fs::create_directories(dir / "assets/sprites");
+    fs::copy_file(std::string(TESTS_DIR) + "/../assets/sprites/spikes.png", dir / "assets/sprites/spikes.png");
+    REQUIRE(AssetPack::Write((dir / "assets").string(), { "sprites" },
+                             (dir / "assets" / AssetPack::PACK_NAME).string()) == 1);
+    fs::remove(dir / "assets/sprites/spikes.png");
+    fs::current_path(dir);
+    rm.RescanAssets();
+
+    const bool indexed = rm.HasAsset("sprites/spikes.png");
+    const std::string path = rm.GetAssetPath("sprites/spikes.png");
+    const Texture2D& tex = rm.GetTexture("sprites/spikes.png");
+    const bool loaded = tex.id != 0;
+    rm.UnloadAll();
+
+    fs::current_path(previous);
+    rm.RescanAssets();
+    fs::remove_all(dir);
+
+    REQUIRE(indexed);
+    REQUIRE(path.empty());
+    REQUIRE(loaded);
+    REQUIRE(RaylibStub_GetLoadTextureCalls() == 0);
+    REQUIRE(RaylibStub_GetUploadTextureCalls() == 1);
+}
+
+TEST_CASE("ResourceManager: HasAsset encuentra en disco lo que el índice no tiene", "[resources][io]") {
+    ResourceManager& rm = ResourceManager::Get();
+
+    namespace fs = std::filesystem;
+    const fs::path previous = fs::current_path();
+    const fs::path dir = fs::temp_directory_path() / "dca_test_rm_late";
+    fs::remove_all(dir);
+    fs::create_directories(dir / "assets/maps");
+    fs::current_path(dir);
+    rm.RescanAssets();
+
+    // Añadido después de montar el índice
+    const bool before = rm.HasAsset("maps/late.txt");
+    std::ofstream(dir / "assets/maps/late.txt") << "P\n";
+    const bool after = rm.HasAsset("maps/late.txt");
+    const bool indexed = rm.Assets().contains("maps/late.txt");
+
+    fs::current_path(previous);
+    rm.RescanAssets();
+    fs::remove_all(dir);
+
+    REQUIRE_FALSE(before);
+    REQUIRE_FALSE(indexed);
+    REQUIRE(after);
+}
@@ -0,0 +1,59 @@
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+#include "objects/VisibilityGrid.hpp"
+
+namespace {
+    // Helper para construir rutas de fixtures desde la macro TESTS_DIR.
+    std::string FixturePath(const std::string& filename) {
+        return std::string(TESTS_DIR) + "/fixtures/" + filename;
+    }
+} // namespace
+
+TEST_CASE("VisibilityGrid: la columna tapa la celda de detrás", "[ai][visibility]") {
+    Map map;
+    REQUIRE(map.loadFromFile(FixturePath("los_pillar.txt"), 16));
+
+    VisibilityGrid vis;
+    const IVec2 player = map.playerStart();
+    REQUIRE(vis.update(map, player));
+
+    // Origen, vecinos y la propia columna se ven
+    REQUIRE(vis.isVisible(player.x, player.y));
+    REQUIRE(vis.isVisible(player.x + 1, player.y));
+    REQUIRE(vis.isVisible(player.x, player.y - 1));
+    REQUIRE(vis.isVisible(4, 3));
+
+    // Justo detrás de la columna no
+    REQUIRE_FALSE(vis.isVisible(4, 2));
+    REQUIRE_FALSE(vis.isVisible(4, 1));
+
+    // Las esquinas de la sala sí (la columna solo tapa el centro)
+    REQUIRE(vis.isVisible(1, 1));
+    REQUIRE(vis.isVisible(7, 1));
+
+    // Fuera del mapa nunca es visible
+    REQUIRE_FALSE(vis.isVisible(-1, 0));
+    REQUIRE_FALSE(vis.isVisible(map.width(), 0));
+}
+
+TEST_CASE("VisibilityGrid: solo se recalcula al cambiar de celda o de mapa", "[ai][visibility]") {
+    Map map;
+    REQUIRE(map.loadFromFile(FixturePath("los_pillar.txt"), 16));
+
+    VisibilityGrid vis;
+    const IVec2 player = map.playerStart();
+    REQUIRE(vis.update(map, player));
+    REQUIRE_FALSE(vis.update(map, player));
+
+    // Desde la esquina inferior izquierda se sigue viendo la celda de antes
+    REQUIRE(vis.update(map, IVec2{ 1, 5 }));
+    REQUIRE(vis.isVisible(1, 5));
+    REQUIRE(vis.isVisible(player.x, player.y));
+
+    // Un cambio de navegación invalida el cálculo aunque el origen sea el mismo
+    map.markNavigationDirty();
+    REQUIRE(vis.update(map, IVec2{ 1, 5 }));
+
+    vis.invalidate();
+    REQUIRE(vis.update(map, IVec2{ 1, 5 }));
+}